@@ -0,0 +1,274 @@
+set(current_dir ${CMAKE_CURRENT_LIST_DIR})
+
+# Convert the common definitions XML file into static C++ tables, as declared
+# in adm/common_definitions_tables.hpp.
+#
+# This is not a general XML parser: it relies on the layout of
+# common_definitions.xml, with one tag per line.
+function(generate_common_definitions_tables)
+  # parse function arguments
+  set(options "")
+  set(oneValueArguments DEFINITIONS_FILE OUTPUT_FILE)
+  set(multiValueArguments "")
+  cmake_parse_arguments(GEN "${options}" "${oneValueArguments}"
+                        "${multiValueArguments}" ${ARGN})
+  foreach(arg ${oneValueArguments})
+    if(NOT GEN_${arg})
+      message(
+        FATAL_ERROR
+          "Argument ${arg} not defined in call to generate_common_definitions_tables"
+      )
+    endif()
+  endforeach()
+
+  set_property(
+    DIRECTORY
+    APPEND
+    PROPERTY CMAKE_CONFIGURE_DEPENDS ${GEN_DEFINITIONS_FILE}
+             "${current_dir}/common_definitions_tables.cpp.in")
+
+  file(STRINGS ${GEN_DEFINITIONS_FILE} lines)
+
+  # hex digits in IDs; these are converted to lower case before sorting, so
+  # that they sort by value
+  set(hex "[0-9a-fA-F]+")
+
+  # first pass: give each element an index, so that references can be
+  # resolved in the second pass. The keys of the *_sort lists sort in ID
+  # order, and are used to generate the ID indices.
+  foreach(type pack channel stream track)
+    set(${type}_count 0)
+    set(${type}_sort "")
+  endforeach()
+  foreach(line IN LISTS lines)
+    set(type "")
+    if(line MATCHES "<audioPackFormat audioPackFormatID=\"AP_(${hex})\"")
+      set(type pack)
+    elseif(line MATCHES
+           "<audioChannelFormat audioChannelFormatID=\"AC_(${hex})\"")
+      set(type channel)
+    elseif(line MATCHES "<audioStreamFormat audioStreamFormatID=\"AS_(${hex})\"")
+      set(type stream)
+    elseif(line MATCHES
+           "<audioTrackFormat audioTrackFormatID=\"AT_(${hex})_(${hex})\"")
+      set(type track)
+      set(CMAKE_MATCH_1 "${CMAKE_MATCH_1}${CMAKE_MATCH_2}")
+    endif()
+    if(type)
+      string(TOLOWER "${CMAKE_MATCH_1}" id)
+      set(${type}_index_${id} ${${type}_count})
+      list(APPEND ${type}_sort "${id}:${${type}_count}")
+      math(EXPR ${type}_count "${${type}_count} + 1")
+    endif()
+  endforeach()
+
+  # second pass: generate the table entries
+  set(references "")
+  set(reference_count 0)
+  set(element "")
+  foreach(type pack channel stream track)
+    set(${type}_entries "")
+  endforeach()
+
+  foreach(line IN LISTS lines)
+    if(line MATCHES "<audioPackFormat audioPackFormatID=\"AP_(....)(....)\"")
+      set(element pack)
+      _cdt_start_element()
+      _cdt_match_name(audioPackFormatName)
+      set(channel_refs "")
+      set(pack_refs "")
+    elseif(line MATCHES
+           "<audioChannelFormat audioChannelFormatID=\"AC_(....)(....)\"")
+      set(element channel)
+      _cdt_start_element()
+      _cdt_match_name(audioChannelFormatName)
+      set(block_count 0)
+      set(low_pass "false, 0.0f")
+      set(speaker_label nullptr)
+      set(azimuth 0.0f)
+      set(elevation 0.0f)
+      set(distance 0.0f)
+      set(screen_edge_lock nullptr)
+      set(order 0)
+      set(degree 0)
+      set(normalization nullptr)
+    elseif(line MATCHES
+           "<audioStreamFormat audioStreamFormatID=\"AS_(....)(....)\"")
+      set(element stream)
+      _cdt_start_element()
+      _cdt_match_name(audioStreamFormatName)
+      _cdt_match_format()
+      set(channel_ref "")
+      set(track_refs "")
+    elseif(line MATCHES
+           "<audioTrackFormat audioTrackFormatID=\"AT_(....)(....)_(..)\"")
+      set(element track)
+      _cdt_start_element()
+      set(counter "0x${CMAKE_MATCH_3}")
+      _cdt_match_name(audioTrackFormatName)
+      _cdt_match_format()
+      set(stream_ref "")
+    elseif(line MATCHES "<audioChannelFormatIDRef>AC_(${hex})<")
+      _cdt_reference_index(channel ${CMAKE_MATCH_1})
+      if(element STREQUAL "pack")
+        list(APPEND channel_refs ${index})
+      elseif(element STREQUAL "stream")
+        set(channel_ref ${index})
+      endif()
+    elseif(line MATCHES "<audioPackFormatIDRef>AP_(${hex})<")
+      _cdt_reference_index(pack ${CMAKE_MATCH_1})
+      if(element STREQUAL "pack")
+        list(APPEND pack_refs ${index})
+      else()
+        message(FATAL_ERROR "unsupported audioPackFormatIDRef: ${line}")
+      endif()
+    elseif(line MATCHES "<audioTrackFormatIDRef>AT_(${hex})_(${hex})<")
+      _cdt_reference_index(track "${CMAKE_MATCH_1}${CMAKE_MATCH_2}")
+      list(APPEND track_refs ${index})
+    elseif(line MATCHES "<audioStreamFormatIDRef>AS_(${hex})<")
+      _cdt_reference_index(stream ${CMAKE_MATCH_1})
+      set(stream_ref ${index})
+    elseif(line MATCHES "<audioBlockFormat[ />]")
+      math(EXPR block_count "${block_count} + 1")
+    elseif(line MATCHES "<frequency typeDefinition=\"lowPass\">([^<]*)<")
+      _cdt_float(value "${CMAKE_MATCH_1}")
+      set(low_pass "true, ${value}")
+    elseif(line MATCHES "<speakerLabel>([^<]*)<")
+      if(NOT speaker_label STREQUAL "nullptr")
+        message(FATAL_ERROR "multiple speaker labels in ${id}")
+      endif()
+      set(speaker_label "\"${CMAKE_MATCH_1}\"")
+    elseif(line MATCHES
+           "<position coordinate=\"(azimuth|elevation|distance)\"( screenEdgeLock=\"([a-z]+)\")?>([^<]*)<"
+    )
+      set(coordinate ${CMAKE_MATCH_1})
+      if(CMAKE_MATCH_3)
+        set(screen_edge_lock "\"${CMAKE_MATCH_3}\"")
+      endif()
+      _cdt_float(${coordinate} "${CMAKE_MATCH_4}")
+    elseif(line MATCHES "<position")
+      message(FATAL_ERROR "unsupported position: ${line}")
+    elseif(line MATCHES "<order>([^<]*)<")
+      set(order ${CMAKE_MATCH_1})
+    elseif(line MATCHES "<degree>([^<]*)<")
+      set(degree ${CMAKE_MATCH_1})
+    elseif(line MATCHES "<normalization>([^<]*)<")
+      set(normalization "\"${CMAKE_MATCH_1}\"")
+    elseif(line MATCHES "</audioPackFormat>")
+      _cdt_add_references(channel_range "${channel_refs}")
+      _cdt_add_references(pack_range "${pack_refs}")
+      string(APPEND pack_entries
+             "        {${type_id}, \"${name}\", ${channel_range}, ${pack_range}},\n")
+      set(element "")
+    elseif(line MATCHES "</audioChannelFormat>")
+      if(NOT block_count EQUAL 1)
+        message(FATAL_ERROR "expected one audioBlockFormat in ${id}")
+      endif()
+      string(
+        APPEND
+        channel_entries
+        "        {${type_id}, \"${name}\", ${low_pass}, ${speaker_label}, "
+        "${azimuth}, ${elevation}, ${distance}, ${screen_edge_lock}, "
+        "${order}, ${degree}, ${normalization}},\n")
+      set(element "")
+    elseif(line MATCHES "</audioStreamFormat>")
+      if(channel_ref STREQUAL "")
+        message(FATAL_ERROR "expected an audioChannelFormatIDRef in ${id}")
+      endif()
+      _cdt_add_references(track_range "${track_refs}")
+      string(
+        APPEND stream_entries
+        "        {${type_id}, ${format}, \"${name}\", ${channel_ref}, ${track_range}},\n")
+      set(element "")
+    elseif(line MATCHES "</audioTrackFormat>")
+      if(stream_ref STREQUAL "")
+        message(FATAL_ERROR "expected an audioStreamFormatIDRef in ${id}")
+      endif()
+      string(APPEND track_entries
+             "        {${type_id}, ${counter}, ${format}, \"${name}\", ${stream_ref}},\n")
+      set(element "")
+    endif()
+  endforeach()
+
+  # indices of the entries of each table, sorted by ID
+  foreach(type pack channel stream track)
+    list(SORT ${type}_sort)
+    set(sorted "")
+    foreach(key IN LISTS ${type}_sort)
+      string(REGEX REPLACE ".*:" "" index "${key}")
+      list(APPEND sorted ${index})
+    endforeach()
+    string(REPLACE ";" ", " ${type}_by_id "${sorted}")
+  endforeach()
+  string(REPLACE ";" ", " references "${references}")
+
+  set(PACK_FORMAT_ENTRIES "${pack_entries}")
+  set(CHANNEL_FORMAT_ENTRIES "${channel_entries}")
+  set(STREAM_FORMAT_ENTRIES "${stream_entries}")
+  set(TRACK_FORMAT_ENTRIES "${track_entries}")
+  set(REFERENCES "${references}")
+  set(PACK_FORMATS_BY_ID "${pack_by_id}")
+  set(CHANNEL_FORMATS_BY_ID "${channel_by_id}")
+  set(STREAM_FORMATS_BY_ID "${stream_by_id}")
+  set(TRACK_FORMATS_BY_ID "${track_by_id}")
+
+  configure_file("${current_dir}/common_definitions_tables.cpp.in"
+                 "${GEN_OUTPUT_FILE}" @ONLY)
+endfunction()
+
+# helpers for generate_common_definitions_tables(); these are macros so that
+# they operate on the variables of the caller
+
+# set id and type_id (initialisers for the typeDefinition and value of the ID)
+# from the ID matched on the current line
+macro(_cdt_start_element)
+  string(TOLOWER "${CMAKE_MATCH_1}${CMAKE_MATCH_2}" id)
+  set(type_id "0x${CMAKE_MATCH_1}, 0x${CMAKE_MATCH_2}")
+endmacro()
+
+macro(_cdt_match_name attribute)
+  if(line MATCHES "${attribute}=\"([^\"]*)\"")
+    set(name "${CMAKE_MATCH_1}")
+  else()
+    message(FATAL_ERROR "${attribute} missing in ${id}")
+  endif()
+endmacro()
+
+macro(_cdt_match_format)
+  if(line MATCHES "formatLabel=\"(${hex})\"")
+    set(format "0x${CMAKE_MATCH_1}")
+  else()
+    message(FATAL_ERROR "formatLabel missing in ${id}")
+  endif()
+endmacro()
+
+macro(_cdt_reference_index type ref_id)
+  string(TOLOWER "${ref_id}" _cdt_ref_id)
+  if(NOT DEFINED ${type}_index_${_cdt_ref_id})
+    message(FATAL_ERROR "unresolved reference to ${_cdt_ref_id} in ${id}")
+  endif()
+  set(index ${${type}_index_${_cdt_ref_id}})
+endmacro()
+
+# append indices to the shared references array, and set out_var to a
+# TableRange initialiser for them
+macro(_cdt_add_references out_var indices)
+  set(_cdt_indices "${indices}")
+  list(LENGTH _cdt_indices _cdt_count)
+  if(_cdt_count EQUAL 0)
+    set(${out_var} "{}")
+  else()
+    set(${out_var} "{references + ${reference_count}, ${_cdt_count}}")
+    list(APPEND references ${_cdt_indices})
+    math(EXPR reference_count "${reference_count} + ${_cdt_count}")
+  endif()
+endmacro()
+
+# format a decimal number from the XML as a float literal
+macro(_cdt_float out_var value)
+  if("${value}" MATCHES "[.eE]")
+    set(${out_var} "${value}f")
+  else()
+    set(${out_var} "${value}.0f")
+  endif()
+endmacro()
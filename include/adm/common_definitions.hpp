@@ -7,10 +7,16 @@
 
 namespace adm {
 
-  /// @brief Load embedded common definitions file and create Document
+  /**
+   * @brief Create a Document containing the common definitions
+   *
+   * The common definitions are built from the tables in
+   * common_definitions_tables.hpp once per process; each call returns a new
+   * copy of the result, which may be modified freely.
+   */
   ADM_EXPORT std::shared_ptr<Document> getCommonDefinitions();
 
-  /// @brief Add embedded common definitions file to a Document
+  /// @brief Add the common definitions to a Document
   ADM_EXPORT void addCommonDefinitionsTo(std::shared_ptr<Document> document);
 
   /**
@@ -0,0 +1,161 @@
+/// @file common_definitions_tables.hpp
+#pragma once
+#include <cstddef>
+#include <string>
+#include "adm/elements/audio_pack_format_id.hpp"
+#include "adm/elements/audio_channel_format_id.hpp"
+#include "adm/elements/audio_stream_format_id.hpp"
+#include "adm/elements/audio_track_format_id.hpp"
+#include "adm/export.h"
+
+namespace adm {
+  /**
+   * @brief Static tables describing the common definitions
+   *
+   * These tables are generated at build time from `common_definitions.xml`,
+   * and can be used to query the common definitions without parsing any XML
+   * or building a Document. Elements are listed in the same order as in the
+   * XML file, and references between them are given as indices into the
+   * table of the referenced element type.
+   */
+  namespace common_definitions {
+
+    /// @brief A read-only view of a contiguous sequence of table entries
+    template <typename T>
+    class TableRange {
+     public:
+      constexpr TableRange() : begin_(nullptr), size_(0) {}
+      constexpr TableRange(const T* begin, std::size_t size)
+          : begin_(begin), size_(size) {}
+      template <std::size_t N>
+      constexpr TableRange(const T (&array)[N]) : begin_(array), size_(N) {}
+
+      const T* begin() const { return begin_; }
+      const T* end() const { return begin_ + size_; }
+      std::size_t size() const { return size_; }
+      bool empty() const { return size_ == 0; }
+      const T& operator[](std::size_t i) const { return begin_[i]; }
+
+     private:
+      const T* begin_;
+      std::size_t size_;
+    };
+
+    /// @brief An audioPackFormat in the common definitions
+    struct PackFormatEntry {
+      int typeDefinition;
+      unsigned int idValue;
+      const char* name;
+      /// indices into channelFormats()
+      TableRange<std::size_t> channelFormats;
+      /// indices into packFormats()
+      TableRange<std::size_t> packFormats;
+    };
+
+    /**
+     * @brief An audioChannelFormat in the common definitions
+     *
+     * Each of these has exactly one audioBlockFormat, the parameters of which
+     * are included here. Which of these are used depends on the
+     * typeDefinition; unused strings are nullptr.
+     */
+    struct ChannelFormatEntry {
+      int typeDefinition;
+      unsigned int idValue;
+      const char* name;
+      bool hasLowPass;
+      float lowPass;
+      /// @name DirectSpeakers parameters
+      /// @{
+      const char* speakerLabel;
+      float azimuth;
+      float elevation;
+      float distance;
+      /// horizontal screenEdgeLock of the azimuth, or nullptr
+      const char* screenEdgeLock;
+      /// @}
+      /// @name HOA parameters
+      /// @{
+      int order;
+      int degree;
+      const char* normalization;
+      /// @}
+    };
+
+    /// @brief An audioStreamFormat in the common definitions
+    struct StreamFormatEntry {
+      /// @name audioStreamFormatID
+      /// @{
+      int typeDefinition;
+      unsigned int idValue;
+      /// @}
+      int formatDefinition;
+      const char* name;
+      /// index into channelFormats()
+      std::size_t channelFormat;
+      /// indices into trackFormats()
+      TableRange<std::size_t> trackFormats;
+    };
+
+    /// @brief An audioTrackFormat in the common definitions
+    struct TrackFormatEntry {
+      /// @name audioTrackFormatID
+      /// @{
+      int typeDefinition;
+      unsigned int idValue;
+      unsigned int idCounter;
+      /// @}
+      int formatDefinition;
+      const char* name;
+      /// index into streamFormats()
+      std::size_t streamFormat;
+    };
+
+    /**
+     * @brief A loudspeaker layout or HOA format with a pack in the common
+     * definitions
+     *
+     * These are the layouts listed in audioPackFormatLookupTable().
+     */
+    struct SpeakerLayoutEntry {
+      /// layout name, e.g. "0+5+0" or "SN3D-Order1-3D"
+      const char* name;
+      /// @name audioPackFormatID of the layout
+      /// @{
+      int typeDefinition;
+      unsigned int idValue;
+      /// @}
+    };
+
+    /// @name Tables
+    /// @{
+    ADM_EXPORT TableRange<PackFormatEntry> packFormats();
+    ADM_EXPORT TableRange<ChannelFormatEntry> channelFormats();
+    ADM_EXPORT TableRange<StreamFormatEntry> streamFormats();
+    ADM_EXPORT TableRange<TrackFormatEntry> trackFormats();
+    ADM_EXPORT TableRange<SpeakerLayoutEntry> speakerLayouts();
+    /// @}
+
+    /// @name Lookup
+    /// Find the entry with a given ID or layout name, or return nullptr if
+    /// it is not in the common definitions (which is the case for the higher
+    /// order FuMa layouts). IDs are found with a binary search.
+    /// @{
+    ADM_EXPORT const PackFormatEntry* lookup(const AudioPackFormatId& id);
+    ADM_EXPORT const ChannelFormatEntry* lookup(const AudioChannelFormatId& id);
+    ADM_EXPORT const StreamFormatEntry* lookup(const AudioStreamFormatId& id);
+    ADM_EXPORT const TrackFormatEntry* lookup(const AudioTrackFormatId& id);
+    ADM_EXPORT const PackFormatEntry* lookupSpeakerLayout(
+        const std::string& name);
+    /// @}
+
+    /// @name IDs
+    /// @{
+    ADM_EXPORT AudioPackFormatId getId(const PackFormatEntry& entry);
+    ADM_EXPORT AudioChannelFormatId getId(const ChannelFormatEntry& entry);
+    ADM_EXPORT AudioStreamFormatId getId(const StreamFormatEntry& entry);
+    ADM_EXPORT AudioTrackFormatId getId(const TrackFormatEntry& entry);
+    /// @}
+
+  }  // namespace common_definitions
+}  // namespace adm
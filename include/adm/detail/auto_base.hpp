@@ -209,7 +209,9 @@ namespace adm {
       static constexpr bool has_isDefault_unset = true;
 
       ADM_BASE_EXPORT T get(Tag) const {
-        return boost::get_optional_value_or(value_, getDefault<T>());
+        // only make the default if it is needed
+        if (value_) return *value_;
+        return getDefault<T>();
       }
       ADM_BASE_EXPORT void set(T value) { value_ = std::move(value); }
       ADM_BASE_EXPORT bool has(Tag) const { return true; }
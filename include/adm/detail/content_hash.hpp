@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace adm {
+  namespace detail {
+
+    /**
+     * @brief Cached content hash of an element
+     *
+     * Elements call invalidate() whenever one of their parameters changes,
+     * and get() recomputes the hash the next time it is needed. Copies keep
+     * the cached value, as they have the same parameters.
+     *
+     * The value is atomic so that const elements can be hashed from several
+     * threads; a hash which happens to be 0 is not cached.
+     */
+    class ContentHashCache {
+     public:
+      ContentHashCache() = default;
+      ContentHashCache(const ContentHashCache& other)
+          : value_(other.value_.load(std::memory_order_relaxed)) {}
+      ContentHashCache& operator=(const ContentHashCache& other) {
+        value_.store(other.value_.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+        return *this;
+      }
+
+      /// the cached hash, or the result of compute() if there is none
+      template <typename Compute>
+      std::uint64_t get(Compute compute) const {
+        std::uint64_t value = value_.load(std::memory_order_relaxed);
+        if (value == 0) {
+          value = compute();
+          value_.store(value, std::memory_order_relaxed);
+        }
+        return value;
+      }
+
+      void invalidate() { value_.store(0, std::memory_order_relaxed); }
+
+     private:
+      mutable std::atomic<std::uint64_t> value_{0};
+    };
+
+  }  // namespace detail
+}  // namespace adm
@@ -0,0 +1,56 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+namespace adm {
+  namespace detail {
+
+    /// a std::vector whose storage can be shared between copies, and which
+    /// makes a private copy of it before it is modified (copy-on-write)
+    ///
+    /// Copying a CowVector is O(1); the elements are only copied when one
+    /// of the sharing copies is accessed through mut(). References and
+    /// iterators obtained from mut() are therefore only valid until the
+    /// CowVector is next copied.
+    template <typename T>
+    class CowVector {
+     public:
+      const std::vector<T>& get() const { return data_ ? *data_ : empty(); }
+
+      /// access for modification, first making a private copy of the
+      /// storage if it is shared
+      std::vector<T>& mut() {
+        if (!data_)
+          data_ = std::make_shared<std::vector<T>>();
+        else if (data_.use_count() > 1)
+          data_ = std::make_shared<std::vector<T>>(*data_);
+        return *data_;
+      }
+
+      /// make a private copy of the storage if it is shared
+      void unshare() {
+        if (data_ && data_.use_count() > 1)
+          data_ = std::make_shared<std::vector<T>>(*data_);
+      }
+
+      /// is the storage shared with another CowVector?
+      bool isShared() const { return data_ && data_.use_count() > 1; }
+
+      void clear() {
+        if (isShared())
+          data_.reset();
+        else if (data_)
+          data_->clear();
+      }
+
+     private:
+      static const std::vector<T>& empty() {
+        static const std::vector<T> emptyVector;
+        return emptyVector;
+      }
+
+      std::shared_ptr<std::vector<T>> data_;
+    };
+
+  }  // namespace detail
+}  // namespace adm
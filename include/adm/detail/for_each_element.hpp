@@ -0,0 +1,66 @@
+#pragma once
+#include "adm/elements.hpp"
+
+namespace adm {
+  namespace detail {
+
+    /// store a value for each top-level element type, with access by type
+    ///
+    /// the value is given by the template T, so that get<AudioProgramme>()
+    /// returns a T<AudioProgramme>, for example
+    template <template <typename Element> class T>
+    struct ForEachElement {
+      /// get one of the stored values
+      template <typename El>
+      T<El> &get() {
+        return getTag(typename El::tag{});
+      }
+
+      /// get one of the stored values
+      template <typename El>
+      const T<El> &get() const {
+        return const_cast<ForEachElement *>(this)->getTag(
+            typename El::tag{});
+      }
+
+      /// call f on each of the stored values
+      template <typename F>
+      void visit(F f) {
+        f(programmes);
+        f(contents);
+        f(objects);
+        f(packFormats);
+        f(channelFormats);
+        f(streamFormats);
+        f(trackFormats);
+        f(trackUids);
+      }
+
+     private:
+      T<AudioProgramme> &getTag(AudioProgramme::tag) { return programmes; }
+      T<AudioContent> &getTag(AudioContent::tag) { return contents; }
+      T<AudioObject> &getTag(AudioObject::tag) { return objects; }
+      T<AudioPackFormat> &getTag(AudioPackFormat::tag) { return packFormats; }
+      T<AudioChannelFormat> &getTag(AudioChannelFormat::tag) {
+        return channelFormats;
+      }
+      T<AudioStreamFormat> &getTag(AudioStreamFormat::tag) {
+        return streamFormats;
+      }
+      T<AudioTrackFormat> &getTag(AudioTrackFormat::tag) {
+        return trackFormats;
+      }
+      T<AudioTrackUid> &getTag(AudioTrackUid::tag) { return trackUids; }
+
+      T<AudioProgramme> programmes;
+      T<AudioContent> contents;
+      T<AudioObject> objects;
+      T<AudioPackFormat> packFormats;
+      T<AudioChannelFormat> channelFormats;
+      T<AudioStreamFormat> streamFormats;
+      T<AudioTrackFormat> trackFormats;
+      T<AudioTrackUid> trackUids;
+    };
+
+  }  // namespace detail
+}  // namespace adm
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "adm/elements/audio_programme_id.hpp"
+#include "adm/elements/audio_content_id.hpp"
+#include "adm/elements/audio_object_id.hpp"
+#include "adm/elements/audio_pack_format_id.hpp"
+#include "adm/elements/audio_channel_format_id.hpp"
+#include "adm/elements/audio_block_format_id.hpp"
+#include "adm/elements/audio_stream_format_id.hpp"
+#include "adm/elements/audio_track_format_id.hpp"
+#include "adm/elements/audio_track_uid_id.hpp"
+
+namespace adm {
+  namespace detail {
+
+    /// mix the hash of value into seed, as in boost::hash_combine
+    template <typename T>
+    void hashCombine(std::size_t& seed, const T& value) {
+      seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    /// hash function object for all ADM element ID types
+    ///
+    /// IDs are hashed on the same values that operator== compares, so this
+    /// can be used as the Hash parameter of std::unordered_map etc.
+    struct IdHash {
+      std::size_t operator()(const AudioProgrammeId& id) const {
+        return hashValues(id.get<AudioProgrammeIdValue>().get());
+      }
+      std::size_t operator()(const AudioContentId& id) const {
+        return hashValues(id.get<AudioContentIdValue>().get());
+      }
+      std::size_t operator()(const AudioObjectId& id) const {
+        return hashValues(id.get<AudioObjectIdValue>().get());
+      }
+      std::size_t operator()(const AudioPackFormatId& id) const {
+        return hashValues(id.get<TypeDescriptor>().get(),
+                          id.get<AudioPackFormatIdValue>().get());
+      }
+      std::size_t operator()(const AudioChannelFormatId& id) const {
+        return hashValues(id.get<TypeDescriptor>().get(),
+                          id.get<AudioChannelFormatIdValue>().get());
+      }
+      std::size_t operator()(const AudioBlockFormatId& id) const {
+        return hashValues(id.get<TypeDescriptor>().get(),
+                          id.get<AudioBlockFormatIdValue>().get(),
+                          id.get<AudioBlockFormatIdCounter>().get());
+      }
+      std::size_t operator()(const AudioStreamFormatId& id) const {
+        return hashValues(id.get<TypeDescriptor>().get(),
+                          id.get<AudioStreamFormatIdValue>().get());
+      }
+      std::size_t operator()(const AudioTrackFormatId& id) const {
+        return hashValues(id.get<TypeDescriptor>().get(),
+                          id.get<AudioTrackFormatIdValue>().get(),
+                          id.get<AudioTrackFormatIdCounter>().get());
+      }
+      std::size_t operator()(const AudioTrackUidId& id) const {
+        return hashValues(id.get<AudioTrackUidIdValue>().get());
+      }
+
+     private:
+      template <typename... Values>
+      static std::size_t hashValues(const Values&... values) {
+        std::size_t seed = 0;
+        // expand the pack in order; the array is only there for the expansion
+        int unused[] = {0, (hashCombine(seed, values), 0)...};
+        (void)unused;
+        return seed;
+      }
+    };
+
+  }  // namespace detail
+}  // namespace adm
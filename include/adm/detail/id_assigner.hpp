@@ -12,12 +12,12 @@ namespace adm {
     /**
      * @brief Assigns a unique ID to elements.
      *
-     * Uses lookups to find the next available element ID. 
-     * 
+     * Uses the index of used ID counters kept by the Document to find the
+     * next available element ID in O(log N).
+     *
      * @note This class differs from IdReassigner in that it can
      * operate on a Document which already has elements with ID's
-     * which you wish to maintain. However, the trade-off is that
-     * it is less efficient.
+     * which you wish to maintain.
      */
     class IdAssigner {
      public:
@@ -35,6 +35,12 @@ namespace adm {
       const Document& document() const;
 
      private:
+      /// the first counter not less than preferred which is free within
+      /// the group of id (see IdCounterIndex)
+      template <typename Element, typename Counter>
+      Counter nextCounter(const typename Element::id_type& id,
+                          Counter preferred) const;
+
       friend class adm::Document;
       ADM_EXPORT void document(Document* document_);
       Document* document_;
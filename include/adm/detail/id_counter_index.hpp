@@ -0,0 +1,188 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <unordered_map>
+#include "adm/elements/audio_programme_id.hpp"
+#include "adm/elements/audio_content_id.hpp"
+#include "adm/elements/audio_object_id.hpp"
+#include "adm/elements/audio_pack_format_id.hpp"
+#include "adm/elements/audio_channel_format_id.hpp"
+#include "adm/elements/audio_stream_format_id.hpp"
+#include "adm/elements/audio_track_format_id.hpp"
+#include "adm/elements/audio_track_uid_id.hpp"
+
+namespace adm {
+  namespace detail {
+
+    /// @name ID counter groups
+    ///
+    /// IdAssigner allocates one part of each ID (the counter); the other
+    /// parts are fixed by the element, and select a group of IDs within
+    /// which the counter must be unique.
+    /// @{
+    inline std::uint64_t idCounterGroup(const AudioProgrammeId &) {
+      return 0;
+    }
+    inline unsigned idCounter(const AudioProgrammeId &id) {
+      return id.get<AudioProgrammeIdValue>().get();
+    }
+
+    inline std::uint64_t idCounterGroup(const AudioContentId &) { return 0; }
+    inline unsigned idCounter(const AudioContentId &id) {
+      return id.get<AudioContentIdValue>().get();
+    }
+
+    inline std::uint64_t idCounterGroup(const AudioObjectId &) { return 0; }
+    inline unsigned idCounter(const AudioObjectId &id) {
+      return id.get<AudioObjectIdValue>().get();
+    }
+
+    inline std::uint64_t idCounterGroup(const AudioPackFormatId &id) {
+      return static_cast<std::uint64_t>(id.get<TypeDescriptor>().get());
+    }
+    inline unsigned idCounter(const AudioPackFormatId &id) {
+      return id.get<AudioPackFormatIdValue>().get();
+    }
+
+    inline std::uint64_t idCounterGroup(const AudioChannelFormatId &id) {
+      return static_cast<std::uint64_t>(id.get<TypeDescriptor>().get());
+    }
+    inline unsigned idCounter(const AudioChannelFormatId &id) {
+      return id.get<AudioChannelFormatIdValue>().get();
+    }
+
+    inline std::uint64_t idCounterGroup(const AudioStreamFormatId &id) {
+      return static_cast<std::uint64_t>(id.get<TypeDescriptor>().get());
+    }
+    inline unsigned idCounter(const AudioStreamFormatId &id) {
+      return id.get<AudioStreamFormatIdValue>().get();
+    }
+
+    inline std::uint64_t idCounterGroup(const AudioTrackFormatId &id) {
+      return static_cast<std::uint64_t>(id.get<TypeDescriptor>().get())
+                 << 32 |
+             id.get<AudioTrackFormatIdValue>().get();
+    }
+    inline unsigned idCounter(const AudioTrackFormatId &id) {
+      return id.get<AudioTrackFormatIdCounter>().get();
+    }
+
+    inline std::uint64_t idCounterGroup(const AudioTrackUidId &) { return 0; }
+    inline unsigned idCounter(const AudioTrackUidId &id) {
+      return id.get<AudioTrackUidIdValue>().get();
+    }
+    /// @}
+
+    /// index of the ID counters used by the elements of one type within a
+    /// Document
+    ///
+    /// For each group (see idCounterGroup), the used counters are stored as
+    /// a set of disjoint, non-adjacent intervals, so the first free counter
+    /// at or after a given value can be found in O(log N), and adding or
+    /// removing an ID is O(log N). Counters which are used more than once
+    /// are counted separately, so that removing one of them does not free
+    /// the counter.
+    template <typename Element>
+    class IdCounterIndex {
+      using Id = typename Element::id_type;
+
+     public:
+      void add(const Id &id) {
+        auto &group = groups_[idCounterGroup(id)];
+        unsigned counter = idCounter(id);
+        if (contains(group.intervals, counter))
+          group.duplicates[counter]++;
+        else
+          insert(group.intervals, counter);
+      }
+
+      void remove(const Id &id) {
+        auto groupIt = groups_.find(idCounterGroup(id));
+        if (groupIt == groups_.end()) return;
+        auto &group = groupIt->second;
+        unsigned counter = idCounter(id);
+
+        auto duplicate = group.duplicates.find(counter);
+        if (duplicate != group.duplicates.end()) {
+          if (--duplicate->second == 0) group.duplicates.erase(duplicate);
+        } else {
+          erase(group.intervals, counter);
+        }
+      }
+
+      /// the first counter which is not used by an ID in the same group as
+      /// id, and is not less than preferred
+      unsigned nextFree(const Id &id, unsigned preferred) const {
+        auto groupIt = groups_.find(idCounterGroup(id));
+        if (groupIt == groups_.end()) return preferred;
+        auto &intervals = groupIt->second.intervals;
+
+        auto it = intervals.upper_bound(preferred);
+        if (it == intervals.begin()) return preferred;
+        --it;
+        // intervals are never adjacent, so the end of the one containing
+        // preferred is free
+        return it->second > preferred ? it->second : preferred;
+      }
+
+     private:
+      /// map from the first counter in each interval to one past the last
+      using Intervals = std::map<unsigned, unsigned>;
+
+      struct Group {
+        Intervals intervals;
+        /// number of extra uses of counters which are used more than once
+        std::unordered_map<unsigned, unsigned> duplicates;
+      };
+
+      static bool contains(const Intervals &intervals, unsigned counter) {
+        auto it = intervals.upper_bound(counter);
+        if (it == intervals.begin()) return false;
+        return std::prev(it)->second > counter;
+      }
+
+      static void insert(Intervals &intervals, unsigned counter) {
+        auto next = intervals.upper_bound(counter);
+        bool joinNext = next != intervals.end() && next->first == counter + 1;
+        if (next != intervals.begin()) {
+          auto prev = std::prev(next);
+          if (prev->second == counter) {
+            if (joinNext) {
+              prev->second = next->second;
+              intervals.erase(next);
+            } else {
+              prev->second = counter + 1;
+            }
+            return;
+          }
+        }
+        if (joinNext) {
+          unsigned end = next->second;
+          intervals.erase(next);
+          intervals.emplace(counter, end);
+        } else {
+          intervals.emplace(counter, counter + 1);
+        }
+      }
+
+      static void erase(Intervals &intervals, unsigned counter) {
+        auto it = intervals.upper_bound(counter);
+        if (it == intervals.begin()) return;
+        --it;
+        unsigned start = it->first;
+        unsigned end = it->second;
+        if (end <= counter) return;
+
+        if (start == counter)
+          intervals.erase(it);
+        else
+          it->second = counter;
+        if (counter + 1 != end) intervals.emplace(counter + 1, end);
+      }
+
+      std::unordered_map<std::uint64_t, Group> groups_;
+    };
+
+  }  // namespace detail
+}  // namespace adm
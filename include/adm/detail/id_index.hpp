@@ -0,0 +1,116 @@
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "adm/detail/hash.hpp"
+#include "adm/detail/id_counter_index.hpp"
+
+namespace adm {
+  namespace detail {
+
+    /// hash index from IDs to the elements of one type within a Document
+    ///
+    /// This mirrors the element vector in the Document, and must be kept in
+    /// sync with it whenever elements are added or removed, or their IDs
+    /// change. If multiple elements share an ID (which is only possible for
+    /// undefined IDs), the first one added is found, matching a linear search
+    /// through the element vector.
+    ///
+    /// The counters used by the IDs are also indexed, so that IdAssigner can
+    /// find free IDs without scanning all elements.
+    template <typename Element>
+    class IdIndex {
+      using Id = typename Element::id_type;
+      using ElementVector = std::vector<std::shared_ptr<Element>>;
+
+     public:
+      void reserve(std::size_t size) { index_.reserve(size); }
+
+      /// add an element which has been appended to the element vector
+      void add(const std::shared_ptr<Element> &element) {
+        counters_.add(element->template get<Id>());
+        if (!index_.emplace(element->template get<Id>(), element).second)
+          hasDuplicates_ = true;
+      }
+
+      /// remove an element which has already been removed from elements
+      void remove(const std::shared_ptr<Element> &element,
+                  const ElementVector &elements) {
+        counters_.remove(element->template get<Id>());
+        erase(element->template get<Id>(), element.get(), elements);
+      }
+
+      /// update the index after the ID of element changed from oldId
+      void rename(const Id &oldId, const Element *element,
+                  const ElementVector &elements) {
+        auto it = index_.find(oldId);
+        std::shared_ptr<Element> ptr;
+        if (it != index_.end() && it->second.get() == element) {
+          ptr = it->second;
+        } else {
+          ptr = findInVector(element, elements);
+          if (!ptr) return;
+        }
+        erase(oldId, element, elements);
+        counters_.remove(oldId);
+        counters_.add(element->template get<Id>());
+
+        auto inserted = index_.emplace(element->template get<Id>(), ptr);
+        if (!inserted.second) {
+          hasDuplicates_ = true;
+          inserted.first->second =
+              findFirst(element->template get<Id>(), elements);
+        }
+      }
+
+      /// find the element with a given ID, or nullptr
+      std::shared_ptr<Element> lookup(const Id &id) const {
+        auto it = index_.find(id);
+        if (it != index_.end())
+          return it->second;
+        else
+          return nullptr;
+      }
+
+      /// the counters used by the indexed IDs
+      const IdCounterIndex<Element> &counters() const { return counters_; }
+
+     private:
+      void erase(const Id &id, const Element *element,
+                 const ElementVector &elements) {
+        auto it = index_.find(id);
+        if (it == index_.end() || it->second.get() != element) return;
+        index_.erase(it);
+
+        // another element may have had the same ID; find the first remaining
+        // one so that lookups still match a linear search
+        if (hasDuplicates_) {
+          if (auto other = findFirst(id, elements)) index_.emplace(id, other);
+        }
+      }
+
+      static std::shared_ptr<Element> findFirst(const Id &id,
+                                                const ElementVector &elements) {
+        for (auto &other : elements)
+          if (other->template get<Id>() == id) return other;
+        return nullptr;
+      }
+
+      static std::shared_ptr<Element> findInVector(
+          const Element *element, const ElementVector &elements) {
+        auto it = std::find_if(
+            elements.begin(), elements.end(),
+            [element](const std::shared_ptr<Element> &other) {
+              return other.get() == element;
+            });
+        return it != elements.end() ? *it : nullptr;
+      }
+
+      std::unordered_map<Id, std::shared_ptr<Element>, IdHash> index_;
+      IdCounterIndex<Element> counters_;
+      bool hasDuplicates_ = false;
+    };
+
+  }  // namespace detail
+}  // namespace adm
@@ -5,9 +5,14 @@
 #include <string>
 #include <vector>
 #include "adm/elements.hpp"
+#include "adm/element_variant.hpp"
 #include "adm/detail/auto_base.hpp"
+#include "adm/detail/enum_bitmask.hpp"
+#include "adm/detail/for_each_element.hpp"
 #include "adm/detail/id_assigner.hpp"
+#include "adm/detail/id_index.hpp"
 #include "adm/detail/named_type.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/export.h"
 
 namespace adm {
@@ -24,6 +29,19 @@ namespace adm {
     using DocumentBase = HasParameters<OptionalParameter<Version>>;
   }  // namespace detail
 
+  /**
+   * @brief Representation of available options to influence the behaviour
+   * of Document::deepCopy() and deepCopyTo().
+   *
+   * `CopyOptions` satisfies the requirements of
+   * [BitmaskType](http://en.cppreference.com/w/cpp/concept/BitmaskType).
+   */
+  enum class CopyOptions : unsigned {
+    none = 0x0,  ///< default behaviour
+    share_block_formats =
+        0x1  ///< share the audioBlockFormats of each audioChannelFormat with the original until either is modified (see AudioChannelFormat::copySharingBlockFormats()), so that copying takes time proportional to the number of elements rather than the number of blocks
+  };
+
   /**
    * @brief Class representation of a whole ADM document
    *
@@ -53,10 +71,37 @@ namespace adm {
      */
     ADM_EXPORT static std::shared_ptr<Document> create();
 
+    /**
+     * @brief Create a Document whose elements are allocated from an arena
+     *
+     * The arena is used for elements created by the parser and by
+     * deepCopy(), and for elements created while an ArenaScope for it is
+     * active, for example:
+     *
+     * @code
+       auto document = Document::create(MemoryArena::create());
+       {
+         ArenaScope scope(document->getArena());
+         document->add(AudioObject::create(AudioObjectName("object")));
+       }
+       @endcode
+     *
+     * See MemoryArena for details.
+     */
+    ADM_EXPORT static std::shared_ptr<Document> create(
+        std::shared_ptr<MemoryArena> arena);
+
+    /// get the arena that elements of this document are allocated from, or
+    /// nullptr if elements are allocated individually
+    ADM_EXPORT std::shared_ptr<MemoryArena> getArena() const;
+
     /**
      * @brief Create a copy of the Document including all elements
+     *
+     * If this document has an arena, the copy gets a new arena of its own.
      */
-    ADM_EXPORT std::shared_ptr<Document> deepCopy() const;
+    ADM_EXPORT std::shared_ptr<Document> deepCopy(
+        CopyOptions options = CopyOptions::none) const;
 
     /** @name Add ADM elements
      *
@@ -82,6 +127,24 @@ namespace adm {
     ADM_EXPORT bool add(std::shared_ptr<AudioTrackUid> trackUid);
     ///@}
 
+    /**
+     * @brief Add a batch of ADM elements
+     *
+     * This has the same result as calling add() for each element in turn,
+     * including the assigned IDs and the order of the elements, but is
+     * faster when adding many elements: all elements and the elements they
+     * reference are found and checked first, then capacity is reserved and
+     * IDs are assigned in a single pass.
+     *
+     * If any of the elements (or the elements they reference) already
+     * belong to another Document, a std::runtime_error is thrown before
+     * anything is added.
+     *
+     * @returns the number of elements which were added, including
+     *   referenced elements
+     */
+    ADM_EXPORT std::size_t add(const std::vector<ElementVariant> &elements);
+
     /** @name Remove ADM elements
      *
      * References from and to the ADM element will automatically be removed
@@ -130,6 +193,8 @@ namespace adm {
      *
      * Lookup the first ADM element with the given Id.
      *
+     * Lookups use a hash index maintained by the Document, so take constant
+     * time regardless of the number of elements.
      */
     ///@{
     /**
@@ -285,12 +350,37 @@ namespace adm {
     template <typename Element>
     bool checkParent(const std::shared_ptr<Element> &element, const char *type);
 
+    /// update the ID index after an element ID changed; called by elements
+    /// through DocumentAttorney
+    template <typename Element>
+    void idChanged(const Element &element,
+                   const typename Element::id_type &oldId);
+
+    /// stop updating the ID index when element IDs change, so that the IDs
+    /// of many elements can be changed at once, even if the new IDs are
+    /// temporarily used by two elements; used by IdReassigner
+    void beginIdChanges();
+    /// rebuild the ID index after beginIdChanges()
+    void endIdChanges();
+
+    /// add elements of one type which are not yet in any document, in
+    /// order, without adding their references
+    template <typename Element>
+    void addBatch(const std::vector<std::shared_ptr<Element>> &elements);
+
+    /// get the element vector for a given element type
+    template <typename Element>
+    std::vector<std::shared_ptr<Element>> &elementVector();
+
     using detail::DocumentBase::get;
     using detail::DocumentBase::has;
     using detail::DocumentBase::isDefault;
     using detail::DocumentBase::unset;
 
     friend class detail::AddWrapperMethods<Document>;
+    friend class DocumentAttorney;
+    friend class detail::IdAssigner;
+    friend class IdReassigner;
 
     std::vector<std::shared_ptr<AudioProgramme>> audioProgrammes_;
     std::vector<std::shared_ptr<AudioContent>> audioContents_;
@@ -301,6 +391,9 @@ namespace adm {
     std::vector<std::shared_ptr<AudioTrackFormat>> audioTrackFormats_;
     std::vector<std::shared_ptr<AudioTrackUid>> audioTrackUids_;
     detail::IdAssigner idAssigner_;
+    detail::ForEachElement<detail::IdIndex> idIndex_;
+    bool idChangesInProgress_ = false;
+    std::shared_ptr<MemoryArena> arena_;
   };
 
   // ---- Implementation ---- //
@@ -318,3 +411,5 @@ namespace adm {
   }
 
 }  // namespace adm
+
+ENABLE_ENUM_BITMASK_OPERATORS(adm::CopyOptions);
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <cstdint>
 #include "adm/elements/time.hpp"
 #include "adm/elements/audio_block_format_id.hpp"
 #include "adm/elements/common_parameters.hpp"
@@ -48,6 +49,15 @@ namespace adm {
         const AudioBlockFormatMatrix&) = default;
     ADM_EXPORT AudioBlockFormatMatrix& operator=(AudioBlockFormatMatrix&&) =
         default;
+    /**
+     * @brief Hash of the content of this audioBlockFormat
+     *
+     * A stable 64-bit hash of all parameters except the AudioBlockFormatId,
+     * so blocks with the same parameters have the same hash wherever they
+     * are. This is not cached.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
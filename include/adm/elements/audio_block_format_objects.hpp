@@ -2,6 +2,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <cstdint>
 #include "adm/elements/channel_lock.hpp"
 #include "adm/elements/jump_position.hpp"
 #include "adm/elements/object_divergence.hpp"
@@ -148,6 +149,15 @@ namespace adm {
     ADM_EXPORT AudioBlockFormatObjects& operator=(AudioBlockFormatObjects&&) =
         default;
 
+    /**
+     * @brief Hash of the content of this audioBlockFormat
+     *
+     * A stable 64-bit hash of all parameters except the AudioBlockFormatId,
+     * so blocks with the same parameters have the same hash wherever they
+     * are. This is not cached.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
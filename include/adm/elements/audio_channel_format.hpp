@@ -13,11 +13,15 @@
 #include "adm/elements/audio_block_format_objects.hpp"
 #include "adm/elements/audio_channel_format_id.hpp"
 #include "adm/elements/frequency.hpp"
+#include "adm/elements/objects_evaluation.hpp"
 #include "adm/elements_fwd.hpp"
 #include "adm/helper/element_range.hpp"
 #include "adm/detail/named_option_helper.hpp"
+#include "adm/detail/content_hash.hpp"
+#include "adm/detail/cow_vector.hpp"
 #include "adm/detail/named_type.hpp"
 #include "adm/detail/type_traits.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/export.h"
 #include <type_traits>
 
@@ -102,6 +106,34 @@ namespace adm {
      */
     ADM_EXPORT std::shared_ptr<AudioChannelFormat> copy() const;
 
+    /**
+     * @brief Copy AudioChannelFormat, sharing the AudioBlockFormats
+     *
+     * The same as copy(), except that the AudioBlockFormats are not copied
+     * straight away; they are shared between this AudioChannelFormat and
+     * the copy until either is modified through a non-const method (add(),
+     * clearAudioBlockFormats(), or the non-const getElements()), which
+     * first makes a private copy of them. This makes copying O(1) in the
+     * number of blocks, and is used by Document::deepCopy() with
+     * CopyOptions::share_block_formats.
+     *
+     * Ranges returned by the non-const getElements() before the copy must
+     * not be used to modify blocks after it.
+     */
+    ADM_EXPORT std::shared_ptr<AudioChannelFormat> copySharingBlockFormats()
+        const;
+
+    /**
+     * @brief Hash of the content of this AudioChannelFormat
+     *
+     * A stable 64-bit hash of the parameters of this element. The
+     * AudioChannelFormatId itself is not included, so copies and elements with
+     * the same content in other documents have the same hash. audioBlockFormats
+     * are not included; they have their own contentHash(). The part of the hash
+     * covering the parameters is cached until one of them is changed.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
@@ -183,6 +215,63 @@ namespace adm {
     template <typename AudioBlockFormat>
     BlockFormatsRange<AudioBlockFormat> getElements();
 
+    /**
+     * @brief AudioBlockFormats which overlap a time window
+     *
+     * Returns the audioBlockFormats of the given type whose time range
+     * `[rtime, rtime + duration)` overlaps `[start, end)`. Blocks without a
+     * duration continue forever, and blocks with a duration of zero are
+     * included if their rtime is within the window.
+     *
+     * The blocks are found by binary search, so they must be sorted by
+     * rtime (as with CompareRtimeLess) and must not overlap, which is the
+     * case for audioBlockFormats in valid ADM.
+     */
+    template <typename AudioBlockFormat>
+    BlockFormatsConstRange<AudioBlockFormat> getElementsInWindow(
+        const Time &start, const Time &end) const;
+
+    /**
+     * @brief Interpolate AudioBlockFormatObjects parameters at many times
+     *
+     * Evaluates the position, gain, width, height, depth and diffuse of the
+     * audioBlockFormats at each of `count` times, writing them to the
+     * non-null arrays in `out`.
+     *
+     * Within each block, parameters move linearly from the values of the
+     * previous block to those of this block over the interpolation length,
+     * and hold after that. The interpolation length is the block duration,
+     * or if jumpPosition is set, its interpolationLength (0 by default).
+     * Before the first block, and in gaps between blocks, the values of the
+     * nearest earlier block (or the first block) are held. Positions jump
+     * rather than being interpolated between Cartesian and spherical blocks.
+     *
+     * The blocks must be sorted by rtime and not overlap, and the times
+     * must be sorted. The work done for each block is shared between all
+     * times within it, and the per-time work is simple loops over arrays
+     * which the compiler can vectorise.
+     *
+     * @param times times to evaluate, relative to the start of the channel
+     * @param count number of times
+     * @param out destination arrays
+     * @param cursor position in the blocks, kept between calls with
+     * increasing times to avoid searching for the first block each time
+     *
+     * @throws adm::error::AdmGenericRuntimeError if there are no
+     * AudioBlockFormatObjects
+     */
+    ADM_EXPORT void evaluateObjects(const std::chrono::nanoseconds *times,
+                                    std::size_t count,
+                                    const ObjectsParameterBuffers &out,
+                                    BlockCursor &cursor) const;
+    /// @copybrief evaluateObjects
+    ///
+    /// The same as the overload with a cursor, starting from the first
+    /// block.
+    ADM_EXPORT void evaluateObjects(const std::chrono::nanoseconds *times,
+                                    std::size_t count,
+                                    const ObjectsParameterBuffers &out) const;
+
     /**
      * @brief Clear AudioBlockFormats
      *
@@ -291,12 +380,14 @@ namespace adm {
     AudioChannelFormatId id_;
     boost::optional<Frequency> frequency_;
 
-    std::vector<AudioBlockFormatDirectSpeakers>
+    // shared between copies made with copySharingBlockFormats()
+    detail::CowVector<AudioBlockFormatDirectSpeakers>
         audioBlockFormatsDirectSpeakers_;
-    std::vector<AudioBlockFormatMatrix> audioBlockFormatsMatrix_;
-    std::vector<AudioBlockFormatObjects> audioBlockFormatsObjects_;
-    std::vector<AudioBlockFormatHoa> audioBlockFormatsHoa_;
-    std::vector<AudioBlockFormatBinaural> audioBlockFormatsBinaural_;
+    detail::CowVector<AudioBlockFormatMatrix> audioBlockFormatsMatrix_;
+    detail::CowVector<AudioBlockFormatObjects> audioBlockFormatsObjects_;
+    detail::CowVector<AudioBlockFormatHoa> audioBlockFormatsHoa_;
+    detail::CowVector<AudioBlockFormatBinaural> audioBlockFormatsBinaural_;
+    detail::ContentHashCache contentHash_;
   };
 
   // ---- Implementation ---- //
@@ -305,8 +396,9 @@ namespace adm {
   std::shared_ptr<AudioChannelFormat> AudioChannelFormat::create(
       AudioChannelFormatName name, TypeDescriptor channelType,
       Parameters... optionalNamedArgs) {
-    std::shared_ptr<AudioChannelFormat> channel(
-        new AudioChannelFormat(std::move(name), channelType));
+    auto channel = detail::makeElement<AudioChannelFormat>([&](void* storage) {
+      return new (storage) AudioChannelFormat(std::move(name), channelType);
+    });
     detail::setNamedOptionHelper(
         channel, std::move(optionalNamedArgs)...);
     return channel;
@@ -349,6 +441,38 @@ namespace adm {
     return get(Tag());
   }
 
+  namespace detail {
+    /// does block end before a window starting at start? Blocks with a
+    /// duration of zero at start are part of the window.
+    template <typename AudioBlockFormat>
+    bool blockEndsBefore(const AudioBlockFormat &block,
+                         std::chrono::nanoseconds start) {
+      if (!block.template has<Duration>()) return false;
+      auto duration = block.template get<Duration>()->asNanoseconds();
+      auto end = block.template get<Rtime>()->asNanoseconds() + duration;
+      return end < start || (end == start && duration.count() != 0);
+    }
+  }  // namespace detail
+
+  template <typename AudioBlockFormat>
+  BlockFormatsConstRange<AudioBlockFormat>
+  AudioChannelFormat::getElementsInWindow(const Time &start,
+                                          const Time &end) const {
+    auto blocks = getElements<AudioBlockFormat>();
+    auto startNs = start.asNanoseconds();
+    auto endNs = end.asNanoseconds();
+
+    auto first = std::partition_point(
+        blocks.begin(), blocks.end(), [startNs](const AudioBlockFormat &block) {
+          return detail::blockEndsBefore(block, startNs);
+        });
+    auto last = std::partition_point(
+        first, blocks.end(), [endNs](const AudioBlockFormat &block) {
+          return block.template get<Rtime>()->asNanoseconds() < endNs;
+        });
+    return boost::make_iterator_range(first, last);
+  }
+
   template <typename BlockFormatProxy>
   void AudioChannelFormat::assignNewIdValue() {
     for (auto &blockFormat : getElements<BlockFormatProxy>()) {
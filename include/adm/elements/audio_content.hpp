@@ -4,6 +4,7 @@
 #include <boost/optional.hpp>
 #include <memory>
 #include <vector>
+#include <utility>
 #include "adm/elements/audio_content_id.hpp"
 #include "adm/elements/audio_object.hpp"
 #include "adm/elements/dialogue.hpp"
@@ -12,8 +13,10 @@
 #include "adm/elements_fwd.hpp"
 #include "adm/helper/element_range.hpp"
 #include "adm/detail/named_option_helper.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/export.h"
 #include "adm/detail/auto_base.hpp"
+#include "adm/detail/content_hash.hpp"
 
 namespace adm {
 
@@ -94,6 +97,17 @@ namespace adm {
      */
     ADM_EXPORT std::shared_ptr<AudioContent> copy() const;
 
+    /**
+     * @brief Hash of the content of this AudioContent
+     *
+     * A stable 64-bit hash of the parameters of this element, and of the IDs of
+     * the elements it references. The AudioContentId itself is not included, so
+     * copies and elements with the same content in other documents have the
+     * same hash. The part of the hash covering the parameters is cached until
+     * one of them is changed.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
@@ -125,9 +139,27 @@ namespace adm {
     template <typename Parameter>
     bool isDefault() const;
 
-    using detail::AudioContentBase::add;
-    using detail::AudioContentBase::remove;
-    using detail::AudioContentBase::set;
+    /// @brief Setter for the parameters of the base class
+    template <typename Parameter>
+    auto set(Parameter value)
+        -> decltype(std::declval<detail::AudioContentBase&>().set(value)) {
+      contentHash_.invalidate();
+      detail::AudioContentBase::set(std::move(value));
+    }
+    /// @brief Add an item to a list parameter
+    template <typename Item>
+    auto add(Item item)
+        -> decltype(std::declval<detail::AudioContentBase&>().add(item)) {
+      contentHash_.invalidate();
+      return detail::AudioContentBase::add(std::move(item));
+    }
+    /// @brief Remove an item from a list parameter
+    template <typename Item>
+    auto remove(const Item& item)
+        -> decltype(std::declval<detail::AudioContentBase&>().remove(item)) {
+      contentHash_.invalidate();
+      detail::AudioContentBase::remove(item);
+    }
 
     /// @brief AudioContentId setter
     ADM_EXPORT void set(AudioContentId id);
@@ -227,7 +259,12 @@ namespace adm {
     using detail::AudioContentBase::get;
     using detail::AudioContentBase::has;
     using detail::AudioContentBase::isDefault;
-    using detail::AudioContentBase::unset;
+    template <typename Tag>
+    auto unset(Tag tag)
+        -> decltype(std::declval<detail::AudioContentBase&>().unset(tag)) {
+      contentHash_.invalidate();
+      detail::AudioContentBase::unset(tag);
+    }
 
     ADM_EXPORT AudioContentId
         get(detail::ParameterTraits<AudioContentId>::tag) const;
@@ -289,6 +326,7 @@ namespace adm {
     boost::optional<NonDialogueContentKind> nonDialogueContentKind_;
     boost::optional<DialogueContentKind> dialogueContentKind_;
     boost::optional<MixedContentKind> mixedContentKind_;
+    detail::ContentHashCache contentHash_;
   };
 
   ADM_EXPORT std::ostream& operator<<(
@@ -299,7 +337,9 @@ namespace adm {
   template <typename... Parameters>
   std::shared_ptr<AudioContent> AudioContent::create(
       AudioContentName name, Parameters... optionalNamedArgs) {
-    std::shared_ptr<AudioContent> content(new AudioContent(std::move(name)));
+    auto content = detail::makeElement<AudioContent>([&](void* storage) {
+      return new (storage) AudioContent(std::move(name));
+    });
     detail::setNamedOptionHelper(content, std::move(optionalNamedArgs)...);
 
     return content;
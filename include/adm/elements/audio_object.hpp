@@ -3,6 +3,7 @@
 
 #include <boost/optional.hpp>
 #include <memory>
+#include <utility>
 #include "adm/elements/time.hpp"
 #include "adm/elements/audio_object_id.hpp"
 #include "adm/elements/audio_object_interaction.hpp"
@@ -15,8 +16,10 @@
 #include "adm/elements_fwd.hpp"
 #include "adm/helper/element_range.hpp"
 #include "adm/detail/auto_base.hpp"
+#include "adm/detail/content_hash.hpp"
 #include "adm/detail/named_option_helper.hpp"
 #include "adm/detail/named_type.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/export.h"
 
 namespace adm {
@@ -150,6 +153,17 @@ namespace adm {
      */
     ADM_EXPORT std::shared_ptr<AudioObject> copy() const;
 
+    /**
+     * @brief Hash of the content of this AudioObject
+     *
+     * A stable 64-bit hash of the parameters of this element, and of the IDs of
+     * the elements it references. The AudioObjectId itself is not included, so
+     * copies and elements with the same content in other documents have the
+     * same hash. The part of the hash covering the parameters is cached until
+     * one of them is changed.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
@@ -178,9 +192,27 @@ namespace adm {
     template <typename Parameter>
     bool isDefault() const;
 
-    using detail::AudioObjectBase::add;
-    using detail::AudioObjectBase::remove;
-    using detail::AudioObjectBase::set;
+    /// @brief Setter for the parameters of the base class
+    template <typename Parameter>
+    auto set(Parameter value)
+        -> decltype(std::declval<detail::AudioObjectBase&>().set(value)) {
+      contentHash_.invalidate();
+      detail::AudioObjectBase::set(std::move(value));
+    }
+    /// @brief Add an item to a list parameter
+    template <typename Item>
+    auto add(Item item)
+        -> decltype(std::declval<detail::AudioObjectBase&>().add(item)) {
+      contentHash_.invalidate();
+      return detail::AudioObjectBase::add(std::move(item));
+    }
+    /// @brief Remove an item from a list parameter
+    template <typename Item>
+    auto remove(const Item& item)
+        -> decltype(std::declval<detail::AudioObjectBase&>().remove(item)) {
+      contentHash_.invalidate();
+      detail::AudioObjectBase::remove(item);
+    }
 
     /// @brief AudioObjectId setter
     ADM_EXPORT void set(AudioObjectId id);
@@ -285,7 +317,12 @@ namespace adm {
     using detail::AudioObjectBase::get;
     using detail::AudioObjectBase::has;
     using detail::AudioObjectBase::isDefault;
-    using detail::AudioObjectBase::unset;
+    template <typename Tag>
+    auto unset(Tag tag)
+        -> decltype(std::declval<detail::AudioObjectBase&>().unset(tag)) {
+      contentHash_.invalidate();
+      detail::AudioObjectBase::unset(tag);
+    }
 
     ADM_EXPORT AudioObjectId
         get(detail::ParameterTraits<AudioObjectId>::tag) const;
@@ -370,6 +407,7 @@ namespace adm {
     boost::optional<Interact> interact_;
     boost::optional<DisableDucking> disableDucking_;
     boost::optional<AudioObjectInteraction> audioObjectInteraction_;
+    detail::ContentHashCache contentHash_;
   };
 
   // ---- Implementation ---- //
@@ -377,7 +415,9 @@ namespace adm {
   template <typename... Parameters>
   std::shared_ptr<AudioObject> AudioObject::create(
       AudioObjectName name, Parameters... optionalNamedArgs) {
-    std::shared_ptr<AudioObject> object(new AudioObject(std::move(name)));
+    auto object = detail::makeElement<AudioObject>([&](void* storage) {
+      return new (storage) AudioObject(std::move(name));
+    });
     detail::setNamedOptionHelper(object, std::move(optionalNamedArgs)...);
 
     return object;
@@ -9,7 +9,9 @@
 #include "adm/elements_fwd.hpp"
 #include "adm/helper/element_range.hpp"
 #include "adm/detail/named_option_helper.hpp"
+#include "adm/detail/content_hash.hpp"
 #include "adm/detail/named_type.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/export.h"
 
 namespace adm {
@@ -81,6 +83,18 @@ namespace adm {
      */
     ADM_EXPORT std::shared_ptr<AudioPackFormat> copy() const;
 
+    /**
+     * @brief Hash of the content of this AudioPackFormat
+     *
+     * A stable 64-bit hash of the parameters of this element, and of the IDs of
+     * the elements it references. The AudioPackFormatId itself is not included,
+     * so copies and elements with the same content in other documents have the
+     * same hash. The parameters of an AudioPackFormatHoa are included. The part
+     * of the hash covering the parameters is cached until one of them is
+     * changed.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
@@ -243,6 +257,7 @@ namespace adm {
     boost::optional<AbsoluteDistance> absoluteDistance_;
     std::vector<std::shared_ptr<AudioChannelFormat>> audioChannelFormats_;
     std::vector<std::shared_ptr<AudioPackFormat>> audioPackFormats_;
+    detail::ContentHashCache contentHash_;
   };
 
   // ---- Implementation ---- //
@@ -256,8 +271,9 @@ namespace adm {
           "For AudioPackFormat of type HOA use AudioPackFormatHoa::create() instead.");
     } else {
 
-      std::shared_ptr<AudioPackFormat> pack(
-          new AudioPackFormat(std::move(name), channelType));
+      auto pack = detail::makeElement<AudioPackFormat>([&](void* storage) {
+        return new (storage) AudioPackFormat(std::move(name), channelType);
+      });
       detail::setNamedOptionHelper(
           pack, std::move(optionalNamedArgs)...);
       return pack;
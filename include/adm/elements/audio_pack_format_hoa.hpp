@@ -110,7 +110,9 @@ namespace adm {
     template <typename... Parameters>
     std::shared_ptr<AudioPackFormatHoa> AudioPackFormatHoa::create(
         AudioPackFormatName name, Parameters... optionalNamedArgs) {
-      std::shared_ptr<AudioPackFormatHoa> pack(new AudioPackFormatHoa(name));
+      auto pack = detail::makeElement<AudioPackFormatHoa>([&](void* storage) {
+        return new (storage) AudioPackFormatHoa(name);
+      });
       detail::setNamedOptionHelper(
           pack, std::move(optionalNamedArgs)...);
       return pack;
@@ -4,6 +4,7 @@
 #include <boost/optional.hpp>
 #include <memory>
 #include <vector>
+#include <utility>
 #include "adm/elements/label.hpp"
 #include "adm/elements/time.hpp"
 #include "adm/elements/audio_content.hpp"
@@ -13,8 +14,10 @@
 #include "adm/elements_fwd.hpp"
 #include "adm/helper/element_range.hpp"
 #include "adm/detail/auto_base.hpp"
+#include "adm/detail/content_hash.hpp"
 #include "adm/detail/named_option_helper.hpp"
 #include "adm/detail/named_type.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/export.h"
 #include "adm/detail/auto_base.hpp"
 
@@ -111,6 +114,17 @@ namespace adm {
      */
     ADM_EXPORT std::shared_ptr<AudioProgramme> copy() const;
 
+    /**
+     * @brief Hash of the content of this AudioProgramme
+     *
+     * A stable 64-bit hash of the parameters of this element, and of the IDs of
+     * the elements it references. The AudioProgrammeId itself is not included,
+     * so copies and elements with the same content in other documents have the
+     * same hash. The part of the hash covering the parameters is cached until
+     * one of them is changed.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
@@ -140,9 +154,27 @@ namespace adm {
     template <typename Parameter>
     bool isDefault() const;
 
-    using detail::AudioProgrammeBase::add;
-    using detail::AudioProgrammeBase::remove;
-    using detail::AudioProgrammeBase::set;
+    /// @brief Setter for the parameters of the base class
+    template <typename Parameter>
+    auto set(Parameter value)
+        -> decltype(std::declval<detail::AudioProgrammeBase&>().set(value)) {
+      contentHash_.invalidate();
+      detail::AudioProgrammeBase::set(std::move(value));
+    }
+    /// @brief Add an item to a list parameter
+    template <typename Item>
+    auto add(Item item)
+        -> decltype(std::declval<detail::AudioProgrammeBase&>().add(item)) {
+      contentHash_.invalidate();
+      return detail::AudioProgrammeBase::add(std::move(item));
+    }
+    /// @brief Remove an item from a list parameter
+    template <typename Item>
+    auto remove(const Item& item)
+        -> decltype(std::declval<detail::AudioProgrammeBase&>().remove(item)) {
+      contentHash_.invalidate();
+      detail::AudioProgrammeBase::remove(item);
+    }
 
     /// @brief AudioProgrammeId setter
     ADM_EXPORT void set(AudioProgrammeId id);
@@ -223,7 +255,12 @@ namespace adm {
     using detail::AudioProgrammeBase::get;
     using detail::AudioProgrammeBase::has;
     using detail::AudioProgrammeBase::isDefault;
-    using detail::AudioProgrammeBase::unset;
+    template <typename Tag>
+    auto unset(Tag tag)
+        -> decltype(std::declval<detail::AudioProgrammeBase&>().unset(tag)) {
+      contentHash_.invalidate();
+      detail::AudioProgrammeBase::unset(tag);
+    }
 
     ADM_EXPORT AudioProgrammeId
         get(detail::ParameterTraits<AudioProgrammeId>::tag) const;
@@ -283,6 +320,7 @@ namespace adm {
     std::vector<std::shared_ptr<AudioContent>> audioContents_;
     boost::optional<MaxDuckingDepth> maxDuckingDepth_;
     boost::optional<AudioProgrammeReferenceScreen> refScreen_;
+    detail::ContentHashCache contentHash_;
   };
   ///@}
 
@@ -291,8 +329,9 @@ namespace adm {
   template <typename... Parameters>
   std::shared_ptr<AudioProgramme> AudioProgramme::create(
       AudioProgrammeName name, Parameters... optionalNamedArgs) {
-    std::shared_ptr<AudioProgramme> programme(
-        new AudioProgramme(std::move(name)));
+    auto programme = detail::makeElement<AudioProgramme>([&](void* storage) {
+      return new (storage) AudioProgramme(std::move(name));
+    });
     detail::setNamedOptionHelper(programme, std::move(optionalNamedArgs)...);
 
     return programme;
@@ -10,7 +10,9 @@
 #include "adm/elements_fwd.hpp"
 #include "adm/helper/element_range.hpp"
 #include "adm/detail/named_option_helper.hpp"
+#include "adm/detail/content_hash.hpp"
 #include "adm/detail/named_type.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/export.h"
 
 namespace adm {
@@ -105,6 +107,17 @@ namespace adm {
      */
     ADM_EXPORT std::shared_ptr<AudioStreamFormat> copy() const;
 
+    /**
+     * @brief Hash of the content of this AudioStreamFormat
+     *
+     * A stable 64-bit hash of the parameters of this element, and of the IDs of
+     * the elements it references. The AudioStreamFormatId itself is not
+     * included, so copies and elements with the same content in other documents
+     * have the same hash. The part of the hash covering the parameters is
+     * cached until one of them is changed.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
@@ -310,6 +323,7 @@ namespace adm {
     std::shared_ptr<AudioChannelFormat> audioChannelFormat_;
     std::shared_ptr<AudioPackFormat> audioPackFormat_;
     std::vector<std::weak_ptr<AudioTrackFormat>> audioTrackFormats_;
+    detail::ContentHashCache contentHash_;
   };
 
   // ---- Implementation ---- //
@@ -318,8 +332,10 @@ namespace adm {
   std::shared_ptr<AudioStreamFormat> AudioStreamFormat::create(
       AudioStreamFormatName name, FormatDescriptor format,
       Parameters... optionalNamedArgs) {
-    std::shared_ptr<AudioStreamFormat> streamFormat(
-        new AudioStreamFormat(std::move(name), format));
+    auto streamFormat =
+        detail::makeElement<AudioStreamFormat>([&](void* storage) {
+          return new (storage) AudioStreamFormat(std::move(name), format);
+        });
     detail::setNamedOptionHelper(streamFormat, std::move(optionalNamedArgs)...);
 
     return streamFormat;
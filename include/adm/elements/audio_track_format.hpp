@@ -6,7 +6,9 @@
 #include "adm/elements/format_descriptor.hpp"
 #include "adm/elements_fwd.hpp"
 #include "adm/detail/named_option_helper.hpp"
+#include "adm/detail/content_hash.hpp"
 #include "adm/detail/named_type.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/export.h"
 #include <boost/optional.hpp>
 #include <memory>
@@ -78,6 +80,17 @@ namespace adm {
      */
     ADM_EXPORT std::shared_ptr<AudioTrackFormat> copy() const;
 
+    /**
+     * @brief Hash of the content of this AudioTrackFormat
+     *
+     * A stable 64-bit hash of the parameters of this element, and of the IDs of
+     * the elements it references. The AudioTrackFormatId itself is not
+     * included, so copies and elements with the same content in other documents
+     * have the same hash. The part of the hash covering the parameters is
+     * cached until one of them is changed.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
@@ -224,6 +237,7 @@ namespace adm {
     AudioTrackFormatId id_;
     FormatDescriptor format_;
     std::shared_ptr<AudioStreamFormat> audioStreamFormat_;
+    detail::ContentHashCache contentHash_;
   };
 
   // ---- Implementation ---- //
@@ -232,8 +246,10 @@ namespace adm {
   std::shared_ptr<AudioTrackFormat> AudioTrackFormat::create(
       AudioTrackFormatName name, FormatDescriptor format,
       Parameters... optionalNamedArgs) {
-    std::shared_ptr<AudioTrackFormat> trackFormat(
-        new AudioTrackFormat(std::move(name), format));
+    auto trackFormat =
+        detail::makeElement<AudioTrackFormat>([&](void* storage) {
+          return new (storage) AudioTrackFormat(std::move(name), format);
+        });
     detail::setNamedOptionHelper(trackFormat, std::move(optionalNamedArgs)...);
 
     return trackFormat;
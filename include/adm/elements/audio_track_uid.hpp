@@ -8,7 +8,9 @@
 #include "adm/elements/audio_track_uid_id.hpp"
 #include "adm/elements_fwd.hpp"
 #include "adm/detail/named_option_helper.hpp"
+#include "adm/detail/content_hash.hpp"
 #include "adm/detail/named_type.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/export.h"
 
 namespace adm {
@@ -76,6 +78,17 @@ namespace adm {
      */
     ADM_EXPORT std::shared_ptr<AudioTrackUid> copy() const;
 
+    /**
+     * @brief Hash of the content of this AudioTrackUid
+     *
+     * A stable 64-bit hash of the parameters of this element, and of the IDs of
+     * the elements it references. The AudioTrackUidId itself is not included,
+     * so copies and elements with the same content in other documents have the
+     * same hash. The part of the hash covering the parameters is cached until
+     * one of them is changed.
+     */
+    ADM_EXPORT std::uint64_t contentHash() const;
+
     /**
      * @brief ADM parameter getter template
      *
@@ -236,6 +249,7 @@ namespace adm {
     std::shared_ptr<AudioTrackFormat> audioTrackFormat_;
     std::shared_ptr<AudioChannelFormat> audioChannelFormat_;
     std::shared_ptr<AudioPackFormat> audioPackFormat_;
+    detail::ContentHashCache contentHash_;
   };
 
   // ---- Implementation ---- //
@@ -243,7 +257,8 @@ namespace adm {
   template <typename... Parameters>
   std::shared_ptr<AudioTrackUid> AudioTrackUid::create(
       Parameters... optionalNamedArgs) {
-    std::shared_ptr<AudioTrackUid> trackUid(new AudioTrackUid());
+    auto trackUid = detail::makeElement<AudioTrackUid>(
+        [&](void* storage) { return new (storage) AudioTrackUid(); });
     detail::setNamedOptionHelper(trackUid, std::move(optionalNamedArgs)...);
 
     return trackUid;
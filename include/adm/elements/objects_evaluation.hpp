@@ -0,0 +1,57 @@
+/// @file objects_evaluation.hpp
+#pragma once
+
+#include <cstddef>
+
+namespace adm {
+
+  class AudioChannelFormat;
+
+  /**
+   * @brief Destination arrays for AudioChannelFormat::evaluateObjects
+   * @headerfile objects_evaluation.hpp <adm/elements/objects_evaluation.hpp>
+   *
+   * Each non-null pointer must have space for one value per time evaluated;
+   * parameters with a null pointer are not evaluated.
+   */
+  struct ObjectsParameterBuffers {
+    /// azimuth of a SphericalPosition, or X of a CartesianPosition
+    float *azimuthOrX = nullptr;
+    /// elevation of a SphericalPosition, or Y of a CartesianPosition
+    float *elevationOrY = nullptr;
+    /// distance of a SphericalPosition, or Z of a CartesianPosition
+    float *distanceOrZ = nullptr;
+    /// true where the position is a CartesianPosition
+    bool *cartesian = nullptr;
+    /// linear gain
+    float *gain = nullptr;
+    float *width = nullptr;
+    float *height = nullptr;
+    float *depth = nullptr;
+    float *diffuse = nullptr;
+  };
+
+  /**
+   * @brief Position within the audioBlockFormats of an AudioChannelFormat
+   * @headerfile objects_evaluation.hpp <adm/elements/objects_evaluation.hpp>
+   *
+   * Keeping a cursor between calls to AudioChannelFormat::evaluateObjects
+   * means that each call only has to look at the blocks after those used in
+   * the previous call, as long as the times increase from one call to the
+   * next. Times before the cursor are still handled correctly, but must be
+   * searched for.
+   */
+  class BlockCursor {
+   public:
+    /// go back to the first block
+    void reset() { index_ = 0; }
+
+    /// index of the block used for the last time evaluated
+    std::size_t index() const { return index_; }
+
+   private:
+    friend class AudioChannelFormat;
+    std::size_t index_ = 0;
+  };
+
+}  // namespace adm
@@ -110,4 +110,24 @@ namespace adm {
     }
   };
 
+  class DocumentAttorney {
+   private:
+    friend class AudioProgramme;
+    friend class AudioContent;
+    friend class AudioObject;
+    friend class AudioPackFormat;
+    friend class AudioChannelFormat;
+    friend class AudioStreamFormat;
+    friend class AudioTrackFormat;
+    friend class AudioTrackUid;
+
+    /// tell the parent document of element that its ID changed from oldId
+    template <typename Element>
+    static void idChanged(const Element& element,
+                          const typename Element::id_type& oldId) {
+      if (auto document = element.getParent().lock())
+        document->idChanged(element, oldId);
+    }
+  };
+
 }  // namespace adm
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 #include <boost/variant.hpp>
@@ -115,4 +116,15 @@ namespace adm {
   ADM_EXPORT Time parseTimecode(const std::string& timecode);
   /// @brief Format a std::chrono::duration object as an adm timecode string
   ADM_EXPORT std::string formatTimecode(const Time& time);
+
+  /// @brief Maximum number of characters written by
+  /// formatTimecode(const Time&, char*)
+  constexpr std::size_t maxTimecodeLength = 72;
+  /// @brief Format a Time as an adm timecode without allocating
+  ///
+  /// @param time the time to format
+  /// @param buffer destination, with space for at least maxTimecodeLength
+  /// characters
+  /// @return the number of characters written; no null terminator is added
+  ADM_EXPORT std::size_t formatTimecode(const Time& time, char* buffer);
 }  // namespace adm
@@ -1,5 +1,7 @@
 #pragma once
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include <boost/optional.hpp>
 #include <adm/elements/audio_object_id.hpp>
 #include <adm/elements/audio_channel_format_id.hpp>
@@ -69,9 +71,16 @@ namespace adm {
     class ADM_EXPORT XmlParsingUnresolvedReference : public XmlParsingError {
      public:
       explicit XmlParsingUnresolvedReference(const std::string& id);
+      /// report several unresolved references at once; ids must not be empty
+      explicit XmlParsingUnresolvedReference(std::vector<std::string> ids);
+
+      /// the IDs which could not be resolved, in the order they were found
+      const std::vector<std::string>& ids() const { return ids_; }
 
      private:
-      std::string formatMessage(const std::string& id);
+      static std::string formatMessage(const std::vector<std::string>& ids);
+
+      std::vector<std::string> ids_;
     };
 
     class ADM_EXPORT XmlParsingUnexpectedAttrError : public XmlParsingError {
@@ -0,0 +1,160 @@
+/// @file memory_arena.hpp
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "adm/export.h"
+
+namespace adm {
+
+  /**
+   * @brief Monotonic memory arena for ADM elements
+   *
+   * Allocations are served from large chunks, and individual deallocations
+   * do nothing; all memory is released in one go when the arena is
+   * destroyed. This replaces one or two heap allocations per element with a
+   * pointer bump, and keeps the elements of a document close together in
+   * memory.
+   *
+   * An arena is attached to a Document with `Document::create(arena)`, and
+   * is used for elements created while an ArenaScope for it is active. The
+   * parser, `Document::deepCopy()` and `deepCopyTo()` do this automatically
+   * for documents which have an arena.
+   *
+   * Each element allocated from an arena keeps it alive, so elements may
+   * safely outlive their document. Memory is not reused when elements are
+   * removed from a document, so arenas are best suited to documents which
+   * are built (or parsed) once and then released as a whole.
+   *
+   * Allocation is thread safe.
+   */
+  class MemoryArena {
+   public:
+    /// allocation statistics, for instrumentation
+    struct Stats {
+      /// number of allocations served by the arena
+      std::size_t allocations = 0;
+      /// total bytes requested, excluding alignment padding
+      std::size_t bytes = 0;
+      /// number of chunks allocated from the heap
+      std::size_t chunks = 0;
+    };
+
+    static constexpr std::size_t defaultChunkSize = 64 * 1024;
+
+    /// create an arena which allocates chunks of at least chunkSize bytes
+    ADM_EXPORT static std::shared_ptr<MemoryArena> create(
+        std::size_t chunkSize = defaultChunkSize);
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    /// allocate size bytes, aligned to alignment (which must be a power of
+    /// two, no larger than alignof(std::max_align_t))
+    ADM_EXPORT void* allocate(std::size_t size,
+                              std::size_t alignment = alignof(
+                                  std::max_align_t));
+
+    /// get the allocation statistics so far
+    ADM_EXPORT Stats stats() const;
+
+   private:
+    explicit MemoryArena(std::size_t chunkSize);
+
+    std::size_t chunkSize_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char* current_ = nullptr;
+    std::size_t remaining_ = 0;
+    Stats stats_;
+    mutable std::mutex mutex_;
+  };
+
+  /**
+   * @brief Standard allocator which allocates from a MemoryArena
+   *
+   * Copies share ownership of the arena.
+   */
+  template <typename T>
+  class ArenaAllocator {
+   public:
+    using value_type = T;
+
+    explicit ArenaAllocator(std::shared_ptr<MemoryArena> arena)
+        : arena_(std::move(arena)) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+    T* allocate(std::size_t n) {
+      return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, std::size_t) {}
+
+    const std::shared_ptr<MemoryArena>& arena() const { return arena_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+      return arena_ == other.arena();
+    }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+      return arena_ != other.arena();
+    }
+
+   private:
+    std::shared_ptr<MemoryArena> arena_;
+  };
+
+  /**
+   * @brief Allocate elements created on this thread from an arena
+   *
+   * While an ArenaScope is active, elements created with `create()` or
+   * `copy()` on the same thread are allocated from its arena. Scopes nest;
+   * a scope with a null arena makes elements be allocated from the heap.
+   */
+  class ArenaScope {
+   public:
+    ADM_EXPORT explicit ArenaScope(std::shared_ptr<MemoryArena> arena);
+    ADM_EXPORT ~ArenaScope();
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+   private:
+    std::shared_ptr<MemoryArena> previous_;
+  };
+
+  namespace detail {
+    /// the arena of the innermost ArenaScope on this thread, if any
+    ADM_EXPORT const std::shared_ptr<MemoryArena>& currentArena();
+
+    /**
+     * @brief Allocate an element, from the current arena if there is one
+     *
+     * Element constructors are private, so construct is a callable from
+     * within the element class which constructs a T in the storage it is
+     * given with placement new, and returns a pointer to it.
+     */
+    template <typename T, typename Construct>
+    std::shared_ptr<T> makeElement(Construct construct) {
+      const auto& arena = currentArena();
+      if (!arena) {
+        void* storage = ::operator new(sizeof(T));
+        T* element;
+        try {
+          element = construct(storage);
+        } catch (...) {
+          ::operator delete(storage);
+          throw;
+        }
+        return std::shared_ptr<T>(element);
+      }
+
+      T* element = construct(arena->allocate(sizeof(T), alignof(T)));
+      return std::shared_ptr<T>(
+          element, [](T* p) { p->~T(); }, ArenaAllocator<T>(arena));
+    }
+  }  // namespace detail
+
+}  // namespace adm
@@ -1,5 +1,6 @@
 /// @file parse.hpp
 #pragma once
+#include <cstddef>
 #include <string>
 #include <memory>
 #include <iosfwd>
@@ -30,7 +31,15 @@ namespace adm {
       recursive_node_search =
           0x1,  ///< recursively search whole xml for audioFormatExtended node
       permit_time_reference_mismatch =
-          0x2  ///< do not report a mismatch between the FrameHeader TimeReference and audioBlockFormat lstart/rtime lduration/duration as an error
+          0x2,  ///< do not report a mismatch between the FrameHeader TimeReference and audioBlockFormat lstart/rtime lduration/duration as an error
+      incremental =
+          0x4,  ///< read the XML incrementally, converting elements (and individual audioBlockFormats) as they are read rather than holding the whole input and its DOM in memory; use this to bound memory use when parsing very long documents
+      memory_map =
+          0x8,  ///< when parsing a file, memory-map it rather than reading it into a buffer; the file must not be modified while it is being parsed. Ignored if incremental is set, or if memory mapping is not supported on this platform
+      parallel =
+          0x10,  ///< convert audioChannelFormats (including their audioBlockFormats) using multiple threads; the resulting document is the same as without this option. Ignored if incremental is set
+      arena =
+          0x20  ///< allocate the elements of the resulting document from a MemoryArena owned by it (see Document::create(std::shared_ptr<MemoryArena>)), rather than individually
     };
   }  // namespace xml
 
@@ -88,6 +97,37 @@ namespace adm {
       std::istream& stream, FrameHeader const& header,
       xml::ParserOptions options = xml::ParserOptions::none);
 
+  /**
+   * @brief Parse an XML representation of the Audio Definition Model
+   *
+   * Parse adm data from a buffer, for example an axml chunk in a
+   * memory-mapped BW64 file. The buffer is only read while this function
+   * runs. The parser needs a modifiable copy of the data, which is made in
+   * one go; with `xml::ParserOptions::incremental` the data is instead read
+   * in place, a little at a time.
+   * @param data start of the XML data; it does not need to be null-terminated
+   * @param size size of the XML data in bytes
+   * @param options Options to influence the XML parser behaviour
+   */
+  ADM_EXPORT std::shared_ptr<Document> parseXml(
+      const char* data, std::size_t size,
+      xml::ParserOptions options = xml::ParserOptions::none);
+
+  /**
+   * @brief Parse an xml document containing an audioFormatExtended
+   * node into an adm::Document, using a SADM FrameHeader to check for consistency.
+   * Primarily intended for parsing sadm frames.
+   *
+   * Parse adm data from a buffer; see
+   * `parseXml(const char*, std::size_t, xml::ParserOptions)`.
+   * @param data start of the XML data; it does not need to be null-terminated
+   * @param size size of the XML data in bytes
+   * @param options Options to influence the XML parser behaviour
+   */
+  ADM_EXPORT std::shared_ptr<Document> parseXml(
+      const char* data, std::size_t size, FrameHeader const& header,
+      xml::ParserOptions options = xml::ParserOptions::none);
+
   /**
    * @brief Parse an XML representation of a serial ADM frame and return
    * the frameHeader element as an adm::FrameHeader object
@@ -112,6 +152,19 @@ namespace adm {
   parseFrameHeader(std::string const& fileName,
                    adm::xml::ParserOptions = adm::xml::ParserOptions::none);
 
+  /**
+   * @brief Parse an XML representation of a serial ADM frame and return
+   * the frameHeader element as an adm::FrameHeader object
+   *
+   * Parse data from a buffer, which does not need to be null-terminated.
+   * @param data start of the XML data
+   * @param size size of the XML data in bytes
+   * @param options Options to influence the parser behaviour
+   */
+  ADM_EXPORT FrameHeader
+  parseFrameHeader(const char* data, std::size_t size,
+                   adm::xml::ParserOptions = adm::xml::ParserOptions::none);
+
   /**
    * @}
    */
@@ -0,0 +1,20 @@
+#pragma once
+#include "adm/common_definitions_tables.hpp"
+
+namespace adm {
+  namespace common_definitions {
+    namespace detail {
+
+      /// @name ID indices
+      /// Indices into the corresponding common definitions tables, sorted by
+      /// ID. These are generated along with the tables.
+      /// @{
+      TableRange<std::size_t> packFormatsById();
+      TableRange<std::size_t> channelFormatsById();
+      TableRange<std::size_t> streamFormatsById();
+      TableRange<std::size_t> trackFormatsById();
+      /// @}
+
+    }  // namespace detail
+  }  // namespace common_definitions
+}  // namespace adm
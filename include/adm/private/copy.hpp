@@ -2,15 +2,20 @@
 
 #include <algorithm>
 #include <boost/variant.hpp>
-#include <unordered_map>
+#include <functional>
 #include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "adm/document.hpp"
 #include "adm/elements.hpp"
 #include "adm/element_variant.hpp"
 
 namespace adm {
 
   std::vector<ElementVariant> copyAllElements(
-      std::shared_ptr<const Document> document);
+      std::shared_ptr<const Document> document,
+      CopyOptions options = CopyOptions::none);
 
   template <typename C>
   class AddTo : public boost::static_visitor<> {
@@ -41,56 +46,101 @@ namespace adm {
     }
   }
 
+  /**
+   * @brief Copies of the elements of one type in a document
+   *
+   * Copies are stored in the same order as the source elements in the
+   * document, so the copy of the element at position i is found directly.
+   * Referenced elements are found by binary search in a table of source
+   * element addresses, sorted once when the copies are made.
+   */
+  template <typename Element>
+  class ElementCopies {
+   public:
+    template <typename Range, typename CopyElement>
+    void copy(const Range& elements, CopyElement copyElement) {
+      copies_.reserve(elements.size());
+      positions_.reserve(elements.size());
+      for (const auto& element : elements) {
+        positions_.emplace_back(element.get(), copies_.size());
+        copies_.push_back(copyElement(*element));
+      }
+      std::sort(positions_.begin(), positions_.end(), PositionLess());
+    }
+
+    /// the copy of the element at position index in the source document
+    const std::shared_ptr<Element>& operator[](std::size_t index) const {
+      return copies_[index];
+    }
+
+    /// the copy of element, which must be in the source document
+    const std::shared_ptr<Element>& copyOf(const Element* element) const {
+      auto it = std::lower_bound(positions_.begin(), positions_.end(),
+                                 element, PositionLess());
+      if (it == positions_.end() || it->first != element)
+        throw std::out_of_range(
+            "referenced element is not in the document being copied");
+      return copies_[it->second];
+    }
+
+    const std::vector<std::shared_ptr<Element>>& copies() const {
+      return copies_;
+    }
+
+   private:
+    typedef std::pair<const Element*, std::size_t> Position;
+
+    struct PositionLess {
+      bool operator()(const Position& a, const Position& b) const {
+        return std::less<const Element*>()(a.first, b.first);
+      }
+      bool operator()(const Position& a, const Element* b) const {
+        return std::less<const Element*>()(a.first, b);
+      }
+    };
+
+    std::vector<std::shared_ptr<Element>> copies_;
+    std::vector<Position> positions_;
+  };
+
   template <typename ElementSrc, typename ElementDest>
-  void resolveReferences(
-      const std::shared_ptr<const ElementSrc>& element,
-      const std::unordered_map<std::shared_ptr<const ElementSrc>,
-                               std::shared_ptr<ElementSrc>>& mappingSrc,
-      const std::unordered_map<std::shared_ptr<const ElementDest>,
-                               std::shared_ptr<ElementDest>>& mappingDest) {
+  void resolveReferences(const ElementSrc& element,
+                         const std::shared_ptr<ElementSrc>& copy,
+                         const ElementCopies<ElementDest>& copiesDest) {
     for (const auto& reference :
-         element->template getReferences<ElementDest>()) {
-      mappingSrc.at(element)->addReference(mappingDest.at(reference));
+         element.template getReferences<ElementDest>()) {
+      copy->addReference(copiesDest.copyOf(reference.get()));
     }
   }
 
   inline void resolveReferences(
-      const std::shared_ptr<const AudioStreamFormat>& element,
-      const std::unordered_map<std::shared_ptr<const AudioStreamFormat>,
-                               std::shared_ptr<AudioStreamFormat>>& mappingSrc,
-      const std::unordered_map<std::shared_ptr<const AudioTrackFormat>,
-                               std::shared_ptr<AudioTrackFormat>>&
-          mappingDest) {
-    for (const auto& weakReference : element->getAudioTrackFormatReferences()) {
+      const AudioStreamFormat& element,
+      const std::shared_ptr<AudioStreamFormat>& copy,
+      const ElementCopies<AudioTrackFormat>& copiesDest) {
+    for (const auto& weakReference : element.getAudioTrackFormatReferences()) {
       auto reference = weakReference.lock();
       if (reference) {
-        mappingSrc.at(element)->addReference(
-            std::weak_ptr<AudioTrackFormat>(mappingDest.at(reference)));
+        copy->addReference(std::weak_ptr<AudioTrackFormat>(
+            copiesDest.copyOf(reference.get())));
       }
     }
   }
 
   template <typename ElementSrc, typename ElementDest>
-  void resolveReference(
-      const std::shared_ptr<const ElementSrc>& element,
-      const std::unordered_map<std::shared_ptr<const ElementSrc>,
-                               std::shared_ptr<ElementSrc>>& mappingSrc,
-      const std::unordered_map<std::shared_ptr<const ElementDest>,
-                               std::shared_ptr<ElementDest>>& mappingDest) {
-    if (auto reference = element->template getReference<ElementDest>()) {
-      mappingSrc.at(element)->setReference(mappingDest.at(reference));
+  void resolveReference(const ElementSrc& element,
+                        const std::shared_ptr<ElementSrc>& copy,
+                        const ElementCopies<ElementDest>& copiesDest) {
+    if (auto reference = element.template getReference<ElementDest>()) {
+      copy->setReference(copiesDest.copyOf(reference.get()));
     }
   }
 
   template <typename ElementSrc, typename ElementDest>
-  void resolveComplementaries(
-      const std::shared_ptr<const ElementSrc>& element,
-      const std::unordered_map<std::shared_ptr<const ElementSrc>,
-                               std::shared_ptr<ElementSrc>>& mappingSrc,
-      const std::unordered_map<std::shared_ptr<const ElementDest>,
-                               std::shared_ptr<ElementDest>>& mappingDest) {
-    for (const auto& reference : element->getComplementaryObjects()) {
-      mappingSrc.at(element)->addComplementary(mappingDest.at(reference));
+  void resolveComplementaries(const ElementSrc& element,
+                              const std::shared_ptr<ElementSrc>& copy,
+                              const ElementCopies<ElementDest>& copiesDest) {
+    for (const auto& reference : element.getComplementaryObjects()) {
+      copy->addComplementary(copiesDest.copyOf(reference.get()));
     }
   }
 
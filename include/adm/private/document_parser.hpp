@@ -1,8 +1,9 @@
 #pragma once
-#include <iosfwd>
+#include <istream>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include "adm/document.hpp"
 #include "adm/elements.hpp"
@@ -12,6 +13,8 @@
 #include "rapidxml/rapidxml_utils.hpp"
 #include "adm/elements/audio_pack_format_hoa.hpp"
 #include "adm/detail/id_map.hpp"
+#include "adm/private/xml_input.hpp"
+#include "adm/private/xml_tag_reader.hpp"
 #include <adm/serial.hpp>
 
 namespace adm {
@@ -75,6 +78,39 @@ namespace adm {
     NodePtr findAudioFormatExtendedNodeFullRecursive(NodePtr root);
     NodePtr findFrameAudioFormatExtended(NodePtr node);
 
+    /**
+     * @brief References from elements of type Src to IDs of type TargetId
+     *
+     * These are recorded while parsing, and resolved once all elements have
+     * been parsed. They are stored flat, in the order they were found, so
+     * that recording a reference is an append, and resolution is a single
+     * linear pass in document order.
+     *
+     * The source elements are owned by the document being parsed, so are not
+     * reference counted here.
+     *
+     * There is one table per kind of reference rather than one shared table,
+     * so that the source and ID types are known statically and entries need
+     * no type tag or indirection.
+     */
+    template <typename Src, typename TargetId>
+    class PendingReferences {
+     public:
+      struct Entry {
+        Src* source;
+        TargetId id;
+      };
+
+      void add(const std::shared_ptr<Src>& source, TargetId id) {
+        entries_.push_back(Entry{source.get(), std::move(id)});
+      }
+
+      const std::vector<Entry>& entries() const { return entries_; }
+
+     private:
+      std::vector<Entry> entries_;
+    };
+
     class DocumentParser {
      public:
       explicit DocumentParser(
@@ -84,6 +120,11 @@ namespace adm {
       explicit DocumentParser(
           std::istream& stream, ParserOptions options = ParserOptions::none,
           std::shared_ptr<Document> destDocument = Document::create());
+      /// parse from a buffer, which must remain valid until parse() returns
+      DocumentParser(
+          const char* data, std::size_t size,
+          ParserOptions options = ParserOptions::none,
+          std::shared_ptr<Document> destDocument = Document::create());
 
       void setHeader(FrameHeader header);
       std::shared_ptr<Document> parse();
@@ -91,12 +132,24 @@ namespace adm {
       bool hasUnresolvedReferences();
 
      private:
-      explicit DocumentParser(
-          rapidxml::file<> file, ParserOptions options = ParserOptions::none,
-          std::shared_ptr<Document> destDocument = Document::create());
+      class FragmentParser;
 
       boost::optional<TimeReference> getTimeReference() const;
 
+      /// parse an element within audioFormatExtended
+      void parseElement(NodePtr node);
+      /// parse all elements within audioFormatExtended, for
+      /// ParserOptions::parallel
+      void parseElementsParallel(NodePtr root);
+      void resolveAllReferences();
+
+      /// parse from stream_ for ParserOptions::incremental
+      std::shared_ptr<Document> parseIncremental();
+      void parseAudioFormatExtendedIncremental(XmlTagReader& reader,
+                                               FragmentParser& fragment);
+      void parseAudioChannelFormatIncremental(XmlTagReader& reader,
+                                              FragmentParser& fragment);
+
       std::shared_ptr<AudioProgramme> parseAudioProgramme(NodePtr node);
       std::shared_ptr<AudioContent> parseAudioContent(NodePtr node);
       std::shared_ptr<AudioObject> parseAudioObject(NodePtr node);
@@ -105,30 +158,46 @@ namespace adm {
       std::shared_ptr<AudioPackFormat> parseAudioPackFormat(NodePtr node);
       std::shared_ptr<AudioTrackUid> parseAudioTrackUid(NodePtr node);
       std::shared_ptr<AudioChannelFormat> parseAudioChannelFormat(NodePtr node);
-
-      rapidxml::file<> xmlFile_;
+      void setAudioChannelFormatProperties(
+          const std::shared_ptr<AudioChannelFormat>& audioChannelFormat,
+          NodePtr node);
+      void addAudioBlockFormat(
+          const std::shared_ptr<AudioChannelFormat>& audioChannelFormat,
+          NodePtr node);
+
+      /// the whole input; not used in incremental mode
+      XmlInput input_;
+      /// the input in incremental mode
+      std::istream* stream_ = nullptr;
+      /// owned stream for stream_, when not parsing from a user stream
+      std::unique_ptr<std::istream> fileStream_;
       ParserOptions options_;
       std::shared_ptr<Document> document_;
       boost::optional<FrameHeader> frameHeader_;
 
       // clang-format off
-      std::map<std::shared_ptr<AudioProgramme>, std::vector<AudioContentId>> programmeContentRefs_;
-      std::map<std::shared_ptr<AudioContent>, std::vector<AudioObjectId>> contentObjectRefs_;
-      std::map<std::shared_ptr<AudioObject>, std::vector<AudioObjectId>> objectObjectRefs_;
-      std::map<std::shared_ptr<AudioObject>, std::vector<AudioObjectId>> objectComplementaryObjectRefs_;
-      std::map<std::shared_ptr<AudioObject>, std::vector<AudioPackFormatId>> objectPackFormatRefs_;
-      std::map<std::shared_ptr<AudioObject>, std::vector<AudioTrackUidId>> objectTrackUidRefs_;
-      std::map<std::shared_ptr<AudioTrackUid>, AudioTrackFormatId> trackUidTrackFormatRef_;
-      std::map<std::shared_ptr<AudioTrackUid>, AudioChannelFormatId> trackUidChannelFormatRef_;
-      std::map<std::shared_ptr<AudioTrackUid>, AudioPackFormatId> trackUidPackFormatRef_;
-      std::map<std::shared_ptr<AudioPackFormat>, std::vector<AudioChannelFormatId>> packFormatChannelFormatRefs_;
-      std::map<std::shared_ptr<AudioPackFormat>, std::vector<AudioPackFormatId>> packFormatPackFormatRefs_;
-      std::map<std::shared_ptr<AudioTrackFormat>, AudioStreamFormatId> trackFormatStreamFormatRef_;
-      std::map<std::shared_ptr<AudioStreamFormat>, AudioChannelFormatId> streamFormatChannelFormatRef_;
-      std::map<std::shared_ptr<AudioStreamFormat>, AudioPackFormatId> streamFormatPackFormatRef_;
-      std::map<std::shared_ptr<AudioStreamFormat>, std::vector<AudioTrackFormatId>> streamFormatTrackFormatRefs_;
+      PendingReferences<AudioProgramme, AudioContentId> programmeContentRefs_;
+      PendingReferences<AudioContent, AudioObjectId> contentObjectRefs_;
+      PendingReferences<AudioObject, AudioObjectId> objectObjectRefs_;
+      PendingReferences<AudioObject, AudioObjectId> objectComplementaryObjectRefs_;
+      PendingReferences<AudioObject, AudioPackFormatId> objectPackFormatRefs_;
+      PendingReferences<AudioObject, AudioTrackUidId> objectTrackUidRefs_;
+      PendingReferences<AudioTrackUid, AudioTrackFormatId> trackUidTrackFormatRef_;
+      PendingReferences<AudioTrackUid, AudioChannelFormatId> trackUidChannelFormatRef_;
+      PendingReferences<AudioTrackUid, AudioPackFormatId> trackUidPackFormatRef_;
+      PendingReferences<AudioPackFormat, AudioChannelFormatId> packFormatChannelFormatRefs_;
+      PendingReferences<AudioPackFormat, AudioPackFormatId> packFormatPackFormatRefs_;
+      PendingReferences<AudioTrackFormat, AudioStreamFormatId> trackFormatStreamFormatRef_;
+      PendingReferences<AudioStreamFormat, AudioChannelFormatId> streamFormatChannelFormatRef_;
+      PendingReferences<AudioStreamFormat, AudioPackFormatId> streamFormatPackFormatRef_;
+      PendingReferences<AudioStreamFormat, AudioTrackFormatId> streamFormatTrackFormatRefs_;
       // clang-format on
 
+      /// IDs of references which could not be resolved, in the order found
+      std::vector<std::string> unresolvedIds_;
+      /// the same IDs as unresolvedIds_, to report each only once
+      std::unordered_set<std::string> unresolvedIdSet_;
+
       /// used to keep track of element IDs ourselves to avoid having it
       /// iterate through the whole document for each element and reference
       ::adm::detail::IDMap idMap_;
@@ -137,34 +206,40 @@ namespace adm {
       template <typename Element>
       void add(std::shared_ptr<Element> el);
 
-      template <typename Src, typename TargetId>
-      void resolveReferences(const std::map<Src, std::vector<TargetId>>& map) {
-        for (const auto& entry : map) {
-          for (const auto& id : entry.second) {
-            if (auto element = idMap_.lookup(id)) {
-              entry.first->addReference(std::move(element));
-            } else {
-              throw error::XmlParsingUnresolvedReference(formatId(id));
-            }
+      /// resolve each reference in refs, calling resolved(source, element)
+      /// for those which were found and recording the rest in unresolvedIds_
+      template <typename Src, typename TargetId, typename Callable>
+      void resolveEach(const PendingReferences<Src, TargetId>& refs,
+                       Callable resolved) {
+        for (const auto& ref : refs.entries()) {
+          if (auto element = idMap_.lookup(ref.id)) {
+            resolved(*ref.source, std::move(element));
+          } else {
+            unresolved(formatId(ref.id));
           }
         }
       }
 
-      void resolveTrackUidReferences(
-          const std::map<std::shared_ptr<AudioObject>,
-                         std::vector<AudioTrackUidId>>& map);
-
-      template <typename Src, typename Target>
-      void resolveReference(const std::map<Src, Target>& map) {
-        for (const auto& entry : map) {
-          const auto& id = entry.second;
-          if (auto element = idMap_.lookup(id)) {
-            entry.first->setReference(std::move(element));
-          } else {
-            throw error::XmlParsingUnresolvedReference(formatId(id));
-          }
-        }
+      /// resolve references which are added with addReference
+      template <typename Src, typename TargetId>
+      void resolveReferences(const PendingReferences<Src, TargetId>& refs) {
+        resolveEach(refs, [](Src& source, auto element) {
+          source.addReference(std::move(element));
+        });
+      }
+
+      /// resolve references which are set with setReference
+      template <typename Src, typename TargetId>
+      void resolveReference(const PendingReferences<Src, TargetId>& refs) {
+        resolveEach(refs, [](Src& source, auto element) {
+          source.setReference(std::move(element));
+        });
       }
+
+      void resolveTrackUidReferences(
+          const PendingReferences<AudioObject, AudioTrackUidId>& refs);
+      void unresolved(std::string id);
+
       void setCommonProperties(std::shared_ptr<AudioPackFormat> audioPackFormat,
                                NodePtr node);
     };
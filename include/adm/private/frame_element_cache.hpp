@@ -0,0 +1,120 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "adm/elements.hpp"
+#include "adm/serial/frame_header.hpp"
+#include "adm/private/rapidxml_wrapper.hpp"
+#include "adm/private/xml_stream_writer.hpp"
+
+namespace adm {
+  namespace xml {
+
+    /**
+     * @brief Formatted XML for elements, kept between S-ADM frames
+     *
+     * Elements are identified by their address, and are only taken from the
+     * cache while they are still alive, so a different element allocated at
+     * the same address is not mistaken for a cached one, and while their ID
+     * and contentHash() are unchanged; the ID is checked separately as it is
+     * not part of the hash. Elements listed as new, changed or extended in
+     * the changedIDs of a frame header are always formatted again, as are
+     * all elements after clear(). Entries for elements which were not
+     * written in a frame are dropped at the end of the frame.
+     */
+    class FrameElementCache {
+     public:
+      /// start writing a frame; elements will be added to children of
+      /// nodes in writer
+      void startFrame(XmlStreamWriter &writer, const FrameHeader &header);
+      /// finish writing a frame, dropping unused entries
+      void endFrame();
+      /// forget all formatted elements
+      void clear();
+
+      /// add element to the end of parent, which must be in the writer
+      /// passed to startFrame(), using cached XML if possible
+      template <typename Element, typename Callable>
+      void addElement(XmlNode &parent,
+                      const std::shared_ptr<const Element> &element,
+                      const std::string &name, Callable formatter);
+
+     private:
+      struct Entry {
+        std::weak_ptr<const void> element;
+        std::string xml;
+        /// the formatted ID of the element when it was formatted
+        std::string id;
+        std::uint64_t contentHash = 0;
+        /// the last frame this was written in, or 0 if it has not been
+        std::uint64_t frame = 0;
+      };
+
+      template <typename Element>
+      bool isChanged(const Element &element) const;
+      void setChanged(const ChangedIds &changedIds);
+
+      XmlStreamWriter *writer_ = nullptr;
+      XmlStreamWriter fragmentWriter_{0};
+      std::unordered_map<const void *, Entry> entries_;
+      std::uint64_t frame_ = 0;
+      /// the settings that the cached XML was formatted with
+      std::size_t indent_ = 0;
+      bool discardDefaults_ = true;
+
+      /// IDs listed as new, changed or extended in the current frame
+      std::tuple<std::vector<AudioProgrammeId>, std::vector<AudioContentId>,
+                 std::vector<AudioObjectId>, std::vector<AudioPackFormatId>,
+                 std::vector<AudioChannelFormatId>,
+                 std::vector<AudioStreamFormatId>,
+                 std::vector<AudioTrackFormatId>, std::vector<AudioTrackUidId>>
+          changed_;
+    };
+
+    template <typename Element>
+    bool FrameElementCache::isChanged(const Element &element) const {
+      using Id = typename Element::id_type;
+      auto &changed = std::get<std::vector<Id>>(changed_);
+      return std::find(changed.begin(), changed.end(),
+                       element.template get<Id>()) != changed.end();
+    }
+
+    template <typename Element, typename Callable>
+    void FrameElementCache::addElement(
+        XmlNode &parent, const std::shared_ptr<const Element> &element,
+        const std::string &name, Callable formatter) {
+      std::size_t indent = writer_->childIndent(parent.id());
+      if (indent != indent_ || writer_->discardDefaults() != discardDefaults_) {
+        clear();
+        indent_ = indent;
+        discardDefaults_ = writer_->discardDefaults();
+      }
+
+      using Id = typename Element::id_type;
+      Entry &entry = entries_[element.get()];
+      std::uint64_t contentHash = element->contentHash();
+      std::string id = formatId(element->template get<Id>());
+      bool cached = entry.frame != 0 && entry.contentHash == contentHash &&
+                    entry.id == id && !isChanged(*element) &&
+                    entry.element.lock() == element;
+      if (!cached) {
+        fragmentWriter_.reset(indent);
+        fragmentWriter_.setDiscardDefaults(discardDefaults_);
+        auto node = fragmentWriter_.addNode(name);
+        formatter(node, element);
+        fragmentWriter_.finish();
+        entry.element = element;
+        entry.contentHash = contentHash;
+        entry.id = std::move(id);
+        entry.xml.assign(fragmentWriter_.fragment());
+      }
+      entry.frame = frame_;
+      writer_->addFragment(parent.id(), entry.xml);
+    }
+
+  }  // namespace xml
+}  // namespace adm
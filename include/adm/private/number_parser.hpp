@@ -0,0 +1,88 @@
+#pragma once
+#include <cstring>
+#include <system_error>
+#include "adm/export.h"
+
+namespace adm {
+  namespace xml {
+    namespace detail {
+
+      /// result of parseNumber, as for std::from_chars
+      struct ParseNumberResult {
+        /// pointer to the first character which was not parsed
+        const char* ptr;
+        /// std::errc() if successful, std::errc::invalid_argument if there is
+        /// no number at the start of the input, or
+        /// std::errc::result_out_of_range if it does not fit in the result
+        /// (including non-zero floating point numbers too small to be
+        /// represented as normal numbers)
+        std::errc ec;
+      };
+
+      /**
+       * @brief Parse a number from the start of [first, last)
+       *
+       * These behave like std::from_chars (which is not available in C++14),
+       * except that a leading '+' is accepted. They don't depend on the
+       * current locale, and do not allocate memory except in rare cases (for
+       * floating point numbers with more than 19 significant digits or large
+       * exponents).
+       *
+       * Floating point numbers are decimal, with an optional exponent, or
+       * case-insensitive "inf", "infinity" or "nan". Integers are decimal.
+       * On error, value is not modified.
+       * @{
+       */
+      ADM_EXPORT ParseNumberResult parseNumber(const char* first,
+                                               const char* last,
+                                               double& value);
+      ADM_EXPORT ParseNumberResult parseNumber(const char* first,
+                                               const char* last,
+                                               float& value);
+      ADM_EXPORT ParseNumberResult parseNumber(const char* first,
+                                               const char* last,
+                                               int& value);
+      ADM_EXPORT ParseNumberResult parseNumber(const char* first,
+                                               const char* last,
+                                               unsigned int& value);
+      /** @} */
+
+      /// throw the exception for a failed parseNumber call on [first, last)
+      [[noreturn]] ADM_EXPORT void throwNumberError(const char* first,
+                                                    const char* last,
+                                                    ParseNumberResult result);
+
+      /**
+       * @brief Parse the whole of [first, last) as a number
+       *
+       * Surrounding whitespace is ignored. Throws std::invalid_argument if
+       * the input is not a number, and std::out_of_range if the number does
+       * not fit in T.
+       */
+      template <typename T>
+      T parseNumber(const char* first, const char* last) {
+        auto isSpace = [](char c) {
+          return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        };
+        const char* begin = first;
+        const char* end = last;
+        while (begin != end && isSpace(*begin)) ++begin;
+        while (end != begin && isSpace(end[-1])) --end;
+
+        T value{};
+        auto result = parseNumber(begin, end, value);
+        if (result.ec == std::errc() && result.ptr != end)
+          result.ec = std::errc::invalid_argument;
+        if (result.ec != std::errc()) throwNumberError(first, last, result);
+        return value;
+      }
+
+      /// parse the whole of a null-terminated string as a number
+      template <typename T>
+      T parseNumber(const char* str) {
+        return parseNumber<T>(str, str + std::strlen(str));
+      }
+
+    }  // namespace detail
+  }  // namespace xml
+}  // namespace adm
@@ -0,0 +1,54 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace adm {
+  namespace detail {
+
+    /**
+     * @brief Call f(i) for each i in [0, count) on a pool of threads
+     *
+     * One thread is used per hardware thread, including the calling thread;
+     * if some threads can't be started, the work is shared between the rest.
+     * Once all calls have finished, the exception thrown by the call with
+     * the lowest i (if any) is rethrown, so the result does not depend on
+     * the order in which the calls ran.
+     */
+    template <typename F>
+    void parallelFor(std::size_t count, F f) {
+      std::vector<std::exception_ptr> errors(count);
+      std::atomic<std::size_t> next{0};
+      auto worker = [&]() {
+        for (std::size_t i = next++; i < count; i = next++) {
+          try {
+            f(i);
+          } catch (...) {
+            errors[i] = std::current_exception();
+          }
+        }
+      };
+
+      std::size_t threadCount = std::min<std::size_t>(
+          std::max(std::thread::hardware_concurrency(), 1u), count);
+      std::vector<std::thread> threads;
+      try {
+        // this thread is one of the workers
+        for (std::size_t i = 1; i < threadCount; i++)
+          threads.emplace_back(worker);
+      } catch (const std::system_error&) {
+        // carry on with the threads which could be started
+      }
+      worker();
+      for (auto& thread : threads) thread.join();
+
+      for (auto& error : errors)
+        if (error) std::rethrow_exception(error);
+    }
+
+  }  // namespace detail
+}  // namespace adm
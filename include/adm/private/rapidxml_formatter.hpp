@@ -5,6 +5,7 @@
 #include "adm/serial/frame_format_id.hpp"
 #include "adm/serial/transport_track_format.hpp"
 
+#include <chrono>
 #include <string>
 
 namespace adm {
@@ -45,6 +46,23 @@ namespace adm {
         XmlNode &node,
         const std::shared_ptr<const AudioChannelFormat> channelFormat,
         TimeReference timeReference);
+
+    /// a range of times [start, end) in the same time base as block rtimes
+    struct BlockTimeWindow {
+      std::chrono::nanoseconds start;
+      std::chrono::nanoseconds end;
+    };
+
+    /// format a channel format, writing only the blocks which overlap window
+    void formatAudioChannelFormat(
+        XmlNode &node,
+        const std::shared_ptr<const AudioChannelFormat> channelFormat,
+        TimeReference timeReference, const BlockTimeWindow &window);
+    /// format the attributes and sub-elements of a channel format other
+    /// than its blocks
+    void formatAudioChannelFormatParameters(
+        XmlNode &node,
+        const std::shared_ptr<const AudioChannelFormat> channelFormat);
     void formatAudioStreamFormat(
         XmlNode &node,
         const std::shared_ptr<const AudioStreamFormat> streamFormat);
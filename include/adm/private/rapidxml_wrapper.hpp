@@ -8,6 +8,7 @@
 #include "adm/utilities/id_assignment.hpp"
 #include "adm/private/rapidxml_formatter.hpp"
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -18,29 +19,79 @@ namespace adm {
 
     class XmlNode;
 
-    class XmlDocument {
+    /**
+     * @brief Destination for the XML produced through XmlNode
+     *
+     * The formatters in rapidxml_formatter.hpp describe the XML to write
+     * through XmlNode, which forwards the primitive operations (adding
+     * elements and attributes, and setting values) to a sink. XmlDocument
+     * builds a rapidxml DOM from these, while XmlStreamWriter writes them
+     * straight to a stream.
+     *
+     * Elements are identified by a sink-specific NodeId.
+     */
+    class XmlSink {
      public:
-      XmlDocument() = default;
+      using NodeId = std::uintptr_t;
+
+      virtual ~XmlSink() = default;
+
+      /// add the XML declaration; this must be the first node added
+      virtual void addDeclaration() = 0;
+      /// add an element called name to the end of parent
+      virtual NodeId addNode(NodeId parent, const std::string &name) = 0;
+      /// add an attribute to node
+      virtual void addAttribute(NodeId node, const std::string &name,
+                                const std::string &value) = 0;
+      /// set the text value of node
+      virtual void setValue(NodeId node, const std::string &value) = 0;
+
+      /// add a top-level element
       XmlNode addNode(const std::string &name);
 
-      XmlNode addDeclaration();
       XmlNode addItuStructure();
       XmlNode addCoreMetadataAudioFormatExtended(XmlNode &parent) const;
       XmlNode addEbuStructure();
 
       void setDiscardDefaults(bool value) { discardDefaultValues_ = value; }
+      bool discardDefaults() const { return discardDefaultValues_; }
+
+     protected:
+      /// the id of the document itself, which top-level elements are added to
+      virtual NodeId rootId() const = 0;
+
+     private:
+      bool discardDefaultValues_ = false;
+    };
+
+    /// sink which builds a rapidxml DOM, which can then be printed
+    class XmlDocument : public XmlSink {
+     public:
+      XmlDocument() = default;
+
+      void addDeclaration() override;
+      NodeId addNode(NodeId parent, const std::string &name) override;
+      void addAttribute(NodeId node, const std::string &name,
+                        const std::string &value) override;
+      void setValue(NodeId node, const std::string &value) override;
+
+      using XmlSink::addNode;
+
+     protected:
+      NodeId rootId() const override;
 
      private:
       friend std::ostream &operator<<(std::ostream &os, XmlDocument const &doc);
 
+      static NodePtr toNode(NodeId id) { return reinterpret_cast<NodePtr>(id); }
+
       rapidxml::xml_document<> doc_;
-      bool discardDefaultValues_ = false;
     };
 
     class XmlNode {
      public:
       XmlNode() = default;
-      XmlNode(NodePtr node, bool discardDefaults);
+      XmlNode(XmlSink *sink, XmlSink::NodeId node, bool discardDefaults);
 
       // --- GENERAL ---- //
       XmlNode addNode(const std::string &name);
@@ -115,8 +166,14 @@ namespace adm {
           const std::shared_ptr<const AudioStreamFormat> &src,
           const std::string &name);
 
+      /// the sink that this node is part of
+      XmlSink *sink() const { return sink_; }
+      /// the id of this node within sink()
+      XmlSink::NodeId id() const { return node_; }
+
      private:
-      NodePtr node_;
+      XmlSink *sink_ = nullptr;
+      XmlSink::NodeId node_ = 0;
       bool discardDefaultValues_ = true;
     };
 
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace adm {
+  namespace xml {
+
+    /**
+     * @brief Input text for the rapidxml parser
+     *
+     * rapidxml parses in place, so this holds a writable, null-terminated
+     * copy of the input. When memory-mapping a file, the copy is a private
+     * mapping of the file, so no data is read or allocated up front; pages
+     * are only copied by the operating system when the parser writes to
+     * them.
+     */
+    class XmlInput {
+     public:
+      XmlInput() = default;
+      XmlInput(XmlInput&& other) noexcept;
+      XmlInput& operator=(XmlInput&& other) noexcept;
+      XmlInput(const XmlInput&) = delete;
+      XmlInput& operator=(const XmlInput&) = delete;
+      ~XmlInput();
+
+      /// read the whole of a file into memory
+      static XmlInput readFile(const std::string& filename);
+      /// map a file into memory if supported on this platform, falling back
+      /// to readFile() if not (or if the file can not be mapped)
+      static XmlInput mapFile(const std::string& filename);
+      /// read the rest of a stream into memory
+      static XmlInput readStream(std::istream& stream);
+      /// copy a buffer
+      static XmlInput copyBuffer(const char* data, std::size_t size);
+
+      /// the null-terminated input
+      char* data();
+      /// the size of the input, excluding the terminator
+      std::size_t size() const { return size_; }
+      /// was the input memory-mapped?
+      bool isMapped() const { return mapping_ != nullptr; }
+
+     private:
+      void release();
+
+      std::vector<char> buffer_;
+      void* mapping_ = nullptr;
+      std::size_t mappingSize_ = 0;
+      std::size_t size_ = 0;
+    };
+
+    /// read-only stream over a caller-provided buffer, which is not copied
+    class MemoryInputStream : public std::istream {
+     public:
+      MemoryInputStream(const char* data, std::size_t size);
+
+     private:
+      class Buffer : public std::streambuf {
+       public:
+        Buffer(const char* data, std::size_t size);
+      };
+
+      Buffer buffer_;
+    };
+
+  }  // namespace xml
+}  // namespace adm
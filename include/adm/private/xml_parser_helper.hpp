@@ -9,6 +9,7 @@
 #include "adm/document.hpp"
 #include "adm/elements/format_descriptor.hpp"
 #include "adm/elements/type_descriptor.hpp"
+#include "adm/private/number_parser.hpp"
 #include "adm/private/rapidxml_utils.hpp"
 #include "rapidxml/rapidxml.hpp"
 
@@ -88,31 +89,30 @@ namespace adm {
       template <typename T>
       struct TypeTag {};
 
-      inline int parseImpl(const std::string& v, TypeTag<int>) {
-        return std::stoi(v);
+      inline int parseImpl(const char* v, TypeTag<int>) {
+        return parseNumber<int>(v);
       }
-      inline unsigned int parseImpl(const std::string& v,
-                                    TypeTag<unsigned int>) {
-        return std::stoul(v);
+      inline unsigned int parseImpl(const char* v, TypeTag<unsigned int>) {
+        return parseNumber<unsigned int>(v);
       }
-      inline std::string parseImpl(std::string v, TypeTag<std::string>) {
+      inline std::string parseImpl(const char* v, TypeTag<std::string>) {
         return v;
       }
-      inline float parseImpl(const std::string& v, TypeTag<float>) {
-        return std::stof(v);
+      inline float parseImpl(const char* v, TypeTag<float>) {
+        return parseNumber<float>(v);
       }
-      inline double parseImpl(const std::string& v, TypeTag<double>) {
-        return std::stod(v);
+      inline double parseImpl(const char* v, TypeTag<double>) {
+        return parseNumber<double>(v);
       }
-      inline bool parseImpl(const std::string& v, TypeTag<bool>) {
-        return std::stoi(v) != 0;
+      inline bool parseImpl(const char* v, TypeTag<bool>) {
+        return parseNumber<int>(v) != 0;
       }
 
       template <typename NT>
-      NT parseDefault(std::string v) {
+      NT parseDefault(const char* v) {
         typedef typename NT::value_type value_type;
         typedef TypeTag<value_type> DispatchTypeTag;
-        return NT(parseImpl(std::move(v), DispatchTypeTag()));
+        return NT(parseImpl(v, DispatchTypeTag()));
       }
     }  // namespace detail
 
@@ -287,7 +287,7 @@ namespace adm {
                                const Src src, Target& target, Callable parser) {
       auto elements = detail::findElements(node, elementName);
       for (auto& elementNode : elements) {
-        target[src].push_back(NT(parser(elementNode->value())));
+        target.add(src, NT(parser(elementNode->value())));
       }
     }
 
@@ -296,7 +296,7 @@ namespace adm {
                               const Src src, Target& target, Callable parser) {
       auto elementNode = detail::findElement(node, elementName);
       if (elementNode) {
-        target[src] = NT(parser(elementNode->value()));
+        target.add(src, NT(parser(elementNode->value())));
       }
     }
 
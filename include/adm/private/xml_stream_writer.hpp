@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "adm/private/rapidxml_wrapper.hpp"
+
+namespace adm {
+  namespace xml {
+
+    /**
+     * @brief Sink which writes XML directly to a stream
+     *
+     * This produces exactly the same output as printing an XmlDocument built
+     * with the same calls, without holding the whole document in memory.
+     *
+     * Elements are written as soon as they are complete, which is when an
+     * element is added to one of their ancestors, or on finish(). This means
+     * that attributes must be added to an element before any of its
+     * children; std::logic_error is thrown if not. Values are held until the
+     * element is complete, so may be set at any time.
+     *
+     * A writer can also produce a fragment in memory, which can be inserted
+     * into another writer with addFragment(); this allows parts of a
+     * document to be written on separate threads.
+     */
+    class XmlStreamWriter : public XmlSink {
+     public:
+      explicit XmlStreamWriter(std::ostream &stream);
+      /// write a fragment into memory, to be inserted into another writer
+      /// where elements are indented by indent tabs; see childIndent()
+      explicit XmlStreamWriter(std::size_t indent);
+
+      void addDeclaration() override;
+      NodeId addNode(NodeId parent, const std::string &name) override;
+      void addAttribute(NodeId node, const std::string &name,
+                        const std::string &value) override;
+      void setValue(NodeId node, const std::string &value) override;
+
+      using XmlSink::addNode;
+
+      /// complete all open elements and write any buffered output
+      void finish();
+
+      /// start writing a new document to stream, keeping allocated buffers
+      void reset(std::ostream &stream);
+      /// start writing a new fragment, keeping allocated buffers
+      void reset(std::size_t indent);
+
+      /// after finish(), get the output of a fragment writer
+      std::string takeFragment();
+      /// after finish(), the output of a fragment writer, which remains
+      /// valid until the writer is used again
+      const std::string &fragment() const { return buffer_; }
+      /// the indent of children of parent, for making fragments
+      std::size_t childIndent(NodeId parent);
+      /// add the output of a fragment writer to the end of parent
+      void addFragment(NodeId parent, const std::string &fragment);
+
+     protected:
+      NodeId rootId() const override { return 0; }
+
+     private:
+      /// an element which has been started but not finished; open_[0] is
+      /// the document
+      struct OpenElement {
+        NodeId id;
+        std::string name;
+        std::string value;
+        /// have any children been added? If not, the start tag has not
+        /// been closed, so attributes can still be added
+        bool hasChildren;
+      };
+
+      void reset(std::ostream *stream, std::size_t indent);
+      /// prepare for a child to be added to the end of parent
+      void startChild(NodeId parent);
+      /// finish elements until node is the innermost open element
+      void closeTo(NodeId node);
+      /// finish the innermost open element
+      void closeElement();
+      /// find an open element, throwing if it has been finished
+      OpenElement &findOpen(NodeId node);
+
+      void writeIndent(std::size_t depth);
+      void writeName(const std::string &name);
+      void writeEscaped(const char *str, char noExpand);
+      void flushIfFull();
+      void flush();
+
+      /// nullptr when writing a fragment
+      std::ostream *stream_ = nullptr;
+      std::size_t indent_ = 0;
+      std::string buffer_;
+      /// open_[0, depth_) are open; later entries are kept to reuse their
+      /// string storage
+      std::vector<OpenElement> open_;
+      std::size_t depth_ = 0;
+      NodeId nextId_ = 1;
+    };
+
+  }  // namespace xml
+}  // namespace adm
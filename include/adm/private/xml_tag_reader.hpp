@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace adm {
+  namespace xml {
+
+    /**
+     * @brief Incremental reader for the tags in an XML document
+     *
+     * This reads a stream one tag at a time, skipping over text, comments,
+     * processing instructions, CDATA sections and the document type
+     * declaration. Only the part of the input which has not been consumed
+     * yet (plus the current tag or captured element) is held in memory.
+     *
+     * The input is not checked for well-formedness beyond what is needed to
+     * find the tags; captured elements should be passed to a real XML parser.
+     */
+    class XmlTagReader {
+     public:
+      enum class TagType {
+        start,  ///< `<name ...>`
+        end,    ///< `</name>`
+        empty   ///< `<name .../>`
+      };
+
+      explicit XmlTagReader(std::istream& stream,
+                            std::size_t chunkSize = 64 * 1024);
+
+      /// read the next tag; returns false at the end of the input
+      bool next();
+
+      TagType type() const { return type_; }
+      const std::string& name() const { return name_; }
+
+      /// the text of the most recently read tag
+      std::string tag() const;
+
+      /**
+       * @brief Read the rest of the element started by the most recent tag
+       *
+       * The most recent tag must be a start or empty tag. Returns the text of
+       * the whole element, from the start of that tag to the end of the
+       * matching end tag; afterwards, the most recent tag is the end tag.
+       */
+      std::string captureElement();
+
+     private:
+      /// read another chunk of the input into buffer_, discarding the part
+      /// before keepFrom(); returns false at the end of the input
+      bool fill();
+      std::size_t keepFrom() const;
+
+      /// find str in buffer_ at or after from, reading more input as needed;
+      /// throws if the input ends first
+      std::size_t find(const char* str, std::size_t from);
+      /// find the '>' ending the start or end tag starting at from
+      std::size_t findTagEnd(std::size_t from);
+      /// make sure there are at least n characters after pos, if possible
+      void require(std::size_t pos, std::size_t n);
+      bool startsWith(std::size_t pos, const char* str);
+
+      std::istream& stream_;
+      std::size_t chunkSize_;
+      std::string buffer_;
+      /// position in buffer_ after the most recent tag
+      std::size_t pos_ = 0;
+      /// start of the most recent tag in buffer_
+      std::size_t tagStart_ = 0;
+      /// start of the element being captured in buffer_
+      std::size_t captureStart_ = 0;
+      bool capturing_ = false;
+
+      TagType type_ = TagType::start;
+      std::string name_;
+    };
+
+  }  // namespace xml
+}  // namespace adm
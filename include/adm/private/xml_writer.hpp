@@ -1,29 +1,93 @@
 #pragma once
 #include "adm/write.hpp"
+#include "adm/export.h"
+#include "adm/private/frame_element_cache.hpp"
+#include "adm/private/xml_stream_writer.hpp"
 
 namespace adm {
   class Document;
+  class FrameView;
   namespace xml {
 
+    class XmlSink;
+
+    /// settings for writing the part of a document in one S-ADM frame
+    struct FrameSettings {
+      /// only blocks overlapping this are written
+      BlockTimeWindow window;
+      /// if not null, the source of the XML for elements other than
+      /// channel formats
+      FrameElementCache* cache;
+    };
+
+    /// how XmlWriter and SadmXmlWriter produce their output; both give
+    /// exactly the same result
+    enum class XmlWriterBackend {
+      /// write XML to the stream as the document is traversed
+      stream,
+      /// build a rapidxml DOM of the whole document, then print it
+      dom,
+    };
+
     class XmlWriter {
      public:
-      explicit XmlWriter(WriterOptions options = WriterOptions::none);
+      ADM_EXPORT explicit XmlWriter(
+          WriterOptions options = WriterOptions::none,
+          XmlWriterBackend backend = XmlWriterBackend::stream);
 
-      std::ostream& write(std::shared_ptr<const Document> document,
-                          std::ostream& stream);
+      ADM_EXPORT std::ostream& write(std::shared_ptr<const Document> document,
+                                     std::ostream& stream);
 
      private:
+      void write(XmlSink& sink, std::shared_ptr<const Document> document);
+
       WriterOptions options_;
+      XmlWriterBackend backend_;
     };
 
     class SadmXmlWriter {
      public:
-      SadmXmlWriter(SadmWriterOptions options = SadmWriterOptions::none);
+      ADM_EXPORT SadmXmlWriter(
+          SadmWriterOptions options = SadmWriterOptions::none,
+          XmlWriterBackend backend = XmlWriterBackend::stream);
+      ADM_EXPORT std::ostream& write(std::shared_ptr<const Document> document,
+                                     FrameHeader const& header,
+                                     std::ostream& stream);
+      /// write only the blocks in frameView
+      ADM_EXPORT std::ostream& write(const FrameView& frameView,
+                                     FrameHeader const& header,
+                                     std::ostream& stream);
+
+     private:
+      std::ostream& write(std::shared_ptr<const Document> document,
+                          FrameHeader const& header, std::ostream& stream,
+                          FrameSettings* frame);
+      void write(XmlSink& sink, std::shared_ptr<const Document> document,
+                 FrameHeader const& header, FrameSettings* frame);
+
+      SadmWriterOptions options_;
+      XmlWriterBackend backend_;
+    };
+
+    /**
+     * @brief Writer for a sequence of S-ADM frames, which keeps its buffers
+     * and the XML of unchanged elements between frames
+     *
+     * Only the blocks which overlap each frame are written.
+     */
+    class SadmFrameXmlWriter {
+     public:
+      explicit SadmFrameXmlWriter(SadmWriterOptions options);
+
       std::ostream& write(std::shared_ptr<const Document> document,
                           FrameHeader const& header, std::ostream& stream);
 
+      void clearCache() { cache_.clear(); }
+
      private:
       SadmWriterOptions options_;
+      XmlStreamWriter writer_{0};
+      FrameElementCache cache_;
     };
 
   }  // namespace xml
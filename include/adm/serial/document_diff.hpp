@@ -0,0 +1,37 @@
+/// @file document_diff.hpp
+#pragma once
+#include <memory>
+#include "adm/document.hpp"
+#include "adm/export.h"
+#include "adm/serial/changed_ids.hpp"
+
+namespace adm {
+
+  /**
+   * @brief Find the changedIDs between two documents
+   *
+   * This is intended for filling in the ChangedIds of the FrameFormat of an
+   * S-ADM frame, given the document for the previous frame and the document
+   * for this one. Elements are matched by ID, and are:
+   *
+   * - NEW if they are only in current,
+   * - EXPIRED if they are only in previous,
+   * - CHANGED if their content differs, or
+   * - EXTENDED if they are audioChannelFormats with new audioBlockFormats
+   *   after the last one in previous, and no other changes.
+   *
+   * Element content is compared using contentHash(), which includes
+   * references to other elements by ID. audioBlockFormats are matched by the
+   * counter in their IDs; blocks in previous which are not in current are
+   * not a change, as a frame only contains the blocks which overlap it.
+   *
+   * Elements with common definitions IDs are not compared. The run time is
+   * linear in the size of the documents.
+   *
+   * @ingroup sadm
+   */
+  ADM_EXPORT ChangedIds diffDocuments(
+      std::shared_ptr<const Document> previous,
+      std::shared_ptr<const Document> current);
+
+}  // namespace adm
@@ -31,6 +31,8 @@ namespace adm {
   namespace xml {
     using NodePtr = rapidxml::xml_node<>*;
 
+    class XmlInput;
+
     class FrameHeaderParser {
      public:
       explicit FrameHeaderParser(const std::string& filename,
@@ -39,11 +41,16 @@ namespace adm {
       explicit FrameHeaderParser(std::istream& stream,
                                  ParserOptions options = ParserOptions::none);
 
+      /// parse from a buffer, which must remain valid until parse() returns
+      FrameHeaderParser(const char* data, std::size_t size,
+                        ParserOptions options = ParserOptions::none);
+
+      ~FrameHeaderParser();
+
       FrameHeader parse();
 
      private:
-      explicit FrameHeaderParser(rapidxml::file<> file,
-                                 ParserOptions options = ParserOptions::none);
+      FrameHeaderParser(XmlInput input, ParserOptions options);
       /// add an element to both the document and idMap_
       template <typename Element>
       void add(std::shared_ptr<Element> el);
@@ -51,7 +58,7 @@ namespace adm {
       NodePtr findFrameNode(NodePtr root);
       FrameHeader parseFrameHeader(NodePtr node);
 
-      rapidxml::file<> file;
+      std::unique_ptr<XmlInput> input;
       ParserOptions options;
     };
 
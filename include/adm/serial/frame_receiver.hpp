@@ -0,0 +1,85 @@
+/// @file frame_receiver.hpp
+#pragma once
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include "adm/document.hpp"
+#include "adm/export.h"
+#include "adm/parse.hpp"
+#include "adm/serial/frame_header.hpp"
+
+namespace adm {
+
+  /**
+   * @brief Receiver for a sequence of S-ADM frames
+   *
+   * This keeps a live Document which is updated with each frame, rather
+   * than treating each frame as a separate document. The first frame is
+   * used as it is; for each following frame:
+   *
+   * - Elements whose IDs are listed as EXPIRED in the frame header's
+   *   ChangedIds are removed.
+   * - Elements which are not in the live document yet are copied into it.
+   * - Elements which are listed as NEW, CHANGED or (for elements other
+   *   than audioChannelFormats) EXTENDED replace the element with the same
+   *   ID. References to the replaced element from the rest of the document
+   *   are kept, in the same order.
+   * - For other audioChannelFormats, audioBlockFormats with a higher counter
+   *   than the last block in the live document are appended. A
+   *   CHANGED audioChannelFormat keeps the blocks before the first block in
+   *   the frame. If the counters of the new blocks do not follow on from
+   *   those in the live document (for example because a frame was missed),
+   *   the blocks are replaced with the blocks from the frame.
+   * - Everything else is left alone, so is not copied or compared.
+   *
+   * The cost of a frame is therefore proportional to the number of elements
+   * in it plus the number of elements and blocks which changed, except that
+   * replacing or removing an element looks for references to it in the
+   * whole live document.
+   *
+   * Block times are used as they are in the frames, so this is intended for
+   * frames with TimeReference::TOTAL. Replaced elements are moved to the end
+   * of the lists returned by Document::getElements().
+   *
+   * @code
+   * SadmFrameReceiver receiver;
+   * while (readFrame(stream)) {
+   *   auto header = receiver.receive(stream);
+   *   render(receiver.getDocument(), header);
+   * }
+   * @endcode
+   *
+   * @ingroup sadm
+   */
+  class SadmFrameReceiver {
+   public:
+    ADM_EXPORT explicit SadmFrameReceiver(
+        xml::ParserOptions options = xml::ParserOptions::none);
+
+    /// parse one frame from stream and apply it, returning its header
+    ADM_EXPORT FrameHeader receive(std::istream& stream);
+
+    /// parse one frame from a buffer, which does not need to be
+    /// null-terminated, and apply it, returning its header
+    ADM_EXPORT FrameHeader receive(const char* data, std::size_t size);
+
+    /// apply a frame which has already been parsed; frame is not modified
+    ADM_EXPORT void apply(std::shared_ptr<const Document> frame,
+                          const FrameHeader& header);
+
+    /// the live document, or nullptr if no frame has been received
+    std::shared_ptr<Document> getDocument() const { return document_; }
+
+    /// forget the live document, so that the next frame is used as it is
+    ADM_EXPORT void reset();
+
+   private:
+    void merge(const Document& frame, const FrameHeader& header);
+
+    xml::ParserOptions options_;
+    std::shared_ptr<Document> document_;
+    /// frame data read from a stream, kept to avoid reallocating
+    std::string buffer_;
+  };
+}  // namespace adm
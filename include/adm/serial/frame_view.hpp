@@ -0,0 +1,66 @@
+/// @file frame_view.hpp
+#pragma once
+#include <memory>
+#include "adm/document.hpp"
+#include "adm/elements/audio_channel_format.hpp"
+#include "adm/elements/time.hpp"
+#include "adm/export.h"
+#include "adm/serial/frame_header.hpp"
+
+namespace adm {
+
+  /**
+   * @brief The part of a document which overlaps an S-ADM frame
+   *
+   * This shares all elements with the source document, and limits only
+   * the audioBlockFormats to those which overlap the frame. These are found
+   * with AudioChannelFormat::getElementsInWindow(), so getting the blocks of
+   * a channel takes O(log n) time, rather than copying the document and
+   * removing the blocks outside the frame.
+   *
+   * The document must not be modified while the view is in use.
+   *
+   * @ingroup sadm
+   */
+  class FrameView {
+   public:
+    /**
+     * @brief View of the part of document which overlaps the frame
+     * described by header
+     *
+     * With TimeReference::TOTAL the window is
+     * `[start, start + duration)` of the header's FrameFormat. With
+     * TimeReference::LOCAL block times are relative to the start of the
+     * frame, so the window is `[0, duration)`.
+     */
+    ADM_EXPORT FrameView(std::shared_ptr<const Document> document,
+                         const FrameHeader& header);
+
+    /// View of the blocks in document which overlap `[start, end)`
+    ADM_EXPORT FrameView(std::shared_ptr<const Document> document, Time start,
+                         Time end);
+
+    /// the source document
+    const std::shared_ptr<const Document>& getDocument() const {
+      return document_;
+    }
+    /// start of the window, in the time base of block rtimes
+    const Time& getStart() const { return start_; }
+    /// end of the window, in the time base of block rtimes
+    const Time& getEnd() const { return end_; }
+
+    /// the blocks of channelFormat which overlap the frame
+    template <typename AudioBlockFormat>
+    BlockFormatsConstRange<AudioBlockFormat> getBlocks(
+        const AudioChannelFormat& channelFormat) const {
+      return channelFormat.getElementsInWindow<AudioBlockFormat>(start_,
+                                                                 end_);
+    }
+
+   private:
+    std::shared_ptr<const Document> document_;
+    Time start_;
+    Time end_;
+  };
+
+}  // namespace adm
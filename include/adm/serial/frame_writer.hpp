@@ -0,0 +1,58 @@
+/// @file frame_writer.hpp
+#pragma once
+#include <iosfwd>
+#include <memory>
+#include "adm/document.hpp"
+#include "adm/export.h"
+#include "adm/write.hpp"
+#include "adm/serial/frame_header.hpp"
+
+namespace adm {
+  namespace xml {
+    class SadmFrameXmlWriter;
+  }
+
+  /**
+   * @brief Writer for a sequence of S-ADM frames
+   *
+   * This writes the same XML as
+   * `writeXml(std::ostream&, std::shared_ptr<const Document>, const FrameHeader&, xml::SadmWriterOptions)`,
+   * except that only the audioBlockFormats which overlap the frame (given by
+   * the Start and Duration of the header's FrameFormat) are written. With
+   * TimeReference::TOTAL, block times are compared with the frame start;
+   * with TimeReference::LOCAL they are relative to it.
+   *
+   * The writer keeps its output buffers between frames, along with the XML
+   * of each element other than audioChannelFormats, which is reused while
+   * the same element is in the document and its ID and contentHash() are
+   * unchanged, so elements can be modified (or given new IDs) between frames
+   * without calling clearCache().
+   * An element is also formatted again if its ID is listed as new, changed
+   * or extended in the frame header's ChangedIds.
+   *
+   * @code
+   * SadmFrameWriter writer;
+   * for (auto& header : frameHeaders)
+   *   writer.write(document, header, stream);
+   * @endcode
+   *
+   * @ingroup sadm
+   */
+  class SadmFrameWriter {
+   public:
+    ADM_EXPORT explicit SadmFrameWriter(
+        xml::SadmWriterOptions options = xml::SadmWriterOptions::none);
+    ADM_EXPORT ~SadmFrameWriter();
+
+    /// write one frame containing the parts of document that overlap it
+    ADM_EXPORT std::ostream& write(std::shared_ptr<const Document> document,
+                                   const FrameHeader& header,
+                                   std::ostream& stream);
+
+    /// forget the XML of all elements, so they are all formatted again
+    ADM_EXPORT void clearCache();
+
+   private:
+    std::unique_ptr<xml::SadmFrameXmlWriter> writer_;
+  };
+}  // namespace adm
@@ -0,0 +1,189 @@
+/// @file block_format_columns.hpp
+#pragma once
+
+#include <boost/optional.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "adm/elements/audio_block_format_objects.hpp"
+#include "adm/elements/audio_channel_format.hpp"
+#include "adm/export.h"
+
+namespace adm {
+
+  /**
+   * @brief Compact, read-only store of a sequence of AudioBlockFormatObjects
+   * @headerfile block_format_columns.hpp <adm/utilities/block_format_columns.hpp>
+   *
+   * The parameters needed to render most blocks (rtime, duration, position
+   * and gain) are stored column by column in dense arrays, so that reading
+   * them for many blocks touches much less memory than iterating over the
+   * blocks in an AudioChannelFormat.
+   *
+   * Blocks which have any other parameters (for example width, channelLock,
+   * jumpPosition or a screenEdgeLock), fractional times or a gain in dB are
+   * also stored whole in a sparse side table, so that every block can be
+   * converted back exactly; the dense columns are filled in for these
+   * blocks too.
+   *
+   * @code
+     AudioBlockFormatObjectsColumns columns(
+         channelFormat->getElements<AudioBlockFormatObjects>());
+     for (auto block : columns)
+       render(block.rtime(), block.azimuthOrX(), block.gain());
+     @endcode
+   */
+  class AudioBlockFormatObjectsColumns {
+   public:
+    /// read-only view of one block
+    class BlockView {
+     public:
+      BlockView(const AudioBlockFormatObjectsColumns &columns,
+                std::size_t index)
+          : columns_(&columns), index_(index) {}
+
+      std::size_t index() const { return index_; }
+
+      const AudioBlockFormatId &id() const { return columns_->ids_[index_]; }
+      std::chrono::nanoseconds rtime() const {
+        return columns_->rtimes_[index_];
+      }
+      /// the duration, or boost::none if the block has none
+      boost::optional<std::chrono::nanoseconds> duration() const {
+        if (!(flags() & HAS_DURATION)) return boost::none;
+        return columns_->durations_[index_];
+      }
+
+      /// true if the position is a CartesianPosition
+      bool isCartesian() const { return flags() & CARTESIAN; }
+      /// azimuth of a SphericalPosition, or X of a CartesianPosition
+      float azimuthOrX() const { return columns_->azimuthsOrX_[index_]; }
+      /// elevation of a SphericalPosition, or Y of a CartesianPosition
+      float elevationOrY() const { return columns_->elevationsOrY_[index_]; }
+      /// distance of a SphericalPosition, or Z of a CartesianPosition;
+      /// defaults are filled in
+      float distanceOrZ() const { return columns_->distancesOrZ_[index_]; }
+
+      /// linear gain; 1 if the block has no gain
+      double gain() const { return columns_->gains_[index_]; }
+
+      /// true if the block has parameters which are not stored in the
+      /// dense columns
+      bool hasOtherParameters() const { return flags() & OTHER; }
+
+      /// convert back to an AudioBlockFormatObjects
+      ADM_EXPORT AudioBlockFormatObjects toBlockFormat() const;
+
+     private:
+      std::uint8_t flags() const { return columns_->flags_[index_]; }
+
+      const AudioBlockFormatObjectsColumns *columns_;
+      std::size_t index_;
+    };
+
+    /// iterator over BlockView values
+    class const_iterator {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = BlockView;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = BlockView;
+
+      const_iterator(const AudioBlockFormatObjectsColumns &columns,
+                     std::size_t index)
+          : columns_(&columns), index_(index) {}
+
+      BlockView operator*() const { return BlockView(*columns_, index_); }
+      const_iterator &operator++() {
+        ++index_;
+        return *this;
+      }
+      const_iterator operator++(int) {
+        auto old = *this;
+        ++index_;
+        return old;
+      }
+      bool operator==(const const_iterator &other) const {
+        return index_ == other.index_;
+      }
+      bool operator!=(const const_iterator &other) const {
+        return index_ != other.index_;
+      }
+
+     private:
+      const AudioBlockFormatObjectsColumns *columns_;
+      std::size_t index_;
+    };
+
+    AudioBlockFormatObjectsColumns() = default;
+
+    /// store the blocks in a range, for example from
+    /// AudioChannelFormat::getElements<AudioBlockFormatObjects>()
+    ADM_EXPORT explicit AudioBlockFormatObjectsColumns(
+        BlockFormatsConstRange<AudioBlockFormatObjects> blockFormats);
+    /// @copydoc AudioBlockFormatObjectsColumns(BlockFormatsConstRange<AudioBlockFormatObjects>)
+    ADM_EXPORT explicit AudioBlockFormatObjectsColumns(
+        BlockFormatsRange<AudioBlockFormatObjects> blockFormats);
+
+    ADM_EXPORT void reserve(std::size_t size);
+    /// add a block to the end
+    ADM_EXPORT void push_back(const AudioBlockFormatObjects &blockFormat);
+
+    std::size_t size() const { return ids_.size(); }
+    bool empty() const { return ids_.empty(); }
+
+    BlockView operator[](std::size_t index) const {
+      return BlockView(*this, index);
+    }
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, size()); }
+
+    /// convert all blocks back to AudioBlockFormatObjects
+    ADM_EXPORT std::vector<AudioBlockFormatObjects> toBlockFormats() const;
+
+    /** @name Dense columns
+     *
+     * One value per block, in the same order as the blocks.
+     */
+    ///@{
+    const std::vector<std::chrono::nanoseconds> &rtimes() const {
+      return rtimes_;
+    }
+    /// durations, or 0 for blocks without a duration
+    const std::vector<std::chrono::nanoseconds> &durations() const {
+      return durations_;
+    }
+    const std::vector<float> &azimuthsOrX() const { return azimuthsOrX_; }
+    const std::vector<float> &elevationsOrY() const { return elevationsOrY_; }
+    const std::vector<float> &distancesOrZ() const { return distancesOrZ_; }
+    const std::vector<double> &gains() const { return gains_; }
+    ///@}
+
+   private:
+    enum Flags : std::uint8_t {
+      HAS_DURATION = 1 << 0,
+      CARTESIAN = 1 << 1,
+      HAS_DISTANCE_OR_Z = 1 << 2,
+      HAS_GAIN = 1 << 3,
+      HAS_RTIME = 1 << 4,
+      /// stored whole in others_
+      OTHER = 1 << 5,
+    };
+
+    std::vector<AudioBlockFormatId> ids_;
+    std::vector<std::chrono::nanoseconds> rtimes_;
+    std::vector<std::chrono::nanoseconds> durations_;
+    std::vector<float> azimuthsOrX_;
+    std::vector<float> elevationsOrY_;
+    std::vector<float> distancesOrZ_;
+    std::vector<double> gains_;
+    std::vector<std::uint8_t> flags_;
+    /// blocks with OTHER set, with their index, in order
+    std::vector<std::pair<std::size_t, AudioBlockFormatObjects>> others_;
+  };
+
+}  // namespace adm
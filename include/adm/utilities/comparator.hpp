@@ -5,6 +5,17 @@
 
 namespace adm {
 
+  namespace detail {
+    /// compare times as with asNanoseconds(), but without the conversion in
+    /// the common case where both are already in nanoseconds
+    inline bool nanosecondsLess(const Time& lhs, const Time& rhs) {
+      auto lhsNs = boost::get<std::chrono::nanoseconds>(&lhs.asVariant());
+      auto rhsNs = boost::get<std::chrono::nanoseconds>(&rhs.asVariant());
+      if (lhsNs && rhsNs) return *lhsNs < *rhsNs;
+      return lhs.asNanoseconds() < rhs.asNanoseconds();
+    }
+  }  // namespace detail
+
   /**
    * @brief Compare `AudioBlockFormats` by Rtime
    * @headerfile comparator.hpp <adm/utilities/comparator.hpp>
@@ -30,8 +41,8 @@ namespace adm {
     template <typename AudioBlockFormat>
     bool operator()(const AudioBlockFormat& lhs, const AudioBlockFormat& rhs) {
       if (lhs.template has<Rtime>() && rhs.template has<Rtime>()) {
-        return lhs.template get<Rtime>().get().asNanoseconds() <
-               rhs.template get<Rtime>().get().asNanoseconds();
+        return detail::nanosecondsLess(lhs.template get<Rtime>().get(),
+                                       rhs.template get<Rtime>().get());
       }
 
       return false;
@@ -66,13 +77,14 @@ namespace adm {
       if (lhs.template has<Rtime>() && rhs.template has<Rtime>()) {
         if (lhs.template get<Rtime>() == rhs.template get<Rtime>()) {
           if (lhs.template has<Duration>() && rhs.template has<Duration>()) {
-            return lhs.template get<Duration>().get().asNanoseconds() <
-                   rhs.template get<Duration>().get().asNanoseconds();
+            return detail::nanosecondsLess(
+                lhs.template get<Duration>().get(),
+                rhs.template get<Duration>().get());
           }
         }
 
-        return lhs.template get<Rtime>().get().asNanoseconds() <
-               rhs.template get<Rtime>().get().asNanoseconds();
+        return detail::nanosecondsLess(lhs.template get<Rtime>().get(),
+                                       rhs.template get<Rtime>().get());
       }
 
       return false;
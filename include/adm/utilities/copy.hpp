@@ -5,9 +5,11 @@
 namespace adm {
 
   ADM_EXPORT std::shared_ptr<Document> deepCopy(
-      std::shared_ptr<const Document> document);
+      std::shared_ptr<const Document> document,
+      CopyOptions options = CopyOptions::none);
 
   ADM_EXPORT void deepCopyTo(std::shared_ptr<const Document> src,
-                             std::shared_ptr<Document> dest);
+                             std::shared_ptr<Document> dest,
+                             CopyOptions options = CopyOptions::none);
 
 }  // namespace adm
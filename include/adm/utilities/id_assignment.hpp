@@ -6,6 +6,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace adm {
 
@@ -27,6 +28,22 @@ namespace adm {
    */
   ADM_EXPORT void reassignIds(std::shared_ptr<Document> document);
 
+  /**
+   * @brief Reassign ID's of several Documents into disjoint ranges
+   *
+   * Each Document is given new IDs as by reassignIds(document), except
+   * that the ID values issued to each Document continue from those issued
+   * to the Documents before it. Apart from common definitions, no two
+   * Documents then share an ID, so their elements can be merged into one
+   * Document, for example when combining stems rendered separately.
+   *
+   * The Documents are processed on multiple threads. If the IDs do not fit
+   * in the available ranges, std::runtime_error is thrown and no Document
+   * is changed.
+   */
+  ADM_EXPORT void reassignIds(
+      const std::vector<std::shared_ptr<Document>>& documents);
+
   /** @name Check if ID is a common definitions ID
    */
   ///@{
@@ -0,0 +1,132 @@
+/// @file tick_time.hpp
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <boost/optional.hpp>
+#include "adm/elements/time.hpp"
+#include "adm/export.h"
+
+namespace adm {
+
+  /**
+   * @brief An exact time, as a whole number of ticks of a Timebase
+   * @headerfile tick_time.hpp <adm/utilities/tick_time.hpp>
+   *
+   * Comparison and arithmetic are plain integer operations, so are only
+   * meaningful between TickTimes from the same Timebase.
+   */
+  struct TickTime {
+    int64_t ticks;
+
+    constexpr bool operator==(TickTime other) const {
+      return ticks == other.ticks;
+    }
+    constexpr bool operator!=(TickTime other) const {
+      return ticks != other.ticks;
+    }
+    constexpr bool operator<(TickTime other) const {
+      return ticks < other.ticks;
+    }
+    constexpr bool operator<=(TickTime other) const {
+      return ticks <= other.ticks;
+    }
+    constexpr bool operator>(TickTime other) const {
+      return ticks > other.ticks;
+    }
+    constexpr bool operator>=(TickTime other) const {
+      return ticks >= other.ticks;
+    }
+
+    constexpr TickTime operator+(TickTime other) const {
+      return {ticks + other.ticks};
+    }
+    constexpr TickTime operator-(TickTime other) const {
+      return {ticks - other.ticks};
+    }
+    TickTime& operator+=(TickTime other) {
+      ticks += other.ticks;
+      return *this;
+    }
+    TickTime& operator-=(TickTime other) {
+      ticks -= other.ticks;
+      return *this;
+    }
+  };
+
+  /**
+   * @brief A common tick duration for a set of Times
+   * @headerfile tick_time.hpp <adm/utilities/tick_time.hpp>
+   *
+   * A Timebase is built up by calling extendTo() with each Time which must
+   * be represented; the result is the coarsest timebase in which they are
+   * all a whole number of ticks. Times can then be converted to TickTime
+   * once, and compared, added and subtracted without the variant dispatch,
+   * divisions and normalisation needed when working with Time directly.
+   *
+   * Conversion back is lossless: a Time in nanoseconds is recovered by
+   * toNanoseconds(), and a FractionalTime by toFractional() with its
+   * original denominator.
+   *
+   * @code
+     Timebase timebase;
+     for (auto& block : blocks)
+       if (!timebase.extendTo(block.get<Rtime>().get())) return fallback();
+
+     std::vector<TickTime> rtimes;
+     for (auto& block : blocks)
+       rtimes.push_back(*timebase.toTicks(block.get<Rtime>().get()));
+     @endcode
+   */
+  class Timebase {
+   public:
+    /// a timebase with one tick per second
+    Timebase()
+        : ticksPerSecond_(1),
+          nanosecondDivisor_(1000000000),
+          nanosecondFactor_(1) {}
+    /// @throws std::invalid_argument if ticksPerSecond is not positive
+    ADM_EXPORT explicit Timebase(int64_t ticksPerSecond);
+
+    int64_t ticksPerSecond() const { return ticksPerSecond_; }
+
+    /// make the ticks fine enough to represent time exactly
+    ///
+    /// Fractional times are represented with their denominator as given,
+    /// so that they can be converted back without changing it.
+    ///
+    /// @returns false, leaving the timebase unchanged, if the number of
+    /// ticks per second would overflow
+    ADM_EXPORT bool extendTo(const Time& time);
+
+    /// convert time to ticks
+    ///
+    /// @returns boost::none if time is not a whole number of ticks, or the
+    /// number of ticks would overflow
+    ADM_EXPORT boost::optional<TickTime> toTicks(const Time& time) const;
+
+    /// convert to nanoseconds, rounding towards zero in the same way as
+    /// Time::asNanoseconds()
+    ADM_EXPORT std::chrono::nanoseconds toNanoseconds(TickTime time) const;
+    /// convert to a normalised FractionalTime
+    ADM_EXPORT FractionalTime toFractional(TickTime time) const;
+    /// convert to a FractionalTime with the given denominator, rounding
+    /// towards zero
+    ///
+    /// @throws std::invalid_argument if denominator does not divide
+    /// ticksPerSecond()
+    ADM_EXPORT FractionalTime toFractional(TickTime time,
+                                           int64_t denominator) const;
+
+   private:
+    void updateNanosecondScale();
+
+    int64_t ticksPerSecond_;
+    /// times in nanoseconds are converted to ticks by dividing by
+    /// nanosecondDivisor_ then multiplying by nanosecondFactor_; these have
+    /// no common factors, so this is exact if the division is
+    int64_t nanosecondDivisor_;
+    int64_t nanosecondFactor_;
+  };
+
+}  // namespace adm
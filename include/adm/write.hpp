@@ -10,6 +10,7 @@ namespace adm {
 
   class Document;
   class FrameHeader;
+  class FrameView;
 
   namespace xml {
     /**
@@ -35,6 +36,8 @@ namespace adm {
      *                      || **options controlling default values**
      * none                 | use `<ebuCoreMain>` envelope (default)
      * write_default_values | use `<ebuCoreMain>` envelope (default)
+     *                      || **options controlling performance**
+     * parallel             | format audioChannelFormats on multiple threads
      *
      *
      * @ingroup xml
@@ -43,12 +46,14 @@ namespace adm {
       none = 0x0,  ///< default behaviour
       itu_structure = 0x1,  ///< use ITU xml structure
       write_default_values = 0x2,  ///< write default values
+      parallel = 0x4,  ///< format audioChannelFormats on multiple threads
     };
 
     enum class SadmWriterOptions : unsigned {
       none = 0x0,  ///< default behaviour
       core_metadata = 0x1,  ///< audioFormatExtended inside coreMetadata/format/
       write_default_values = 0x2,  ///< write default values
+      parallel = 0x4,  ///< format audioChannelFormats on multiple threads
     };
   }  // namespace xml
 
@@ -112,6 +117,23 @@ namespace adm {
       std::ostream& stream, std::shared_ptr<const Document> admDocument,
       FrameHeader const& frameHeader,
       xml::SadmWriterOptions options = xml::SadmWriterOptions::none);
+
+  /**
+   * @brief Write the part of a Document in a SADM Frame to an output stream.
+   *
+   * This is the same as
+   * `writeXml(std::ostream&, std::shared_ptr<const Document>, FrameHeader const&, xml::SadmWriterOptions)`
+   * with the document of @a frameView, except that only the audioBlockFormats
+   * which overlap the frame are written.
+   * @param stream output stream to write XML data
+   * @param frameView document and time window to write
+   * @param frameHeader SADM frame header
+   * @param options Options to influence the XML generator behaviour
+   */
+  ADM_EXPORT std::ostream& writeXml(
+      std::ostream& stream, const FrameView& frameView,
+      FrameHeader const& frameHeader,
+      xml::SadmWriterOptions options = xml::SadmWriterOptions::none);
   /**
    * @}
    */
@@ -1,43 +1,20 @@
 #include "adm/common_definitions.hpp"
-#include "resources.hpp"
-#include "adm/private/document_parser.hpp"
+#include "adm/common_definitions_tables.hpp"
+#include "adm/elements.hpp"
+#include "adm/elements/audio_pack_format_hoa.hpp"
 #include "adm/utilities/copy.hpp"
 
 namespace adm {
 
   const std::map<std::string, adm::AudioPackFormatId>
   audioPackFormatLookupTable() {
-    return std::map<std::string, adm::AudioPackFormatId>{
-        {"0+1+0", adm::parseAudioPackFormatId("AP_00010001")},
-        {"0+2+0", adm::parseAudioPackFormatId("AP_00010002")},
-        {"0+5+0", adm::parseAudioPackFormatId("AP_00010003")},
-        {"2+5+0", adm::parseAudioPackFormatId("AP_00010004")},
-        {"4+5+0", adm::parseAudioPackFormatId("AP_00010005")},
-        {"4+5+1", adm::parseAudioPackFormatId("AP_00010010")},
-        {"3+7+0", adm::parseAudioPackFormatId("AP_00010007")},
-        {"4+9+0", adm::parseAudioPackFormatId("AP_00010008")},
-        {"9+10+3", adm::parseAudioPackFormatId("AP_00010009")},
-        {"0+7+0", adm::parseAudioPackFormatId("AP_0001000f")},
-        {"4+7+0", adm::parseAudioPackFormatId("AP_00010017")},
-        {"SN3D-Order1-3D", adm::parseAudioPackFormatId("AP_00040001")},
-        {"SN3D-Order2-3D", adm::parseAudioPackFormatId("AP_00040002")},
-        {"SN3D-Order3-3D", adm::parseAudioPackFormatId("AP_00040003")},
-        {"SN3D-Order4-3D", adm::parseAudioPackFormatId("AP_00040004")},
-        {"SN3D-Order5-3D", adm::parseAudioPackFormatId("AP_00040005")},
-        {"SN3D-Order6-3D", adm::parseAudioPackFormatId("AP_00040006")},
-        {"N3D-Order1-3D", adm::parseAudioPackFormatId("AP_00040011")},
-        {"N3D-Order2-3D", adm::parseAudioPackFormatId("AP_00040012")},
-        {"N3D-Order3-3D", adm::parseAudioPackFormatId("AP_00040013")},
-        {"N3D-Order4-3D", adm::parseAudioPackFormatId("AP_00040014")},
-        {"N3D-Order5-3D", adm::parseAudioPackFormatId("AP_00040015")},
-        {"N3D-Order6-3D", adm::parseAudioPackFormatId("AP_00040016")},
-        {"FuMa-Order1-3D", adm::parseAudioPackFormatId("AP_00040021")},
-        {"FuMa-Order2-3D", adm::parseAudioPackFormatId("AP_00040022")},
-        {"FuMa-Order3-3D", adm::parseAudioPackFormatId("AP_00040023")},
-        {"FuMa-Order4-3D", adm::parseAudioPackFormatId("AP_00040024")},
-        {"FuMa-Order5-3D", adm::parseAudioPackFormatId("AP_00040025")},
-        {"FuMa-Order6-3D", adm::parseAudioPackFormatId("AP_00040026")},
-    };
+    std::map<std::string, adm::AudioPackFormatId> table;
+    for (auto& layout : common_definitions::speakerLayouts()) {
+      table.emplace(layout.name,
+                    AudioPackFormatId(TypeDescriptor(layout.typeDefinition),
+                                      AudioPackFormatIdValue(layout.idValue)));
+    }
+    return table;
   };
 
   const std::map<std::string, adm::AudioTrackFormatId>
@@ -153,15 +130,126 @@ namespace adm {
                                    AudioTrackFormatIdCounter(1));
   }
 
+  namespace {
+    using namespace common_definitions;
+
+    std::shared_ptr<AudioPackFormat> createPackFormat(
+        const PackFormatEntry& entry) {
+      auto id = getId(entry);
+      AudioPackFormatName name(entry.name);
+      if (id.get<TypeDescriptor>() == TypeDefinition::HOA)
+        return AudioPackFormatHoa::create(std::move(name), id);
+      else
+        return AudioPackFormat::create(std::move(name),
+                                       id.get<TypeDescriptor>(), id);
+    }
+
+    std::shared_ptr<AudioChannelFormat> createChannelFormat(
+        const ChannelFormatEntry& entry) {
+      auto id = getId(entry);
+      auto channelFormat = AudioChannelFormat::create(
+          AudioChannelFormatName(entry.name), id.get<TypeDescriptor>(), id);
+      if (entry.hasLowPass)
+        channelFormat->set(Frequency(LowPass(entry.lowPass)));
+
+      if (id.get<TypeDescriptor>() == TypeDefinition::DIRECT_SPEAKERS) {
+        ScreenEdgeLock screenEdgeLock;
+        if (entry.screenEdgeLock)
+          screenEdgeLock.set(HorizontalEdge(entry.screenEdgeLock));
+        SphericalSpeakerPosition position(
+            Azimuth(entry.azimuth), Elevation(entry.elevation),
+            Distance(entry.distance), screenEdgeLock);
+        AudioBlockFormatDirectSpeakers blockFormat{SpeakerPosition(position)};
+        if (entry.speakerLabel)
+          blockFormat.add(SpeakerLabel(entry.speakerLabel));
+        channelFormat->add(std::move(blockFormat));
+      } else if (id.get<TypeDescriptor>() == TypeDefinition::HOA) {
+        AudioBlockFormatHoa blockFormat{Order(entry.order),
+                                        Degree(entry.degree)};
+        if (entry.normalization)
+          blockFormat.set(Normalization(entry.normalization));
+        channelFormat->add(std::move(blockFormat));
+      } else if (id.get<TypeDescriptor>() == TypeDefinition::BINAURAL) {
+        channelFormat->add(AudioBlockFormatBinaural());
+      }
+      return channelFormat;
+    }
+
+    /// build the common definitions from the generated tables
+    std::shared_ptr<Document> createCommonDefinitions() {
+      auto document = Document::create();
+
+      // add all elements before setting any references, so that they end up
+      // in table order rather than being added recursively
+      std::vector<std::shared_ptr<AudioPackFormat>> packFormatElements;
+      packFormatElements.reserve(packFormats().size());
+      for (auto& entry : packFormats()) {
+        packFormatElements.push_back(createPackFormat(entry));
+        document->add(packFormatElements.back());
+      }
+
+      std::vector<std::shared_ptr<AudioChannelFormat>> channelFormatElements;
+      channelFormatElements.reserve(channelFormats().size());
+      for (auto& entry : channelFormats()) {
+        channelFormatElements.push_back(createChannelFormat(entry));
+        document->add(channelFormatElements.back());
+      }
+
+      std::vector<std::shared_ptr<AudioStreamFormat>> streamFormatElements;
+      streamFormatElements.reserve(streamFormats().size());
+      for (auto& entry : streamFormats()) {
+        streamFormatElements.push_back(AudioStreamFormat::create(
+            AudioStreamFormatName(entry.name),
+            FormatDescriptor(entry.formatDefinition), getId(entry)));
+        document->add(streamFormatElements.back());
+      }
+
+      std::vector<std::shared_ptr<AudioTrackFormat>> trackFormatElements;
+      trackFormatElements.reserve(trackFormats().size());
+      for (auto& entry : trackFormats()) {
+        trackFormatElements.push_back(AudioTrackFormat::create(
+            AudioTrackFormatName(entry.name),
+            FormatDescriptor(entry.formatDefinition), getId(entry)));
+        document->add(trackFormatElements.back());
+      }
+
+      for (std::size_t i = 0; i < packFormatElements.size(); i++) {
+        for (auto ref : packFormats()[i].channelFormats)
+          packFormatElements[i]->addReference(channelFormatElements[ref]);
+        for (auto ref : packFormats()[i].packFormats)
+          packFormatElements[i]->addReference(packFormatElements[ref]);
+      }
+      for (std::size_t i = 0; i < trackFormatElements.size(); i++) {
+        trackFormatElements[i]->setReference(
+            streamFormatElements[trackFormats()[i].streamFormat]);
+      }
+      for (std::size_t i = 0; i < streamFormatElements.size(); i++) {
+        streamFormatElements[i]->setReference(
+            channelFormatElements[streamFormats()[i].channelFormat]);
+        for (auto ref : streamFormats()[i].trackFormats)
+          streamFormatElements[i]->addReference(
+              std::weak_ptr<AudioTrackFormat>(trackFormatElements[ref]));
+      }
+
+      return document;
+    }
+
+    /// the common definitions; this is built once on first use and never
+    /// modified afterwards, so may be copied from concurrently
+    std::shared_ptr<const Document> commonDefinitionsTemplate() {
+      static const std::shared_ptr<const Document> document =
+          createCommonDefinitions();
+      return document;
+    }
+  }  // namespace
+
   std::shared_ptr<Document> getCommonDefinitions() {
-    std::stringstream commonDefinitions;
-    getEmbeddedFile("common_definitions.xml", commonDefinitions);
-    xml::DocumentParser parser(commonDefinitions,
-                               xml::ParserOptions::recursive_node_search);
-    return parser.parse();
+    return commonDefinitionsTemplate()->deepCopy(
+        CopyOptions::share_block_formats);
   }
 
   void addCommonDefinitionsTo(std::shared_ptr<Document> document) {
-    deepCopyTo(getCommonDefinitions(), document);
+    deepCopyTo(commonDefinitionsTemplate(), document,
+               CopyOptions::share_block_formats);
   }
 }  // namespace adm
@@ -0,0 +1,139 @@
+#include "adm/common_definitions_tables.hpp"
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include "adm/private/common_definitions_index.hpp"
+
+namespace adm {
+  namespace common_definitions {
+
+    namespace {
+      // clang-format off
+      const SpeakerLayoutEntry speakerLayoutTable[] = {
+          {"0+1+0", 0x0001, 0x0001},
+          {"0+2+0", 0x0001, 0x0002},
+          {"0+5+0", 0x0001, 0x0003},
+          {"2+5+0", 0x0001, 0x0004},
+          {"4+5+0", 0x0001, 0x0005},
+          {"4+5+1", 0x0001, 0x0010},
+          {"3+7+0", 0x0001, 0x0007},
+          {"4+9+0", 0x0001, 0x0008},
+          {"9+10+3", 0x0001, 0x0009},
+          {"0+7+0", 0x0001, 0x000f},
+          {"4+7+0", 0x0001, 0x0017},
+          {"SN3D-Order1-3D", 0x0004, 0x0001},
+          {"SN3D-Order2-3D", 0x0004, 0x0002},
+          {"SN3D-Order3-3D", 0x0004, 0x0003},
+          {"SN3D-Order4-3D", 0x0004, 0x0004},
+          {"SN3D-Order5-3D", 0x0004, 0x0005},
+          {"SN3D-Order6-3D", 0x0004, 0x0006},
+          {"N3D-Order1-3D", 0x0004, 0x0011},
+          {"N3D-Order2-3D", 0x0004, 0x0012},
+          {"N3D-Order3-3D", 0x0004, 0x0013},
+          {"N3D-Order4-3D", 0x0004, 0x0014},
+          {"N3D-Order5-3D", 0x0004, 0x0015},
+          {"N3D-Order6-3D", 0x0004, 0x0016},
+          {"FuMa-Order1-3D", 0x0004, 0x0021},
+          {"FuMa-Order2-3D", 0x0004, 0x0022},
+          {"FuMa-Order3-3D", 0x0004, 0x0023},
+          {"FuMa-Order4-3D", 0x0004, 0x0024},
+          {"FuMa-Order5-3D", 0x0004, 0x0025},
+          {"FuMa-Order6-3D", 0x0004, 0x0026},
+      };
+      // clang-format on
+
+      std::tuple<int, unsigned int> key(const PackFormatEntry& entry) {
+        return std::make_tuple(entry.typeDefinition, entry.idValue);
+      }
+      std::tuple<int, unsigned int> key(const ChannelFormatEntry& entry) {
+        return std::make_tuple(entry.typeDefinition, entry.idValue);
+      }
+      std::tuple<int, unsigned int> key(const StreamFormatEntry& entry) {
+        return std::make_tuple(entry.typeDefinition, entry.idValue);
+      }
+      std::tuple<int, unsigned int, unsigned int> key(
+          const TrackFormatEntry& entry) {
+        return std::make_tuple(entry.typeDefinition, entry.idValue,
+                               entry.idCounter);
+      }
+
+      /// binary search for the entry in table with the given key, using an
+      /// index of the table sorted by key
+      template <typename Entry, typename Key>
+      const Entry* findEntry(TableRange<Entry> table,
+                             TableRange<std::size_t> byId, const Key& k) {
+        auto it = std::lower_bound(
+            byId.begin(), byId.end(), k,
+            [&table](std::size_t index, const Key& value) {
+              return key(table[index]) < value;
+            });
+        if (it != byId.end() && key(table[*it]) == k) return &table[*it];
+        return nullptr;
+      }
+    }  // namespace
+
+    TableRange<SpeakerLayoutEntry> speakerLayouts() {
+      return speakerLayoutTable;
+    }
+
+    const PackFormatEntry* lookup(const AudioPackFormatId& id) {
+      return findEntry(packFormats(), detail::packFormatsById(),
+                       std::make_tuple(id.get<TypeDescriptor>().get(),
+                                       id.get<AudioPackFormatIdValue>().get()));
+    }
+
+    const ChannelFormatEntry* lookup(const AudioChannelFormatId& id) {
+      return findEntry(
+          channelFormats(), detail::channelFormatsById(),
+          std::make_tuple(id.get<TypeDescriptor>().get(),
+                          id.get<AudioChannelFormatIdValue>().get()));
+    }
+
+    const StreamFormatEntry* lookup(const AudioStreamFormatId& id) {
+      return findEntry(
+          streamFormats(), detail::streamFormatsById(),
+          std::make_tuple(id.get<TypeDescriptor>().get(),
+                          id.get<AudioStreamFormatIdValue>().get()));
+    }
+
+    const TrackFormatEntry* lookup(const AudioTrackFormatId& id) {
+      return findEntry(
+          trackFormats(), detail::trackFormatsById(),
+          std::make_tuple(id.get<TypeDescriptor>().get(),
+                          id.get<AudioTrackFormatIdValue>().get(),
+                          id.get<AudioTrackFormatIdCounter>().get()));
+    }
+
+    const PackFormatEntry* lookupSpeakerLayout(const std::string& name) {
+      for (auto& layout : speakerLayouts()) {
+        if (std::strcmp(layout.name, name.c_str()) == 0)
+          return lookup(
+              AudioPackFormatId(TypeDescriptor(layout.typeDefinition),
+                                AudioPackFormatIdValue(layout.idValue)));
+      }
+      return nullptr;
+    }
+
+    AudioPackFormatId getId(const PackFormatEntry& entry) {
+      return AudioPackFormatId(TypeDescriptor(entry.typeDefinition),
+                               AudioPackFormatIdValue(entry.idValue));
+    }
+
+    AudioChannelFormatId getId(const ChannelFormatEntry& entry) {
+      return AudioChannelFormatId(TypeDescriptor(entry.typeDefinition),
+                                  AudioChannelFormatIdValue(entry.idValue));
+    }
+
+    AudioStreamFormatId getId(const StreamFormatEntry& entry) {
+      return AudioStreamFormatId(TypeDescriptor(entry.typeDefinition),
+                                 AudioStreamFormatIdValue(entry.idValue));
+    }
+
+    AudioTrackFormatId getId(const TrackFormatEntry& entry) {
+      return AudioTrackFormatId(TypeDescriptor(entry.typeDefinition),
+                                AudioTrackFormatIdValue(entry.idValue),
+                                AudioTrackFormatIdCounter(entry.idCounter));
+    }
+
+  }  // namespace common_definitions
+}  // namespace adm
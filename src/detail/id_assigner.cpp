@@ -5,56 +5,12 @@
 
 namespace adm {
   namespace detail {
-    namespace {
-      struct DefaultFilter {
-        template <typename T>
-        bool operator()(T const&) const {
-          return true;
-        }
-      };
-      // original recursive lookup method was O(N^2), this is O(NlogN)
-      // N for filter by type / value
-      // NlogN for sort
-      // logN for lower_bound
-      // N for adjacent_find
-      // if using pre-sorted vectors would be O(N)
-      template <typename ElementT, typename CounterT,
-                typename FilterPredicate = DefaultFilter>
-      CounterT nextCounter(adm::Document const& doc, CounterT preferredCounter,
-                           FilterPredicate predicate = FilterPredicate{}) {
-        auto elements = doc.getElements<ElementT>();
-        // Filter ids by predicate, collect counter values in container
-        std::vector<typename CounterT::value_type> counters;
-        counters.reserve(elements.size());
-        for (auto const& el : elements) {
-          auto id = el->template get<typename ElementT::id_type>();
-          if (predicate(id)) {
-            counters.push_back(id.template get<CounterT>().get());
-          }
-        }
-        // sort counters so we can use fast algorithms
-        std::sort(counters.begin(), counters.end());
-        // find the position where all elements are >= preferred value
-        auto lowerBound = std::lower_bound(counters.begin(), counters.end(),
-                                           preferredCounter.get());
-        // if this is the end of the vector or lower bound is not equal to preferred, preferred is free so use it
-        if (lowerBound == counters.end() ||
-            *lowerBound != preferredCounter.get()) {
-          return preferredCounter;
-        }
-
-        // starting from the preferred value, find the next free value by looking for gaps in sequence
-        auto it = std::adjacent_find(
-            lowerBound, counters.end(),
-            [](auto lhs, auto rhs) { return lhs + 1 != rhs; });
-        // if no gaps use next available value
-        if (it == counters.end()) {
-          return CounterT(counters.back() + 1);
-        }
-        // if gap, use that
-        return CounterT((*it) + 1);
-      }
-    }  // namespace
+    template <typename Element, typename Counter>
+    Counter IdAssigner::nextCounter(const typename Element::id_type& id,
+                                    Counter preferred) const {
+      return Counter(document_->idIndex_.get<Element>().counters().nextFree(
+          id, preferred.get()));
+    }
 
     const Document& IdAssigner::document() const { return *document_; }
 
@@ -69,7 +25,8 @@ namespace adm {
         idValue =
             programme.get<AudioProgrammeId>().get<AudioProgrammeIdValue>();
       }
-      idValue = nextCounter<AudioProgramme>(document(), idValue);
+      idValue =
+          nextCounter<AudioProgramme>(AudioProgrammeId(idValue), idValue);
       auto id = AudioProgrammeId(idValue);
       programme.set(id);
       return id;
@@ -83,7 +40,7 @@ namespace adm {
       if (!isUndefined(content.get<AudioContentId>())) {
         idValue = content.get<AudioContentId>().get<AudioContentIdValue>();
       }
-      idValue = nextCounter<AudioContent>(document(), idValue);
+      idValue = nextCounter<AudioContent>(AudioContentId(idValue), idValue);
       auto id = AudioContentId(idValue);
       content.set(id);
       return id;
@@ -97,7 +54,7 @@ namespace adm {
       if (!isUndefined(object.get<AudioObjectId>())) {
         idValue = object.get<AudioObjectId>().get<AudioObjectIdValue>();
       }
-      idValue = nextCounter<AudioObject>(document(), idValue);
+      idValue = nextCounter<AudioObject>(AudioObjectId(idValue), idValue);
       auto id = AudioObjectId(idValue);
       object.set(id);
       return id;
@@ -114,9 +71,7 @@ namespace adm {
             packFormat.get<AudioPackFormatId>().get<AudioPackFormatIdValue>();
       }
       idValue = nextCounter<AudioPackFormat>(
-          document(), idValue, [typeDescriptor](AudioPackFormatId const& id) {
-            return id.get<TypeDescriptor>() == typeDescriptor;
-          });
+          AudioPackFormatId(typeDescriptor, idValue), idValue);
       auto id = AudioPackFormatId(typeDescriptor, idValue);
       packFormat.set(id);
       return id;
@@ -134,10 +89,7 @@ namespace adm {
                       .get<AudioChannelFormatIdValue>();
       }
       idValue = nextCounter<AudioChannelFormat>(
-          document(), idValue,
-          [typeDescriptor](AudioChannelFormatId const& id) {
-            return id.get<TypeDescriptor>() == typeDescriptor;
-          });
+          AudioChannelFormatId(typeDescriptor, idValue), idValue);
       auto id = AudioChannelFormatId(typeDescriptor, idValue);
       channelFormat.set(id);
       return id;
@@ -164,9 +116,7 @@ namespace adm {
         }
       }
       idValue = nextCounter<AudioStreamFormat>(
-          document(), idValue, [typeDescriptor](AudioStreamFormatId const& id) {
-            return id.get<TypeDescriptor>() == typeDescriptor;
-          });
+          AudioStreamFormatId(typeDescriptor, idValue), idValue);
       auto id = AudioStreamFormatId(typeDescriptor, idValue);
       streamFormat.set(id);
       return id;
@@ -196,11 +146,7 @@ namespace adm {
         }
       }
       idCounter = nextCounter<AudioTrackFormat>(
-          document(), idCounter,
-          [&typeDescriptor, &idValue](AudioTrackFormatId const& id) {
-            return id.get<TypeDescriptor>() == typeDescriptor &&
-                   id.get<AudioTrackFormatIdValue>() == idValue;
-          });
+          AudioTrackFormatId(typeDescriptor, idValue, idCounter), idCounter);
       auto id = AudioTrackFormatId(typeDescriptor, idValue, idCounter);
       trackFormat.set(id);
       return id;
@@ -215,7 +161,7 @@ namespace adm {
       if (!isUndefined(trackUid.get<AudioTrackUidId>())) {
         idValue = trackUid.get<AudioTrackUidId>().get<AudioTrackUidIdValue>();
       }
-      idValue = nextCounter<AudioTrackUid>(document(), idValue);
+      idValue = nextCounter<AudioTrackUid>(AudioTrackUidId(idValue), idValue);
       auto id = AudioTrackUidId(idValue);
       trackUid.set(id);
       return id;
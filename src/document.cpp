@@ -3,11 +3,11 @@
 #include "adm/elements.hpp"
 #include "adm/elements/private/parent_attorneys.hpp"
 #include "adm/utilities/copy.hpp"
-#include "adm/utilities/lookup.hpp"
 #include "adm/detail/id_assigner.hpp"
 #include "adm/private/copy.hpp"
 
 #include <algorithm>
+#include <unordered_set>
 
 namespace adm {
   namespace detail {
@@ -20,44 +20,71 @@ namespace adm {
     return std::shared_ptr<Document>(new Document());
   }
 
-  std::shared_ptr<Document> Document::deepCopy() const {
-    auto copy = Document::create();
+  std::shared_ptr<Document> Document::create(
+      std::shared_ptr<MemoryArena> arena) {
+    auto document = create();
+    document->arena_ = std::move(arena);
+    return document;
+  }
+
+  std::shared_ptr<MemoryArena> Document::getArena() const { return arena_; }
+
+  std::shared_ptr<Document> Document::deepCopy(CopyOptions options) const {
+    auto copy = arena_ ? Document::create(MemoryArena::create())
+                       : Document::create();
+    ArenaScope arenaScope(copy->arena_);
     copy->audioProgrammes_.reserve(audioProgrammes_.size());
+    copy->idIndex_.get<AudioProgramme>().reserve(audioProgrammes_.size());
     copy->audioContents_.reserve(audioContents_.size());
+    copy->idIndex_.get<AudioContent>().reserve(audioContents_.size());
     copy->audioObjects_.reserve(audioObjects_.size());
+    copy->idIndex_.get<AudioObject>().reserve(audioObjects_.size());
     copy->audioPackFormats_.reserve(audioPackFormats_.size());
+    copy->idIndex_.get<AudioPackFormat>().reserve(audioPackFormats_.size());
     copy->audioChannelFormats_.reserve(audioChannelFormats_.size());
+    copy->idIndex_.get<AudioChannelFormat>().reserve(audioChannelFormats_.size());
     copy->audioStreamFormats_.reserve(audioStreamFormats_.size());
+    copy->idIndex_.get<AudioStreamFormat>().reserve(audioStreamFormats_.size());
     copy->audioTrackFormats_.reserve(audioTrackFormats_.size());
+    copy->idIndex_.get<AudioTrackFormat>().reserve(audioTrackFormats_.size());
     copy->audioTrackUids_.reserve(audioTrackUids_.size());
+    copy->idIndex_.get<AudioTrackUid>().reserve(audioTrackUids_.size());
 
-    auto elements = copyAllElements(shared_from_this());
+    auto elements = copyAllElements(shared_from_this(), options);
     if (has<Version>()) copy->set(get<Version>());
     for (auto& e : elements) {
       if (auto v = boost::get<std::shared_ptr<AudioProgramme>>(&e)) {
         AudioProgrammeAttorney::setParent(*v, copy);
         copy->audioProgrammes_.push_back(*v);
+        copy->idIndex_.get<AudioProgramme>().add(*v);
       } else if (auto v = boost::get<std::shared_ptr<AudioContent>>(&e)) {
         AudioContentAttorney::setParent(*v, copy);
         copy->audioContents_.push_back(*v);
+        copy->idIndex_.get<AudioContent>().add(*v);
       } else if (auto v = boost::get<std::shared_ptr<AudioObject>>(&e)) {
         AudioObjectAttorney::setParent(*v, copy);
         copy->audioObjects_.push_back(*v);
+        copy->idIndex_.get<AudioObject>().add(*v);
       } else if (auto v = boost::get<std::shared_ptr<AudioPackFormat>>(&e)) {
         AudioPackFormatAttorney::setParent(*v, copy);
         copy->audioPackFormats_.push_back(*v);
+        copy->idIndex_.get<AudioPackFormat>().add(*v);
       } else if (auto v = boost::get<std::shared_ptr<AudioChannelFormat>>(&e)) {
         AudioChannelFormatAttorney::setParent(*v, copy);
         copy->audioChannelFormats_.push_back(*v);
+        copy->idIndex_.get<AudioChannelFormat>().add(*v);
       } else if (auto v = boost::get<std::shared_ptr<AudioStreamFormat>>(&e)) {
         AudioStreamFormatAttorney::setParent(*v, copy);
         copy->audioStreamFormats_.push_back(*v);
+        copy->idIndex_.get<AudioStreamFormat>().add(*v);
       } else if (auto v = boost::get<std::shared_ptr<AudioTrackFormat>>(&e)) {
         AudioTrackFormatAttorney::setParent(*v, copy);
         copy->audioTrackFormats_.push_back(*v);
+        copy->idIndex_.get<AudioTrackFormat>().add(*v);
       } else if (auto v = boost::get<std::shared_ptr<AudioTrackUid>>(&e)) {
         AudioTrackUidAttorney::setParent(*v, copy);
         copy->audioTrackUids_.push_back(*v);
+        copy->idIndex_.get<AudioTrackUid>().add(*v);
       }
     }
     return copy;
@@ -69,6 +96,7 @@ namespace adm {
       idAssigner_.assignId(*programme);
       AudioProgrammeAttorney::setParent(programme, shared_from_this());
       audioProgrammes_.push_back(programme);
+      idIndex_.get<AudioProgramme>().add(programme);
       for (auto& reference : programme->getReferences<AudioContent>()) {
         add(reference);
       }
@@ -83,6 +111,7 @@ namespace adm {
       idAssigner_.assignId(*content);
       AudioContentAttorney::setParent(content, shared_from_this());
       audioContents_.push_back(content);
+      idIndex_.get<AudioContent>().add(content);
       for (auto& reference : content->getReferences<AudioObject>()) {
         add(reference);
       }
@@ -97,6 +126,7 @@ namespace adm {
       idAssigner_.assignId(*object);
       AudioObjectAttorney::setParent(object, shared_from_this());
       audioObjects_.push_back(object);
+      idIndex_.get<AudioObject>().add(object);
       for (auto& reference : object->getReferences<AudioObject>()) {
         add(reference);
       }
@@ -119,6 +149,7 @@ namespace adm {
       idAssigner_.assignId(*packFormat);
       AudioPackFormatAttorney::setParent(packFormat, shared_from_this());
       audioPackFormats_.push_back(packFormat);
+      idIndex_.get<AudioPackFormat>().add(packFormat);
       for (auto& reference : packFormat->getReferences<AudioPackFormat>()) {
         add(reference);
       }
@@ -136,6 +167,7 @@ namespace adm {
       idAssigner_.assignId(*channelFormat);
       AudioChannelFormatAttorney::setParent(channelFormat, shared_from_this());
       audioChannelFormats_.push_back(channelFormat);
+      idIndex_.get<AudioChannelFormat>().add(channelFormat);
       return true;
     } else {
       return false;
@@ -147,6 +179,7 @@ namespace adm {
       idAssigner_.assignId(*streamFormat);
       AudioStreamFormatAttorney::setParent(streamFormat, shared_from_this());
       audioStreamFormats_.push_back(streamFormat);
+      idIndex_.get<AudioStreamFormat>().add(streamFormat);
       auto audioChannelFormat =
           streamFormat->getReference<AudioChannelFormat>();
       if (audioChannelFormat) {
@@ -177,14 +210,14 @@ namespace adm {
       if (audioStreamFormat) {
         add(audioStreamFormat);
       }
-      auto it = std::find(audioTrackFormats_.begin(), audioTrackFormats_.end(),
-                          trackFormat);
-      if (it != audioTrackFormats_.end()) {
+      // adding the AudioStreamFormat may have added this AudioTrackFormat
+      if (trackFormat->getParent().lock().get() == this) {
         return true;
       }
       idAssigner_.assignId(*trackFormat);
       AudioTrackFormatAttorney::setParent(trackFormat, shared_from_this());
       audioTrackFormats_.push_back(trackFormat);
+      idIndex_.get<AudioTrackFormat>().add(trackFormat);
       return true;
     } else {
       return false;
@@ -196,6 +229,7 @@ namespace adm {
       idAssigner_.assignId(*trackUid);
       AudioTrackUidAttorney::setParent(trackUid, shared_from_this());
       audioTrackUids_.push_back(trackUid);
+      idIndex_.get<AudioTrackUid>().add(trackUid);
 
       auto audioTrackFormat = trackUid->getReference<AudioTrackFormat>();
       if (audioTrackFormat) {
@@ -221,6 +255,7 @@ namespace adm {
         std::find(audioProgrammes_.begin(), audioProgrammes_.end(), programme);
     if (it != audioProgrammes_.end()) {
       audioProgrammes_.erase(it);
+      idIndex_.get<AudioProgramme>().remove(programme, audioProgrammes_);
       AudioProgrammeAttorney::setParent(programme, {});
       return true;
     }
@@ -231,6 +266,7 @@ namespace adm {
     auto it = std::find(audioContents_.begin(), audioContents_.end(), content);
     if (it != audioContents_.end()) {
       audioContents_.erase(it);
+      idIndex_.get<AudioContent>().remove(content, audioContents_);
       AudioContentAttorney::setParent(content, {});
       for (auto& audioProgramme : audioProgrammes_) {
         audioProgramme->removeReference(content);
@@ -244,6 +280,7 @@ namespace adm {
     auto it = std::find(audioObjects_.begin(), audioObjects_.end(), object);
     if (it != audioObjects_.end()) {
       audioObjects_.erase(it);
+      idIndex_.get<AudioObject>().remove(object, audioObjects_);
       AudioObjectAttorney::setParent(object, {});
       for (auto& audioObject : audioObjects_) {
         audioObject->removeReference(object);
@@ -261,6 +298,7 @@ namespace adm {
                         packFormat);
     if (it != audioPackFormats_.end()) {
       audioPackFormats_.erase(it);
+      idIndex_.get<AudioPackFormat>().remove(packFormat, audioPackFormats_);
       AudioPackFormatAttorney::setParent(packFormat, {});
       for (auto& audioPackFormat : audioPackFormats_) {
         audioPackFormat->removeReference(packFormat);
@@ -288,6 +326,7 @@ namespace adm {
                         audioChannelFormats_.end(), channelFormat);
     if (it != audioChannelFormats_.end()) {
       audioChannelFormats_.erase(it);
+      idIndex_.get<AudioChannelFormat>().remove(channelFormat, audioChannelFormats_);
       AudioChannelFormatAttorney::setParent(channelFormat, {});
       for (auto& audioPackFormat : audioPackFormats_) {
         audioPackFormat->removeReference(channelFormat);
@@ -314,6 +353,7 @@ namespace adm {
                         streamFormat);
     if (it != audioStreamFormats_.end()) {
       audioStreamFormats_.erase(it);
+      idIndex_.get<AudioStreamFormat>().remove(streamFormat, audioStreamFormats_);
       AudioStreamFormatAttorney::setParent(streamFormat, {});
 
       for (auto& audioTrackFormat : audioTrackFormats_) {
@@ -332,6 +372,7 @@ namespace adm {
                         trackFormat);
     if (it != audioTrackFormats_.end()) {
       audioTrackFormats_.erase(it);
+      idIndex_.get<AudioTrackFormat>().remove(trackFormat, audioTrackFormats_);
       AudioTrackFormatAttorney::setParent(trackFormat, {});
 
       for (auto& audioStreamFormat : audioStreamFormats_) {
@@ -352,6 +393,7 @@ namespace adm {
         std::find(audioTrackUids_.begin(), audioTrackUids_.end(), trackUid);
     if (it != audioTrackUids_.end()) {
       audioTrackUids_.erase(it);
+      idIndex_.get<AudioTrackUid>().remove(trackUid, audioTrackUids_);
       AudioTrackUidAttorney::setParent(trackUid, {});
       for (auto& audioObject : audioObjects_) {
         audioObject->removeReference(trackUid);
@@ -444,76 +486,342 @@ namespace adm {
 
   // ---- lookup elements ---- //
   std::shared_ptr<AudioProgramme> Document::lookup(const AudioProgrammeId& id) {
-    return lookupById<AudioProgramme>(getElements<AudioProgramme>(), id);
+    return idIndex_.get<AudioProgramme>().lookup(id);
   }
   std::shared_ptr<const AudioProgramme> Document::lookup(
       const AudioProgrammeId& id) const {
-    return lookupById<const AudioProgramme>(getElements<AudioProgramme>(), id);
+    return idIndex_.get<AudioProgramme>().lookup(id);
   }
 
   std::shared_ptr<AudioContent> Document::lookup(const AudioContentId& id) {
-    return lookupById<AudioContent>(getElements<AudioContent>(), id);
+    return idIndex_.get<AudioContent>().lookup(id);
   }
   std::shared_ptr<const AudioContent> Document::lookup(
       const AudioContentId& id) const {
-    return lookupById<const AudioContent>(getElements<AudioContent>(), id);
+    return idIndex_.get<AudioContent>().lookup(id);
   }
 
   std::shared_ptr<AudioObject> Document::lookup(const AudioObjectId& id) {
-    return lookupById<AudioObject>(getElements<AudioObject>(), id);
+    return idIndex_.get<AudioObject>().lookup(id);
   }
   std::shared_ptr<const AudioObject> Document::lookup(
       const AudioObjectId& id) const {
-    return lookupById<const AudioObject>(getElements<AudioObject>(), id);
+    return idIndex_.get<AudioObject>().lookup(id);
   }
 
   std::shared_ptr<AudioPackFormat> Document::lookup(
       const AudioPackFormatId& id) {
-    return lookupById<AudioPackFormat>(getElements<AudioPackFormat>(), id);
+    return idIndex_.get<AudioPackFormat>().lookup(id);
   }
   std::shared_ptr<const AudioPackFormat> Document::lookup(
       const AudioPackFormatId& id) const {
-    return lookupById<const AudioPackFormat>(getElements<AudioPackFormat>(),
-                                             id);
+    return idIndex_.get<AudioPackFormat>().lookup(id);
   }
 
   std::shared_ptr<AudioChannelFormat> Document::lookup(
       const AudioChannelFormatId& id) {
-    return lookupById<AudioChannelFormat>(getElements<AudioChannelFormat>(),
-                                          id);
+    return idIndex_.get<AudioChannelFormat>().lookup(id);
   }
   std::shared_ptr<const AudioChannelFormat> Document::lookup(
       const AudioChannelFormatId& id) const {
-    return lookupById<const AudioChannelFormat>(
-        getElements<const AudioChannelFormat>(), id);
+    return idIndex_.get<AudioChannelFormat>().lookup(id);
   }
 
   std::shared_ptr<AudioStreamFormat> Document::lookup(
       const AudioStreamFormatId& id) {
-    return lookupById<AudioStreamFormat>(getElements<AudioStreamFormat>(), id);
+    return idIndex_.get<AudioStreamFormat>().lookup(id);
   }
   std::shared_ptr<const AudioStreamFormat> Document::lookup(
       const AudioStreamFormatId& id) const {
-    return lookupById<const AudioStreamFormat>(getElements<AudioStreamFormat>(),
-                                               id);
+    return idIndex_.get<AudioStreamFormat>().lookup(id);
   }
 
   std::shared_ptr<AudioTrackFormat> Document::lookup(
       const AudioTrackFormatId& id) {
-    return lookupById<AudioTrackFormat>(getElements<AudioTrackFormat>(), id);
+    return idIndex_.get<AudioTrackFormat>().lookup(id);
   }
   std::shared_ptr<const AudioTrackFormat> Document::lookup(
       const AudioTrackFormatId& id) const {
-    return lookupById<const AudioTrackFormat>(getElements<AudioTrackFormat>(),
-                                              id);
+    return idIndex_.get<AudioTrackFormat>().lookup(id);
   }
 
   std::shared_ptr<AudioTrackUid> Document::lookup(const AudioTrackUidId& id) {
-    return lookupById<AudioTrackUid>(getElements<AudioTrackUid>(), id);
+    return idIndex_.get<AudioTrackUid>().lookup(id);
   }
   std::shared_ptr<const AudioTrackUid> Document::lookup(
       const AudioTrackUidId& id) const {
-    return lookupById<const AudioTrackUid>(getElements<AudioTrackUid>(), id);
+    return idIndex_.get<AudioTrackUid>().lookup(id);
+  }
+
+  template <>
+  std::vector<std::shared_ptr<AudioProgramme>>&
+  Document::elementVector<AudioProgramme>() {
+    return audioProgrammes_;
+  }
+  template <>
+  std::vector<std::shared_ptr<AudioContent>>&
+  Document::elementVector<AudioContent>() {
+    return audioContents_;
+  }
+  template <>
+  std::vector<std::shared_ptr<AudioObject>>&
+  Document::elementVector<AudioObject>() {
+    return audioObjects_;
+  }
+  template <>
+  std::vector<std::shared_ptr<AudioPackFormat>>&
+  Document::elementVector<AudioPackFormat>() {
+    return audioPackFormats_;
+  }
+  template <>
+  std::vector<std::shared_ptr<AudioChannelFormat>>&
+  Document::elementVector<AudioChannelFormat>() {
+    return audioChannelFormats_;
+  }
+  template <>
+  std::vector<std::shared_ptr<AudioStreamFormat>>&
+  Document::elementVector<AudioStreamFormat>() {
+    return audioStreamFormats_;
+  }
+  template <>
+  std::vector<std::shared_ptr<AudioTrackFormat>>&
+  Document::elementVector<AudioTrackFormat>() {
+    return audioTrackFormats_;
+  }
+  template <>
+  std::vector<std::shared_ptr<AudioTrackUid>>&
+  Document::elementVector<AudioTrackUid>() {
+    return audioTrackUids_;
+  }
+
+  template <typename Element>
+  void Document::idChanged(const Element& element,
+                           const typename Element::id_type& oldId) {
+    if (idChangesInProgress_) return;
+    idIndex_.get<Element>().rename(oldId, &element,
+                                   elementVector<Element>());
+  }
+
+  template void Document::idChanged(const AudioProgramme&,
+                                    const AudioProgrammeId&);
+  template void Document::idChanged(const AudioContent&,
+                                    const AudioContentId&);
+  template void Document::idChanged(const AudioObject&, const AudioObjectId&);
+  template void Document::idChanged(const AudioPackFormat&,
+                                    const AudioPackFormatId&);
+  template void Document::idChanged(const AudioChannelFormat&,
+                                    const AudioChannelFormatId&);
+  template void Document::idChanged(const AudioStreamFormat&,
+                                    const AudioStreamFormatId&);
+  template void Document::idChanged(const AudioTrackFormat&,
+                                    const AudioTrackFormatId&);
+  template void Document::idChanged(const AudioTrackUid&,
+                                    const AudioTrackUidId&);
+
+  namespace {
+    template <typename Element>
+    void rebuildIdIndex(detail::IdIndex<Element>& index,
+                        const std::vector<std::shared_ptr<Element>>& elements) {
+      index = detail::IdIndex<Element>();
+      index.reserve(elements.size());
+      for (auto& element : elements) index.add(element);
+    }
+  }  // namespace
+
+  void Document::beginIdChanges() {
+    // with an empty index, elements do not find that their new ID is in use
+    idChangesInProgress_ = true;
+    idIndex_ = {};
+  }
+
+  void Document::endIdChanges() {
+    idChangesInProgress_ = false;
+    rebuildIdIndex(idIndex_.get<AudioProgramme>(), audioProgrammes_);
+    rebuildIdIndex(idIndex_.get<AudioContent>(), audioContents_);
+    rebuildIdIndex(idIndex_.get<AudioObject>(), audioObjects_);
+    rebuildIdIndex(idIndex_.get<AudioPackFormat>(), audioPackFormats_);
+    rebuildIdIndex(idIndex_.get<AudioChannelFormat>(), audioChannelFormats_);
+    rebuildIdIndex(idIndex_.get<AudioStreamFormat>(), audioStreamFormats_);
+    rebuildIdIndex(idIndex_.get<AudioTrackFormat>(), audioTrackFormats_);
+    rebuildIdIndex(idIndex_.get<AudioTrackUid>(), audioTrackUids_);
+  }
+
+  // ---- add batches of elements ---- //
+  namespace {
+    template <typename Element>
+    using ElementPtrs = std::vector<std::shared_ptr<Element>>;
+
+    /// find the elements reachable from some roots which are not yet in a
+    /// document, in the order in which Document::add would add them
+    class BatchCollector : public boost::static_visitor<> {
+     public:
+      explicit BatchCollector(const Document* document)
+          : document_(document) {}
+
+      template <typename Element>
+      void operator()(const std::shared_ptr<Element>& element) {
+        visit(element);
+      }
+
+      detail::ForEachElement<ElementPtrs>& elements() { return elements_; }
+      std::size_t size() const { return visited_.size(); }
+
+     private:
+      void visit(const std::shared_ptr<AudioProgramme>& programme) {
+        if (!push(programme, "AudioProgramme")) return;
+        for (auto& reference : programme->getReferences<AudioContent>())
+          visit(reference);
+      }
+
+      void visit(const std::shared_ptr<AudioContent>& content) {
+        if (!push(content, "AudioContent")) return;
+        for (auto& reference : content->getReferences<AudioObject>())
+          visit(reference);
+      }
+
+      void visit(const std::shared_ptr<AudioObject>& object) {
+        if (!push(object, "AudioObject")) return;
+        for (auto& reference : object->getReferences<AudioObject>())
+          visit(reference);
+        for (auto& reference : object->getReferences<AudioPackFormat>())
+          visit(reference);
+        for (auto& reference : object->getReferences<AudioTrackUid>())
+          visit(reference);
+        for (auto& reference : object->getComplementaryObjects())
+          visit(reference);
+      }
+
+      void visit(const std::shared_ptr<AudioPackFormat>& packFormat) {
+        if (!push(packFormat, "AudioPackFormat")) return;
+        for (auto& reference : packFormat->getReferences<AudioPackFormat>())
+          visit(reference);
+        for (auto& reference : packFormat->getReferences<AudioChannelFormat>())
+          visit(reference);
+      }
+
+      void visit(const std::shared_ptr<AudioChannelFormat>& channelFormat) {
+        push(channelFormat, "AudioChannelFormat");
+      }
+
+      void visit(const std::shared_ptr<AudioStreamFormat>& streamFormat) {
+        if (!push(streamFormat, "AudioStreamFormat")) return;
+        if (auto reference = streamFormat->getReference<AudioChannelFormat>())
+          visit(reference);
+        if (auto reference = streamFormat->getReference<AudioPackFormat>())
+          visit(reference);
+        for (auto& weakReference :
+             streamFormat->getAudioTrackFormatReferences()) {
+          if (auto reference = weakReference.lock()) visit(reference);
+        }
+      }
+
+      void visit(const std::shared_ptr<AudioTrackFormat>& trackFormat) {
+        // as in Document::add, the AudioStreamFormat comes first, and may
+        // visit this AudioTrackFormat itself
+        if (visited_.count(trackFormat.get())) return;
+        if (auto reference = trackFormat->getReference<AudioStreamFormat>())
+          visit(reference);
+        push(trackFormat, "AudioTrackFormat");
+      }
+
+      void visit(const std::shared_ptr<AudioTrackUid>& trackUid) {
+        if (!push(trackUid, "AudioTrackUid")) return;
+        if (auto reference = trackUid->getReference<AudioTrackFormat>())
+          visit(reference);
+        if (auto reference = trackUid->getReference<AudioPackFormat>())
+          visit(reference);
+        if (auto reference = trackUid->getReference<AudioChannelFormat>())
+          visit(reference);
+      }
+
+      /// record element if it is new; returns false if it has already been
+      /// visited or is in the document, so its references should be skipped
+      template <typename Element>
+      bool push(const std::shared_ptr<Element>& element, const char* type) {
+        auto parent = element->getParent().lock();
+        if (parent && parent.get() != document_)
+          throw std::runtime_error(std::string{type} +
+                                   " already belongs to another Document");
+        if (parent || !visited_.insert(element.get()).second) return false;
+        elements_.get<Element>().push_back(element);
+        return true;
+      }
+
+      const Document* document_;
+      std::unordered_set<const void*> visited_;
+      detail::ForEachElement<ElementPtrs> elements_;
+    };
+
+    template <typename Element>
+    struct ParentAttorney;
+    template <>
+    struct ParentAttorney<AudioProgramme> {
+      using type = AudioProgrammeAttorney;
+    };
+    template <>
+    struct ParentAttorney<AudioContent> {
+      using type = AudioContentAttorney;
+    };
+    template <>
+    struct ParentAttorney<AudioObject> {
+      using type = AudioObjectAttorney;
+    };
+    template <>
+    struct ParentAttorney<AudioPackFormat> {
+      using type = AudioPackFormatAttorney;
+    };
+    template <>
+    struct ParentAttorney<AudioChannelFormat> {
+      using type = AudioChannelFormatAttorney;
+    };
+    template <>
+    struct ParentAttorney<AudioStreamFormat> {
+      using type = AudioStreamFormatAttorney;
+    };
+    template <>
+    struct ParentAttorney<AudioTrackFormat> {
+      using type = AudioTrackFormatAttorney;
+    };
+    template <>
+    struct ParentAttorney<AudioTrackUid> {
+      using type = AudioTrackUidAttorney;
+    };
+  }  // namespace
+
+  std::size_t Document::add(const std::vector<ElementVariant>& elements) {
+    BatchCollector collector(this);
+    for (auto& element : elements) boost::apply_visitor(collector, element);
+
+    // IDs of AudioTrackFormats depend on their AudioStreamFormat, which are
+    // added first; other IDs only depend on elements of the same type
+    auto& collected = collector.elements();
+    addBatch(collected.get<AudioProgramme>());
+    addBatch(collected.get<AudioContent>());
+    addBatch(collected.get<AudioObject>());
+    addBatch(collected.get<AudioPackFormat>());
+    addBatch(collected.get<AudioChannelFormat>());
+    addBatch(collected.get<AudioStreamFormat>());
+    addBatch(collected.get<AudioTrackFormat>());
+    addBatch(collected.get<AudioTrackUid>());
+    return collector.size();
+  }
+
+  template <typename Element>
+  void Document::addBatch(
+      const std::vector<std::shared_ptr<Element>>& elements) {
+    auto& vector = elementVector<Element>();
+    auto& index = idIndex_.get<Element>();
+    auto size = vector.size() + elements.size();
+    vector.reserve(size);
+    index.reserve(size);
+
+    auto self = shared_from_this();
+    for (auto& element : elements) {
+      idAssigner_.assignId(*element);
+      ParentAttorney<Element>::type::setParent(element, self);
+      vector.push_back(element);
+      index.add(element);
+    }
   }
 
   template <typename Element>
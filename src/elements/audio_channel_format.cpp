@@ -39,14 +39,16 @@ namespace adm {
   // ---- Setter ---- //
   void AudioChannelFormat::set(AudioChannelFormatId id) {
     if (isUndefined(id)) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
       return;
     }
     if (getParent().lock() != nullptr && getParent().lock()->lookup(id)) {
       throw std::runtime_error("id already in use");
     }
     if (id.get<TypeDescriptor>() == get<TypeDescriptor>()) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
       assignNewIdValue<AudioBlockFormatDirectSpeakers>();
       assignNewIdValue<AudioBlockFormatMatrix>();
       assignNewIdValue<AudioBlockFormatObjects>();
@@ -62,9 +64,13 @@ namespace adm {
     }
   }
   void AudioChannelFormat::set(AudioChannelFormatName name) {
+    contentHash_.invalidate();
     name_ = std::move(name);
   }
-  void AudioChannelFormat::set(Frequency frequency) { frequency_ = frequency; }
+  void AudioChannelFormat::set(Frequency frequency) {
+    contentHash_.invalidate();
+    frequency_ = frequency;
+  }
 
   // ---- Has ---- //
   bool AudioChannelFormat::has(
@@ -85,105 +91,111 @@ namespace adm {
 
   // ---- Unsetter ---- //
   void AudioChannelFormat::unset(detail::ParameterTraits<Frequency>::tag) {
+    contentHash_.invalidate();
     frequency_ = boost::none;
   }
 
   // ---- AudioBlocks ---- //
   void AudioChannelFormat::add(AudioBlockFormatDirectSpeakers blockFormat) {
-    if (audioBlockFormatsDirectSpeakers_.empty()) {
+    auto& blockFormats = audioBlockFormatsDirectSpeakers_.mut();
+    if (blockFormats.empty()) {
       assignId(blockFormat);
     } else {
-      assignId(blockFormat, &audioBlockFormatsDirectSpeakers_.back());
+      assignId(blockFormat, &blockFormats.back());
     }
-    audioBlockFormatsDirectSpeakers_.push_back(std::move(blockFormat));
+    blockFormats.push_back(std::move(blockFormat));
   }
   void AudioChannelFormat::add(AudioBlockFormatMatrix blockFormat) {
-    if (audioBlockFormatsMatrix_.empty()) {
+    auto& blockFormats = audioBlockFormatsMatrix_.mut();
+    if (blockFormats.empty()) {
       assignId(blockFormat);
     } else {
-      assignId(blockFormat, &audioBlockFormatsMatrix_.back());
+      assignId(blockFormat, &blockFormats.back());
     }
-    audioBlockFormatsMatrix_.push_back(std::move(blockFormat));
+    blockFormats.push_back(std::move(blockFormat));
   }
 
   void AudioChannelFormat::add(AudioBlockFormatObjects blockFormat) {
-    if (audioBlockFormatsObjects_.empty()) {
+    auto& blockFormats = audioBlockFormatsObjects_.mut();
+    if (blockFormats.empty()) {
       assignId(blockFormat);
     } else {
-      assignId(blockFormat, &audioBlockFormatsObjects_.back());
+      assignId(blockFormat, &blockFormats.back());
     }
-    audioBlockFormatsObjects_.push_back(std::move(blockFormat));
+    blockFormats.push_back(std::move(blockFormat));
   }
 
   void AudioChannelFormat::add(AudioBlockFormatHoa blockFormat) {
-    if (audioBlockFormatsHoa_.empty()) {
+    auto& blockFormats = audioBlockFormatsHoa_.mut();
+    if (blockFormats.empty()) {
       assignId(blockFormat);
     } else {
-      assignId(blockFormat, &audioBlockFormatsHoa_.back());
+      assignId(blockFormat, &blockFormats.back());
     }
-    audioBlockFormatsHoa_.push_back(std::move(blockFormat));
+    blockFormats.push_back(std::move(blockFormat));
   }
 
   void AudioChannelFormat::add(AudioBlockFormatBinaural blockFormat) {
-    if (audioBlockFormatsBinaural_.empty()) {
+    auto& blockFormats = audioBlockFormatsBinaural_.mut();
+    if (blockFormats.empty()) {
       assignId(blockFormat);
     } else {
-      assignId(blockFormat, &audioBlockFormatsBinaural_.back());
+      assignId(blockFormat, &blockFormats.back());
     }
-    audioBlockFormatsBinaural_.push_back(std::move(blockFormat));
+    blockFormats.push_back(std::move(blockFormat));
   }
 
   BlockFormatsConstRange<AudioBlockFormatDirectSpeakers>
   AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatDirectSpeakers>::tag) const {
-    return boost::make_iterator_range(audioBlockFormatsDirectSpeakers_.begin(),
-                                      audioBlockFormatsDirectSpeakers_.end());
+    const auto& blockFormats = audioBlockFormatsDirectSpeakers_.get();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
   BlockFormatsConstRange<AudioBlockFormatMatrix> AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatMatrix>::tag) const {
-    return boost::make_iterator_range(audioBlockFormatsMatrix_.begin(),
-                                      audioBlockFormatsMatrix_.end());
+    const auto& blockFormats = audioBlockFormatsMatrix_.get();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
   BlockFormatsConstRange<AudioBlockFormatObjects> AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatObjects>::tag) const {
-    return boost::make_iterator_range(audioBlockFormatsObjects_.begin(),
-                                      audioBlockFormatsObjects_.end());
+    const auto& blockFormats = audioBlockFormatsObjects_.get();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
   BlockFormatsConstRange<AudioBlockFormatHoa> AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatHoa>::tag) const {
-    return boost::make_iterator_range(audioBlockFormatsHoa_.begin(),
-                                      audioBlockFormatsHoa_.end());
+    const auto& blockFormats = audioBlockFormatsHoa_.get();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
   BlockFormatsConstRange<AudioBlockFormatBinaural> AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatBinaural>::tag) const {
-    return boost::make_iterator_range(audioBlockFormatsBinaural_.begin(),
-                                      audioBlockFormatsBinaural_.end());
+    const auto& blockFormats = audioBlockFormatsBinaural_.get();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
 
   BlockFormatsRange<AudioBlockFormatDirectSpeakers> AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatDirectSpeakers>::tag) {
-    return boost::make_iterator_range(audioBlockFormatsDirectSpeakers_.begin(),
-                                      audioBlockFormatsDirectSpeakers_.end());
+    auto& blockFormats = audioBlockFormatsDirectSpeakers_.mut();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
   BlockFormatsRange<AudioBlockFormatMatrix> AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatMatrix>::tag) {
-    return boost::make_iterator_range(audioBlockFormatsMatrix_.begin(),
-                                      audioBlockFormatsMatrix_.end());
+    auto& blockFormats = audioBlockFormatsMatrix_.mut();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
   BlockFormatsRange<AudioBlockFormatObjects> AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatObjects>::tag) {
-    return boost::make_iterator_range(audioBlockFormatsObjects_.begin(),
-                                      audioBlockFormatsObjects_.end());
+    auto& blockFormats = audioBlockFormatsObjects_.mut();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
   BlockFormatsRange<AudioBlockFormatHoa> AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatHoa>::tag) {
-    return boost::make_iterator_range(audioBlockFormatsHoa_.begin(),
-                                      audioBlockFormatsHoa_.end());
+    auto& blockFormats = audioBlockFormatsHoa_.mut();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
   BlockFormatsRange<AudioBlockFormatBinaural> AudioChannelFormat::get(
       detail::ParameterTraits<AudioBlockFormatBinaural>::tag) {
-    return boost::make_iterator_range(audioBlockFormatsBinaural_.begin(),
-                                      audioBlockFormatsBinaural_.end());
+    auto& blockFormats = audioBlockFormatsBinaural_.mut();
+    return boost::make_iterator_range(blockFormats.begin(), blockFormats.end());
   }
 
   void AudioChannelFormat::clearAudioBlockFormats() {
@@ -216,8 +228,19 @@ namespace adm {
   }
 
   std::shared_ptr<AudioChannelFormat> AudioChannelFormat::copy() const {
-    auto audioChannelFormatCopy =
-        std::shared_ptr<AudioChannelFormat>(new AudioChannelFormat(*this));
+    auto audioChannelFormatCopy = copySharingBlockFormats();
+    audioChannelFormatCopy->audioBlockFormatsDirectSpeakers_.unshare();
+    audioChannelFormatCopy->audioBlockFormatsMatrix_.unshare();
+    audioChannelFormatCopy->audioBlockFormatsObjects_.unshare();
+    audioChannelFormatCopy->audioBlockFormatsHoa_.unshare();
+    audioChannelFormatCopy->audioBlockFormatsBinaural_.unshare();
+    return audioChannelFormatCopy;
+  }
+
+  std::shared_ptr<AudioChannelFormat>
+  AudioChannelFormat::copySharingBlockFormats() const {
+    auto audioChannelFormatCopy = detail::makeElement<AudioChannelFormat>(
+        [&](void* storage) { return new (storage) AudioChannelFormat(*this); });
     audioChannelFormatCopy->setParent(std::weak_ptr<Document>());
     return audioChannelFormatCopy;
   }
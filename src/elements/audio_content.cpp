@@ -83,16 +83,22 @@ namespace adm {
   // ---- Setter ---- //
   void AudioContent::set(AudioContentId id) {
     if (isUndefined(id)) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
       return;
     }
     if (getParent().lock() != nullptr && getParent().lock()->lookup(id)) {
       throw std::runtime_error("id already in use");
     }
-    id_ = id;
+    auto oldId = std::exchange(id_, id);
+    DocumentAttorney::idChanged(*this, oldId);
+  }
+  void AudioContent::set(AudioContentName name) {
+    contentHash_.invalidate();
+    name_ = std::move(name);
   }
-  void AudioContent::set(AudioContentName name) { name_ = std::move(name); }
   void AudioContent::set(AudioContentLanguage language) {
+    contentHash_.invalidate();
     language_ = std::move(language);
   }
   void AudioContent::set(DialogueId id) {
@@ -110,6 +116,7 @@ namespace adm {
     }
   }
   void AudioContent::set(ContentKind kind) {
+    contentHash_.invalidate();
     if (kind.which() == 0) {
       set(boost::get<NonDialogueContentKind>(kind));
     } else if (kind.which() == 1) {
@@ -119,16 +126,19 @@ namespace adm {
     }
   }
   void AudioContent::set(NonDialogueContentKind kind) {
+    contentHash_.invalidate();
     unset<DialogueId>();
     nonDialogueContentKind_ = kind;
     dialogueId_ = Dialogue::NON_DIALOGUE;
   }
   void AudioContent::set(DialogueContentKind kind) {
+    contentHash_.invalidate();
     unset<DialogueId>();
     dialogueContentKind_ = kind;
     dialogueId_ = Dialogue::DIALOGUE;
   }
   void AudioContent::set(MixedContentKind kind) {
+    contentHash_.invalidate();
     unset<DialogueId>();
     mixedContentKind_ = kind;
     dialogueId_ = Dialogue::MIXED;
@@ -136,27 +146,33 @@ namespace adm {
 
   // ---- Unsetter ---- //
   void AudioContent::unset(detail::ParameterTraits<AudioContentLanguage>::tag) {
+    contentHash_.invalidate();
     language_ = boost::none;
   }
   void AudioContent::unset(detail::ParameterTraits<DialogueId>::tag) {
+    contentHash_.invalidate();
     dialogueId_ = boost::none;
     nonDialogueContentKind_ = boost::none;
     dialogueContentKind_ = boost::none;
     mixedContentKind_ = boost::none;
   }
   void AudioContent::unset(detail::ParameterTraits<ContentKind>::tag) {
+    contentHash_.invalidate();
     unset<NonDialogueContentKind>();
     unset<DialogueContentKind>();
     unset<MixedContentKind>();
   }
   void AudioContent::unset(
       detail::ParameterTraits<NonDialogueContentKind>::tag) {
+    contentHash_.invalidate();
     unset<DialogueId>();
   }
   void AudioContent::unset(detail::ParameterTraits<DialogueContentKind>::tag) {
+    contentHash_.invalidate();
     unset<DialogueId>();
   }
   void AudioContent::unset(detail::ParameterTraits<MixedContentKind>::tag) {
+    contentHash_.invalidate();
     unset<DialogueId>();
   }
 
@@ -235,8 +251,8 @@ namespace adm {
   }
 
   std::shared_ptr<AudioContent> AudioContent::copy() const {
-    auto audioContentCopy =
-        std::shared_ptr<AudioContent>(new AudioContent(*this));
+    auto audioContentCopy = detail::makeElement<AudioContent>(
+        [&](void* storage) { return new (storage) AudioContent(*this); });
     audioContentCopy->setParent(std::weak_ptr<Document>());
     audioContentCopy->disconnectReferences();
     return audioContentCopy;
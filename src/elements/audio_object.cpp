@@ -98,48 +98,77 @@ namespace adm {
   // ---- Setter ---- //
   void AudioObject::set(AudioObjectId id) {
     if (isUndefined(id)) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
       return;
     }
     if (getParent().lock() != nullptr && getParent().lock()->lookup(id)) {
       throw std::runtime_error("id already in use");
     }
-    id_ = id;
-  }
-  void AudioObject::set(AudioObjectName name) { name_ = std::move(name); }
-  void AudioObject::set(Start start) { start_ = start; }
-  void AudioObject::set(Duration duration) { duration_ = duration; }
-  void AudioObject::set(DialogueId id) { dialogueId_ = id; }
-  void AudioObject::set(Importance importance) { importance_ = importance; }
-  void AudioObject::set(Interact interact) { interact_ = interact; }
+    auto oldId = std::exchange(id_, id);
+    DocumentAttorney::idChanged(*this, oldId);
+  }
+  void AudioObject::set(AudioObjectName name) {
+    contentHash_.invalidate();
+    name_ = std::move(name);
+  }
+  void AudioObject::set(Start start) {
+    contentHash_.invalidate();
+    start_ = start;
+  }
+  void AudioObject::set(Duration duration) {
+    contentHash_.invalidate();
+    duration_ = duration;
+  }
+  void AudioObject::set(DialogueId id) {
+    contentHash_.invalidate();
+    dialogueId_ = id;
+  }
+  void AudioObject::set(Importance importance) {
+    contentHash_.invalidate();
+    importance_ = importance;
+  }
+  void AudioObject::set(Interact interact) {
+    contentHash_.invalidate();
+    interact_ = interact;
+  }
   void AudioObject::set(DisableDucking disableDucking) {
+    contentHash_.invalidate();
     disableDucking_ = disableDucking;
   }
   void AudioObject::set(AudioObjectInteraction audioObjectInteraction) {
+    contentHash_.invalidate();
     audioObjectInteraction_ = audioObjectInteraction;
   }
 
   // ---- Unsetter ---- //
   void AudioObject::unset(detail::ParameterTraits<Start>::tag) {
+    contentHash_.invalidate();
     start_ = boost::none;
   }
   void AudioObject::unset(detail::ParameterTraits<Duration>::tag) {
+    contentHash_.invalidate();
     duration_ = boost::none;
   }
   void AudioObject::unset(detail::ParameterTraits<DialogueId>::tag) {
+    contentHash_.invalidate();
     dialogueId_ = boost::none;
   }
   void AudioObject::unset(detail::ParameterTraits<Importance>::tag) {
+    contentHash_.invalidate();
     importance_ = boost::none;
   }
   void AudioObject::unset(detail::ParameterTraits<Interact>::tag) {
+    contentHash_.invalidate();
     interact_ = boost::none;
   }
   void AudioObject::unset(detail::ParameterTraits<DisableDucking>::tag) {
+    contentHash_.invalidate();
     disableDucking_ = boost::none;
   }
   void AudioObject::unset(
       detail::ParameterTraits<AudioObjectInteraction>::tag) {
+    contentHash_.invalidate();
     audioObjectInteraction_ = boost::none;
   }
 
@@ -350,7 +379,8 @@ namespace adm {
   }
 
   std::shared_ptr<AudioObject> AudioObject::copy() const {
-    auto audioObjectCopy = std::shared_ptr<AudioObject>(new AudioObject(*this));
+    auto audioObjectCopy = detail::makeElement<AudioObject>(
+        [&](void* storage) { return new (storage) AudioObject(*this); });
     audioObjectCopy->setParent(std::weak_ptr<Document>());
     audioObjectCopy->disconnectReferences();
     return audioObjectCopy;
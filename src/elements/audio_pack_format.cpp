@@ -36,14 +36,16 @@ namespace adm {
   // ---- Setter ---- //
   void AudioPackFormat::set(AudioPackFormatId id) {
     if (isUndefined(id)) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
       return;
     }
     if (getParent().lock() != nullptr && getParent().lock()->lookup(id)) {
       throw std::runtime_error("id already in use");
     }
     if (id.get<TypeDescriptor>() == get<TypeDescriptor>()) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
     } else {
       std::stringstream errorString;
       errorString << "mismatch between TypeDefinition of AudioPackFormat ("
@@ -53,9 +55,16 @@ namespace adm {
       throw std::runtime_error(errorString.str());
     }
   }
-  void AudioPackFormat::set(AudioPackFormatName name) { name_ = std::move(name); }
-  void AudioPackFormat::set(Importance importance) { importance_ = importance; }
+  void AudioPackFormat::set(AudioPackFormatName name) {
+    contentHash_.invalidate();
+    name_ = std::move(name);
+  }
+  void AudioPackFormat::set(Importance importance) {
+    contentHash_.invalidate();
+    importance_ = importance;
+  }
   void AudioPackFormat::set(AbsoluteDistance absoluteDistance) {
+    contentHash_.invalidate();
     absoluteDistance_ = absoluteDistance;
   }
 
@@ -82,9 +91,11 @@ namespace adm {
 
   // ---- Unsetter ---- //
   void AudioPackFormat::unset(detail::ParameterTraits<Importance>::tag) {
+    contentHash_.invalidate();
     importance_ = boost::none;
   }
   void AudioPackFormat::unset(detail::ParameterTraits<AbsoluteDistance>::tag) {
+    contentHash_.invalidate();
     absoluteDistance_ = boost::none;
   }
 
@@ -197,8 +208,8 @@ namespace adm {
   const std::weak_ptr<Document> &AudioPackFormat::getParent() const { return parent_; }
 
   std::shared_ptr<AudioPackFormat> AudioPackFormat::copy() const {
-    auto audioPackFormatCopy =
-        std::shared_ptr<AudioPackFormat>(new AudioPackFormat(*this));
+    auto audioPackFormatCopy = detail::makeElement<AudioPackFormat>(
+        [&](void* storage) { return new (storage) AudioPackFormat(*this); });
     audioPackFormatCopy->setParent(std::weak_ptr<Document>());
     audioPackFormatCopy->disconnectReferences();
     return audioPackFormatCopy;
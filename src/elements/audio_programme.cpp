@@ -82,42 +82,63 @@ namespace adm {
   // ---- Setter ---- //
   void AudioProgramme::set(AudioProgrammeId id) {
     if (isUndefined(id)) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
       return;
     }
     if (getParent().lock() != nullptr && getParent().lock()->lookup(id)) {
       throw std::runtime_error("id already in use");
     }
-    id_ = id;
+    auto oldId = std::exchange(id_, id);
+    DocumentAttorney::idChanged(*this, oldId);
   }
 
-  void AudioProgramme::set(AudioProgrammeName name) { name_ = std::move(name); }
+  void AudioProgramme::set(AudioProgrammeName name) {
+    contentHash_.invalidate();
+    name_ = std::move(name);
+  }
   void AudioProgramme::set(AudioProgrammeLanguage language) {
+    contentHash_.invalidate();
     language_ = std::move(language);
   }
-  void AudioProgramme::set(Start start) { start_ = start; }
-  void AudioProgramme::set(End end) { end_ = end; }
-  void AudioProgramme::set(MaxDuckingDepth depth) { maxDuckingDepth_ = depth; }
+  void AudioProgramme::set(Start start) {
+    contentHash_.invalidate();
+    start_ = start;
+  }
+  void AudioProgramme::set(End end) {
+    contentHash_.invalidate();
+    end_ = end;
+  }
+  void AudioProgramme::set(MaxDuckingDepth depth) {
+    contentHash_.invalidate();
+    maxDuckingDepth_ = depth;
+  }
   void AudioProgramme::set(AudioProgrammeReferenceScreen refScreen) {
+    contentHash_.invalidate();
     refScreen_ = refScreen;
   }
 
   // ---- Unsetter ---- //
   void AudioProgramme::unset(
       detail::ParameterTraits<AudioProgrammeLanguage>::tag) {
+    contentHash_.invalidate();
     language_ = boost::none;
   }
   void AudioProgramme::unset(detail::ParameterTraits<Start>::tag) {
+    contentHash_.invalidate();
     start_ = boost::none;
   }
   void AudioProgramme::unset(detail::ParameterTraits<End>::tag) {
+    contentHash_.invalidate();
     end_ = boost::none;
   }
   void AudioProgramme::unset(detail::ParameterTraits<MaxDuckingDepth>::tag) {
+    contentHash_.invalidate();
     maxDuckingDepth_ = boost::none;
   }
   void AudioProgramme::unset(
       detail::ParameterTraits<AudioProgrammeReferenceScreen>::tag) {
+    contentHash_.invalidate();
     refScreen_ = boost::none;
   }
 
@@ -188,8 +209,8 @@ namespace adm {
   };
 
   std::shared_ptr<AudioProgramme> AudioProgramme::copy() const {
-    auto audioProgrammeCopy =
-        std::shared_ptr<AudioProgramme>(new AudioProgramme(*this));
+    auto audioProgrammeCopy = detail::makeElement<AudioProgramme>(
+        [&](void* storage) { return new (storage) AudioProgramme(*this); });
     audioProgrammeCopy->setParent(std::weak_ptr<Document>());
     audioProgrammeCopy->disconnectReferences();
     return audioProgrammeCopy;
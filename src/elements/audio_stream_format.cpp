@@ -26,15 +26,18 @@ namespace adm {
   // ---- Setter ---- //
   void AudioStreamFormat::set(AudioStreamFormatId id) {
     if (isUndefined(id)) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
       return;
     }
     if (getParent().lock() != nullptr && getParent().lock()->lookup(id)) {
       throw std::runtime_error("id already in use");
     }
-    id_ = id;
+    auto oldId = std::exchange(id_, id);
+    DocumentAttorney::idChanged(*this, oldId);
   }
   void AudioStreamFormat::set(AudioStreamFormatName name) {
+    contentHash_.invalidate();
     name_ = std::move(name);
   }
 
@@ -193,8 +196,8 @@ namespace adm {
   }
 
   std::shared_ptr<AudioStreamFormat> AudioStreamFormat::copy() const {
-    auto audioStreamFormatCopy =
-        std::shared_ptr<AudioStreamFormat>(new AudioStreamFormat(*this));
+    auto audioStreamFormatCopy = detail::makeElement<AudioStreamFormat>(
+        [&](void* storage) { return new (storage) AudioStreamFormat(*this); });
     audioStreamFormatCopy->setParent(std::weak_ptr<Document>());
     audioStreamFormatCopy->disconnectReferences();
     return audioStreamFormatCopy;
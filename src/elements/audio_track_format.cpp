@@ -25,15 +25,18 @@ namespace adm {
   // ---- Setter ---- //
   void AudioTrackFormat::set(AudioTrackFormatId id) {
     if (isUndefined(id)) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
       return;
     }
     if (getParent().lock() != nullptr && getParent().lock()->lookup(id)) {
       throw std::runtime_error("id already in use");
     }
-    id_ = id;
+    auto oldId = std::exchange(id_, id);
+    DocumentAttorney::idChanged(*this, oldId);
   }
   void AudioTrackFormat::set(AudioTrackFormatName name) {
+    contentHash_.invalidate();
     name_ = std::move(name);
   }
 
@@ -125,8 +128,8 @@ namespace adm {
   }
 
   std::shared_ptr<AudioTrackFormat> AudioTrackFormat::copy() const {
-    auto audioTrackFormatCopy =
-        std::shared_ptr<AudioTrackFormat>(new AudioTrackFormat(*this));
+    auto audioTrackFormatCopy = detail::makeElement<AudioTrackFormat>(
+        [&](void* storage) { return new (storage) AudioTrackFormat(*this); });
     audioTrackFormatCopy->setParent(std::weak_ptr<Document>());
     audioTrackFormatCopy->disconnectReferences();
     return audioTrackFormatCopy;
@@ -17,13 +17,15 @@ namespace adm {
     trackUid = document->lookup(id);
     if (trackUid) return trackUid;
 
-    trackUid = std::shared_ptr<AudioTrackUid>(new AudioTrackUid());
+    trackUid = detail::makeElement<AudioTrackUid>(
+        [&](void* storage) { return new (storage) AudioTrackUid(); });
     trackUid->id_ = id;
     return trackUid;
   }
 
   std::shared_ptr<AudioTrackUid> AudioTrackUid::getSilent() {
-    auto uid = std::shared_ptr<AudioTrackUid>(new AudioTrackUid());
+    auto uid = detail::makeElement<AudioTrackUid>(
+        [&](void* storage) { return new (storage) AudioTrackUid(); });
     uid->set(AudioTrackUidId{AudioTrackUidIdValue{0}});
     return uid;
   }
@@ -44,7 +46,8 @@ namespace adm {
   // ---- Setter ---- //
   void AudioTrackUid::set(AudioTrackUidId id) {
     if (isUndefined(id)) {
-      id_ = id;
+      auto oldId = std::exchange(id_, id);
+      DocumentAttorney::idChanged(*this, oldId);
       return;
     }
     if (getParent().lock() != nullptr && getParent().lock()->lookup(id)) {
@@ -56,15 +59,18 @@ namespace adm {
          getReference<AudioChannelFormat>()))
       throw error::AdmGenericRuntimeError(
           "audioTrackUid with ID zero has no references or parameters");
-    id_ = id;
+    auto oldId = std::exchange(id_, id);
+    DocumentAttorney::idChanged(*this, oldId);
   }
   void AudioTrackUid::set(SampleRate sampleRate) {
+    contentHash_.invalidate();
     if (isSilent())
       throw error::AdmGenericRuntimeError(
           "audioTrackUid with ID zero has no references or parameters");
     sampleRate_ = sampleRate;
   }
   void AudioTrackUid::set(BitDepth bitDepth) {
+    contentHash_.invalidate();
     if (isSilent())
       throw error::AdmGenericRuntimeError(
           "audioTrackUid with ID zero has no references or parameters");
@@ -84,9 +90,11 @@ namespace adm {
 
   // ---- Unsetter ---- //
   void AudioTrackUid::unset(detail::ParameterTraits<BitDepth>::tag) {
+    contentHash_.invalidate();
     bitDepth_ = boost::none;
   }
   void AudioTrackUid::unset(detail::ParameterTraits<SampleRate>::tag) {
+    contentHash_.invalidate();
     sampleRate_ = boost::none;
   }
 
@@ -223,8 +231,8 @@ namespace adm {
   }
 
   std::shared_ptr<AudioTrackUid> AudioTrackUid::copy() const {
-    auto audioTrackUidCopy =
-        std::shared_ptr<AudioTrackUid>(new AudioTrackUid(*this));
+    auto audioTrackUidCopy = detail::makeElement<AudioTrackUid>(
+        [&](void* storage) { return new (storage) AudioTrackUid(*this); });
     audioTrackUidCopy->setParent(std::weak_ptr<Document>());
     audioTrackUidCopy->disconnectReferences();
     return audioTrackUidCopy;
@@ -0,0 +1,487 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <boost/variant.hpp>
+#include "adm/elements.hpp"
+#include "adm/detail/named_type.hpp"
+
+namespace adm {
+
+  // Content hashes are built from the public has<Parameter>() and
+  // get<Parameter>() methods, with the parameters of each type listed in a
+  // HashedParameters specialisation below. The hashed values do not depend on
+  // the platform or on the addresses of elements, so hashes can be stored
+  // and compared between runs.
+
+  namespace {
+
+    /// accumulates a 64-bit hash from a sequence of 64-bit words
+    class ContentHasher {
+     public:
+      void add(std::uint64_t value) { state_ = mix(state_ ^ value); }
+
+      std::uint64_t get() const { return state_; }
+
+     private:
+      /// the splitmix64 finaliser; every output bit depends on every input
+      /// bit, so the order of values matters
+      static std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9u;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebu;
+        x ^= x >> 31;
+        return x;
+      }
+
+      std::uint64_t state_ = 0xcbf29ce484222325u;
+    };
+
+    /// a list of parameters to hash; HashedParameters<T> derives from this
+    template <typename... Parameters>
+    struct ParameterList {};
+
+    /// the parameters of T which are included in its hash
+    template <typename T>
+    struct HashedParameters;
+
+    // ---- Values ---- //
+
+    void hashValue(ContentHasher& hasher, bool value);
+    void hashValue(ContentHasher& hasher, int value);
+    void hashValue(ContentHasher& hasher, unsigned int value);
+    void hashValue(ContentHasher& hasher, std::int64_t value);
+    void hashValue(ContentHasher& hasher, float value);
+    void hashValue(ContentHasher& hasher, double value);
+    void hashValue(ContentHasher& hasher, const std::string& value);
+    void hashValue(ContentHasher& hasher, std::chrono::nanoseconds value);
+    void hashValue(ContentHasher& hasher, const Time& value);
+    void hashValue(ContentHasher& hasher, const Gain& value);
+    template <typename T, typename Tag, typename Validator>
+    void hashValue(ContentHasher& hasher,
+                   const detail::NamedType<T, Tag, Validator>& value);
+    template <typename T>
+    void hashValue(ContentHasher& hasher, const std::vector<T>& values);
+    template <typename... Ts>
+    void hashValue(ContentHasher& hasher, const boost::variant<Ts...>& value);
+    template <typename T>
+    void hashValue(ContentHasher& hasher, const T& value);
+
+    void hashValue(ContentHasher& hasher, bool value) {
+      hasher.add(value ? 1 : 0);
+    }
+
+    void hashValue(ContentHasher& hasher, int value) {
+      hasher.add(static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+    }
+
+    void hashValue(ContentHasher& hasher, unsigned int value) {
+      hasher.add(value);
+    }
+
+    void hashValue(ContentHasher& hasher, std::int64_t value) {
+      hasher.add(static_cast<std::uint64_t>(value));
+    }
+
+    /// floats are hashed by their bits, so that values which compare equal
+    /// have the same hash, apart from NaNs which are all hashed the same
+    void hashValue(ContentHasher& hasher, double value) {
+      if (value == 0.0) value = 0.0;  // -0.0 == 0.0
+      if (std::isnan(value)) value = std::nan("");
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof bits);
+      hasher.add(bits);
+    }
+
+    void hashValue(ContentHasher& hasher, float value) {
+      hashValue(hasher, static_cast<double>(value));
+    }
+
+    void hashValue(ContentHasher& hasher, const std::string& value) {
+      hasher.add(value.size());
+      // pack the bytes into words explicitly, so that the hash does not depend
+      // on the byte order
+      for (std::size_t i = 0; i < value.size(); i += 8) {
+        std::uint64_t word = 0;
+        for (std::size_t j = i; j < value.size() && j < i + 8; j++)
+          word |= static_cast<std::uint64_t>(
+                      static_cast<unsigned char>(value[j]))
+                  << (8 * (j - i));
+        hasher.add(word);
+      }
+    }
+
+    void hashValue(ContentHasher& hasher, std::chrono::nanoseconds value) {
+      hashValue(hasher, static_cast<std::int64_t>(value.count()));
+    }
+
+    /// times are written differently depending on whether they are
+    /// fractional, so this is part of the hash
+    void hashValue(ContentHasher& hasher, const Time& value) {
+      hashValue(hasher, value.isFractional());
+      if (value.isFractional()) {
+        auto fractional = value.asFractional();
+        hashValue(hasher, static_cast<std::int64_t>(fractional.numerator()));
+        hashValue(hasher, static_cast<std::int64_t>(fractional.denominator()));
+      } else {
+        hashValue(hasher, value.asNanoseconds());
+      }
+    }
+
+    void hashValue(ContentHasher& hasher, const Gain& value) {
+      hashValue(hasher, value.isDb());
+      hashValue(hasher, value.isDb() ? value.asDb() : value.asLinear());
+    }
+
+    template <typename T, typename Tag, typename Validator>
+    void hashValue(ContentHasher& hasher,
+                   const detail::NamedType<T, Tag, Validator>& value) {
+      hashValue(hasher, value.get());
+    }
+
+    template <typename T>
+    void hashValue(ContentHasher& hasher, const std::vector<T>& values) {
+      hasher.add(values.size());
+      for (const auto& value : values) hashValue(hasher, value);
+    }
+
+    struct HashVariantVisitor : public boost::static_visitor<> {
+      explicit HashVariantVisitor(ContentHasher& hasher) : hasher(hasher) {}
+
+      template <typename T>
+      void operator()(const T& value) const {
+        hashValue(hasher, value);
+      }
+
+      ContentHasher& hasher;
+    };
+
+    template <typename... Ts>
+    void hashValue(ContentHasher& hasher, const boost::variant<Ts...>& value) {
+      hasher.add(static_cast<std::uint64_t>(value.which()));
+      boost::apply_visitor(HashVariantVisitor{hasher}, value);
+    }
+
+    /// hash one parameter of value, which may not be set
+    template <typename Parameter, typename T>
+    void hashParameter(ContentHasher& hasher, const T& value) {
+      if (value.template has<Parameter>()) {
+        hasher.add(1);
+        hashValue(hasher, value.template get<Parameter>());
+      } else {
+        hasher.add(0);
+      }
+    }
+
+    template <typename T, typename... Parameters>
+    void hashParameters(ContentHasher& hasher, const T& value,
+                        ParameterList<Parameters...>) {
+      // expand the pack in order; the array is only there for the expansion
+      int unused[] = {0, (hashParameter<Parameters>(hasher, value), 0)...};
+      (void)unused;
+    }
+
+    /// any other type is hashed using the parameters in its
+    /// HashedParameters specialisation
+    template <typename T>
+    void hashValue(ContentHasher& hasher, const T& value) {
+      hashParameters(hasher, value, HashedParameters<T>{});
+    }
+
+    // ---- Parameters of value types ---- //
+
+    // clang-format off
+    template <>
+    struct HashedParameters<ScreenEdgeLock>
+        : ParameterList<HorizontalEdge, VerticalEdge> {};
+    template <>
+    struct HashedParameters<SphericalPosition>
+        : ParameterList<Azimuth, Elevation, Distance, ScreenEdgeLock> {};
+    template <>
+    struct HashedParameters<CartesianPosition>
+        : ParameterList<X, Y, Z, ScreenEdgeLock> {};
+    template <>
+    struct HashedParameters<SphericalSpeakerPosition>
+        : ParameterList<Azimuth, AzimuthMin, AzimuthMax,
+                        Elevation, ElevationMin, ElevationMax,
+                        Distance, DistanceMin, DistanceMax, ScreenEdgeLock> {};
+    template <>
+    struct HashedParameters<CartesianSpeakerPosition>
+        : ParameterList<X, XMin, XMax, Y, YMin, YMax, Z, ZMin, ZMax,
+                        ScreenEdgeLock> {};
+    template <>
+    struct HashedParameters<SphericalPositionOffset>
+        : ParameterList<AzimuthOffset, ElevationOffset, DistanceOffset> {};
+    template <>
+    struct HashedParameters<CartesianPositionOffset>
+        : ParameterList<XOffset, YOffset, ZOffset> {};
+    template <>
+    struct HashedParameters<ChannelLock>
+        : ParameterList<ChannelLockFlag, MaxDistance> {};
+    template <>
+    struct HashedParameters<JumpPosition>
+        : ParameterList<JumpPositionFlag, InterpolationLength> {};
+    template <>
+    struct HashedParameters<ObjectDivergence>
+        : ParameterList<Divergence, AzimuthRange, PositionRange> {};
+    template <>
+    struct HashedParameters<HeadphoneVirtualise>
+        : ParameterList<Bypass, DirectToReverberantRatio> {};
+    template <>
+    struct HashedParameters<Frequency>
+        : ParameterList<HighPass, LowPass> {};
+    template <>
+    struct HashedParameters<Label>
+        : ParameterList<LabelValue, LabelLanguage> {};
+    template <>
+    struct HashedParameters<LoudnessMetadata>
+        : ParameterList<LoudnessMethod, LoudnessRecType,
+                        LoudnessCorrectionType, IntegratedLoudness,
+                        LoudnessRange, MaxTruePeak, MaxMomentary,
+                        MaxShortTerm, DialogueLoudness> {};
+    template <>
+    struct HashedParameters<GainInteractionRange>
+        : ParameterList<GainInteractionMin, GainInteractionMax> {};
+    template <>
+    struct HashedParameters<PositionInteractionRange>
+        : ParameterList<AzimuthInteractionMin, AzimuthInteractionMax,
+                        ElevationInteractionMin, ElevationInteractionMax,
+                        DistanceInteractionMin, DistanceInteractionMax,
+                        XInteractionMin, XInteractionMax,
+                        YInteractionMin, YInteractionMax,
+                        ZInteractionMin, ZInteractionMax> {};
+    template <>
+    struct HashedParameters<AudioObjectInteraction>
+        : ParameterList<OnOffInteract, GainInteract, PositionInteract,
+                        GainInteractionRange, PositionInteractionRange> {};
+    template <>
+    struct HashedParameters<AudioProgrammeReferenceScreen>
+        : ParameterList<> {};
+
+    // ---- IDs of referenced elements ---- //
+
+    template <>
+    struct HashedParameters<AudioProgrammeId>
+        : ParameterList<AudioProgrammeIdValue> {};
+    template <>
+    struct HashedParameters<AudioContentId>
+        : ParameterList<AudioContentIdValue> {};
+    template <>
+    struct HashedParameters<AudioObjectId>
+        : ParameterList<AudioObjectIdValue> {};
+    template <>
+    struct HashedParameters<AudioPackFormatId>
+        : ParameterList<TypeDescriptor, AudioPackFormatIdValue> {};
+    template <>
+    struct HashedParameters<AudioChannelFormatId>
+        : ParameterList<TypeDescriptor, AudioChannelFormatIdValue> {};
+    template <>
+    struct HashedParameters<AudioStreamFormatId>
+        : ParameterList<TypeDescriptor, AudioStreamFormatIdValue> {};
+    template <>
+    struct HashedParameters<AudioTrackFormatId>
+        : ParameterList<TypeDescriptor, AudioTrackFormatIdValue,
+                        AudioTrackFormatIdCounter> {};
+    template <>
+    struct HashedParameters<AudioTrackUidId>
+        : ParameterList<AudioTrackUidIdValue> {};
+
+    // ---- Elements ---- //
+
+    template <>
+    struct HashedParameters<AudioProgramme>
+        : ParameterList<AudioProgrammeName, AudioProgrammeLanguage, Start,
+                        End, MaxDuckingDepth, AudioProgrammeReferenceScreen,
+                        Labels, LoudnessMetadatas> {};
+    template <>
+    struct HashedParameters<AudioContent>
+        : ParameterList<AudioContentName, AudioContentLanguage, DialogueId,
+                        NonDialogueContentKind, DialogueContentKind,
+                        MixedContentKind, Labels, LoudnessMetadatas> {};
+    template <>
+    struct HashedParameters<AudioObject>
+        : ParameterList<AudioObjectName, Start, Duration, DialogueId,
+                        Importance, Interact, DisableDucking,
+                        AudioObjectInteraction, Gain, HeadLocked, Mute,
+                        PositionOffset, Labels,
+                        AudioComplementaryObjectGroupLabels> {};
+    template <>
+    struct HashedParameters<AudioPackFormat>
+        : ParameterList<AudioPackFormatName, TypeDescriptor, Importance,
+                        AbsoluteDistance> {};
+    template <>
+    struct HashedParameters<AudioPackFormatHoa>
+        : ParameterList<Normalization, NfcRefDist, ScreenRef> {};
+    template <>
+    struct HashedParameters<AudioChannelFormat>
+        : ParameterList<AudioChannelFormatName, TypeDescriptor, Frequency> {};
+    template <>
+    struct HashedParameters<AudioStreamFormat>
+        : ParameterList<AudioStreamFormatName, FormatDescriptor> {};
+    template <>
+    struct HashedParameters<AudioTrackFormat>
+        : ParameterList<AudioTrackFormatName, FormatDescriptor> {};
+    template <>
+    struct HashedParameters<AudioTrackUid>
+        : ParameterList<SampleRate, BitDepth> {};
+
+    // ---- Block formats ---- //
+
+    template <>
+    struct HashedParameters<AudioBlockFormatObjects>
+        : ParameterList<Rtime, Duration, InitializeBlock, Cartesian, Position,
+                        Width, Height, Depth, Diffuse, Gain, Importance,
+                        HeadphoneVirtualise, HeadLocked, ScreenRef,
+                        ChannelLock, ObjectDivergence, JumpPosition> {};
+    template <>
+    struct HashedParameters<AudioBlockFormatDirectSpeakers>
+        : ParameterList<Rtime, Duration, InitializeBlock, SpeakerLabels,
+                        SphericalSpeakerPosition, CartesianSpeakerPosition,
+                        Gain, Importance, HeadphoneVirtualise, HeadLocked> {};
+    template <>
+    struct HashedParameters<AudioBlockFormatMatrix>
+        : ParameterList<Rtime, Duration, InitializeBlock, Gain, Importance> {};
+    template <>
+    struct HashedParameters<AudioBlockFormatHoa>
+        : ParameterList<Rtime, Duration, InitializeBlock, Order, Degree,
+                        Normalization, NfcRefDist, Equation, Gain, Importance,
+                        HeadphoneVirtualise, HeadLocked, ScreenRef> {};
+    template <>
+    struct HashedParameters<AudioBlockFormatBinaural>
+        : ParameterList<Rtime, Duration, InitializeBlock, Gain, Importance> {};
+    // clang-format on
+
+    // ---- References ---- //
+
+    template <typename Element>
+    void hashReference(ContentHasher& hasher,
+                       const std::shared_ptr<Element>& element) {
+      if (element) {
+        hasher.add(1);
+        hashValue(hasher, element->template get<typename std::remove_const<
+                              Element>::type::id_type>());
+      } else {
+        hasher.add(0);
+      }
+    }
+
+    template <typename Range>
+    void hashReferences(ContentHasher& hasher, const Range& range) {
+      hasher.add(static_cast<std::uint64_t>(range.size()));
+      for (const auto& element : range) hashReference(hasher, element);
+    }
+
+    template <typename Range>
+    void hashWeakReferences(ContentHasher& hasher, const Range& range) {
+      hasher.add(static_cast<std::uint64_t>(range.size()));
+      for (const auto& element : range) hashReference(hasher, element.lock());
+    }
+
+    /// the hash of the parameters of element; this is what is cached
+    template <typename Element>
+    std::uint64_t parametersHash(const Element& element) {
+      ContentHasher hasher;
+      hashValue(hasher, element);
+      return hasher.get();
+    }
+
+    /// start hashing an element from the cached hash of its parameters
+    ContentHasher startHash(std::uint64_t parameters) {
+      ContentHasher hasher;
+      hasher.add(parameters);
+      return hasher;
+    }
+
+  }  // namespace
+
+  std::uint64_t AudioProgramme::contentHash() const {
+    auto hasher = startHash(
+        contentHash_.get([this]() { return parametersHash(*this); }));
+    hashReferences(hasher, getReferences<AudioContent>());
+    return hasher.get();
+  }
+
+  std::uint64_t AudioContent::contentHash() const {
+    auto hasher = startHash(
+        contentHash_.get([this]() { return parametersHash(*this); }));
+    hashReferences(hasher, getReferences<AudioObject>());
+    return hasher.get();
+  }
+
+  std::uint64_t AudioObject::contentHash() const {
+    auto hasher = startHash(
+        contentHash_.get([this]() { return parametersHash(*this); }));
+    hashReferences(hasher, getReferences<AudioObject>());
+    hashReferences(hasher, getReferences<AudioPackFormat>());
+    hashReferences(hasher, getReferences<AudioTrackUid>());
+    hashReferences(hasher, getComplementaryObjects());
+    return hasher.get();
+  }
+
+  std::uint64_t AudioPackFormat::contentHash() const {
+    auto hasher = startHash(
+        contentHash_.get([this]() { return parametersHash(*this); }));
+    // the extra parameters of AudioPackFormatHoa are not cached, as they are
+    // set through AudioPackFormatHoa
+    if (auto hoa = dynamic_cast<const AudioPackFormatHoa*>(this))
+      hashValue(hasher, *hoa);
+    hashReferences(hasher, getReferences<AudioChannelFormat>());
+    hashReferences(hasher, getReferences<AudioPackFormat>());
+    return hasher.get();
+  }
+
+  std::uint64_t AudioChannelFormat::contentHash() const {
+    return contentHash_.get([this]() { return parametersHash(*this); });
+  }
+
+  std::uint64_t AudioStreamFormat::contentHash() const {
+    auto hasher = startHash(
+        contentHash_.get([this]() { return parametersHash(*this); }));
+    hashReference(hasher, getReference<AudioChannelFormat>());
+    hashReference(hasher, getReference<AudioPackFormat>());
+    hashWeakReferences(hasher, getAudioTrackFormatReferences());
+    return hasher.get();
+  }
+
+  std::uint64_t AudioTrackFormat::contentHash() const {
+    auto hasher = startHash(
+        contentHash_.get([this]() { return parametersHash(*this); }));
+    hashReference(hasher, getReference<AudioStreamFormat>());
+    return hasher.get();
+  }
+
+  std::uint64_t AudioTrackUid::contentHash() const {
+    auto hasher = startHash(
+        contentHash_.get([this]() { return parametersHash(*this); }));
+    hashReference(hasher, getReference<AudioTrackFormat>());
+    hashReference(hasher, getReference<AudioChannelFormat>());
+    hashReference(hasher, getReference<AudioPackFormat>());
+    return hasher.get();
+  }
+
+  std::uint64_t AudioBlockFormatObjects::contentHash() const {
+    return parametersHash(*this);
+  }
+
+  std::uint64_t AudioBlockFormatDirectSpeakers::contentHash() const {
+    return parametersHash(*this);
+  }
+
+  std::uint64_t AudioBlockFormatMatrix::contentHash() const {
+    return parametersHash(*this);
+  }
+
+  std::uint64_t AudioBlockFormatHoa::contentHash() const {
+    return parametersHash(*this);
+  }
+
+  std::uint64_t AudioBlockFormatBinaural::contentHash() const {
+    return parametersHash(*this);
+  }
+
+}  // namespace adm
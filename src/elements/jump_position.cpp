@@ -1,6 +1,7 @@
 #include "adm/elements/jump_position.hpp"
 
 #include <iomanip>
+#include "adm/private/number_parser.hpp"
 
 namespace adm {
 
@@ -68,7 +69,9 @@ namespace adm {
     return jumpPosition.set(JumpPositionFlag(false));
   }
   InterpolationLength parseInterpolationLength(const std::string &length) {
-    auto floatTime = std::chrono::duration<float>(stof(length));
+    auto floatTime = std::chrono::duration<float>(
+        xml::detail::parseNumber<float>(length.data(),
+                                        length.data() + length.size()));
     return InterpolationLength(
         std::chrono::duration_cast<std::chrono::nanoseconds>(floatTime));
   }
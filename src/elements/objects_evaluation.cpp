@@ -0,0 +1,213 @@
+#include "adm/elements/objects_evaluation.hpp"
+#include <algorithm>
+#include "adm/elements/audio_channel_format.hpp"
+#include "adm/errors.hpp"
+
+namespace adm {
+
+  namespace {
+    /// the interpolated parameters, in the order they are stored in
+    /// BlockValues
+    enum Parameter {
+      AZIMUTH_OR_X,
+      ELEVATION_OR_Y,
+      DISTANCE_OR_Z,
+      GAIN,
+      WIDTH,
+      HEIGHT,
+      DEPTH,
+      DIFFUSE,
+      PARAMETER_COUNT
+    };
+
+    /// the destination array for each parameter
+    struct Destinations {
+      explicit Destinations(const ObjectsParameterBuffers& out)
+          : cartesian(out.cartesian) {
+        arrays[AZIMUTH_OR_X] = out.azimuthOrX;
+        arrays[ELEVATION_OR_Y] = out.elevationOrY;
+        arrays[DISTANCE_OR_Z] = out.distanceOrZ;
+        arrays[GAIN] = out.gain;
+        arrays[WIDTH] = out.width;
+        arrays[HEIGHT] = out.height;
+        arrays[DEPTH] = out.depth;
+        arrays[DIFFUSE] = out.diffuse;
+      }
+
+      float* arrays[PARAMETER_COUNT];
+      bool* cartesian;
+    };
+
+    /// the parameters of one block which are interpolated
+    struct BlockValues {
+      bool cartesian;
+      float values[PARAMETER_COUNT];
+    };
+
+    BlockValues blockValues(const AudioBlockFormatObjects& block) {
+      BlockValues result;
+      if (block.has<CartesianPosition>()) {
+        auto position = block.get<CartesianPosition>();
+        result.cartesian = true;
+        result.values[AZIMUTH_OR_X] = position.get<X>().get();
+        result.values[ELEVATION_OR_Y] = position.get<Y>().get();
+        result.values[DISTANCE_OR_Z] = position.get<Z>().get();
+      } else if (block.has<SphericalPosition>()) {
+        auto position = block.get<SphericalPosition>();
+        result.cartesian = false;
+        result.values[AZIMUTH_OR_X] = position.get<Azimuth>().get();
+        result.values[ELEVATION_OR_Y] = position.get<Elevation>().get();
+        result.values[DISTANCE_OR_Z] = position.get<Distance>().get();
+      } else {
+        result.cartesian = false;
+        result.values[AZIMUTH_OR_X] = 0.0f;
+        result.values[ELEVATION_OR_Y] = 0.0f;
+        result.values[DISTANCE_OR_Z] = 1.0f;
+      }
+      result.values[GAIN] = static_cast<float>(block.get<Gain>().asLinear());
+      result.values[WIDTH] = block.get<Width>().get();
+      result.values[HEIGHT] = block.get<Height>().get();
+      result.values[DEPTH] = block.get<Depth>().get();
+      result.values[DIFFUSE] = block.get<Diffuse>().get();
+      return result;
+    }
+
+    std::chrono::nanoseconds blockStart(const AudioBlockFormatObjects& block) {
+      return block.get<Rtime>().get().asNanoseconds();
+    }
+
+    std::chrono::nanoseconds interpolationLength(
+        const AudioBlockFormatObjects& block) {
+      auto jumpPosition = block.get<JumpPosition>();
+      if (jumpPosition.get<JumpPositionFlag>().get())
+        return jumpPosition.has<InterpolationLength>()
+                   ? jumpPosition.get<InterpolationLength>().get()
+                   : std::chrono::nanoseconds::zero();
+      if (block.has<Duration>())
+        return block.get<Duration>().get().asNanoseconds();
+      return std::chrono::nanoseconds::zero();
+    }
+
+    /// number of times evaluated per chunk; fractions for a chunk are kept
+    /// on the stack
+    const std::size_t chunkSize = 256;
+
+    /// out[i] = from + (to - from) * fractions[i]
+    void interpolate(float* out, float from, float to, const float* fractions,
+                     std::size_t count) {
+      float delta = to - from;
+      for (std::size_t i = 0; i < count; i++)
+        out[i] = from + delta * fractions[i];
+    }
+
+    void hold(const Destinations& out, const BlockValues& values,
+              std::size_t begin, std::size_t end) {
+      for (std::size_t p = 0; p < PARAMETER_COUNT; p++)
+        if (out.arrays[p])
+          std::fill(out.arrays[p] + begin, out.arrays[p] + end,
+                    values.values[p]);
+      if (out.cartesian)
+        std::fill(out.cartesian + begin, out.cartesian + end,
+                  values.cartesian);
+    }
+
+    void interpolate(const Destinations& out, const BlockValues& from,
+                     const BlockValues& to,
+                     const std::chrono::nanoseconds* times,
+                     std::chrono::nanoseconds start,
+                     std::chrono::nanoseconds length, std::size_t begin,
+                     std::size_t end) {
+      double scale = 1.0 / static_cast<double>(length.count());
+      float fractions[chunkSize];
+
+      for (std::size_t chunk = begin; chunk < end; chunk += chunkSize) {
+        std::size_t count = std::min(chunkSize, end - chunk);
+        for (std::size_t i = 0; i < count; i++)
+          fractions[i] = static_cast<float>(
+              static_cast<double>((times[chunk + i] - start).count()) * scale);
+
+        for (std::size_t p = 0; p < PARAMETER_COUNT; p++)
+          if (out.arrays[p])
+            interpolate(out.arrays[p] + chunk, from.values[p], to.values[p],
+                        fractions, count);
+      }
+      if (out.cartesian)
+        std::fill(out.cartesian + begin, out.cartesian + end, to.cartesian);
+    }
+
+    /// first index in [begin, end) with times[index] >= time
+    std::size_t firstTimeFrom(const std::chrono::nanoseconds* times,
+                              std::size_t begin, std::size_t end,
+                              std::chrono::nanoseconds time) {
+      return static_cast<std::size_t>(
+          std::lower_bound(times + begin, times + end, time) - times);
+    }
+  }  // namespace
+
+  void AudioChannelFormat::evaluateObjects(
+      const std::chrono::nanoseconds* times, std::size_t count,
+      const ObjectsParameterBuffers& out, BlockCursor& cursor) const {
+    auto blocks = getElements<AudioBlockFormatObjects>();
+    if (blocks.empty())
+      throw error::detail::formatElementRuntimeError(
+          get<AudioChannelFormatId>(),
+          "AudioChannelFormat has no AudioBlockFormatObjects");
+    if (count == 0) return;
+
+    Destinations destinations(out);
+    std::size_t size = blocks.size();
+    std::size_t index = std::min(cursor.index_, size - 1);
+
+    // times before the cursor must be searched for
+    if (index > 0 && times[0] < blockStart(blocks[index])) {
+      auto after =
+          std::partition_point(blocks.begin(), blocks.begin() + index,
+                               [&](const AudioBlockFormatObjects& block) {
+                                 return blockStart(block) <= times[0];
+                               });
+      index = after == blocks.begin()
+                  ? 0
+                  : static_cast<std::size_t>(after - blocks.begin()) - 1;
+    }
+
+    std::size_t begin = 0;
+    while (begin < count) {
+      // move to the last block starting at or before the next time
+      while (index + 1 < size && blockStart(blocks[index + 1]) <= times[begin])
+        index++;
+
+      // the times in this block
+      std::size_t end = index + 1 < size
+                            ? firstTimeFrom(times, begin, count,
+                                            blockStart(blocks[index + 1]))
+                            : count;
+
+      auto& block = blocks[index];
+      auto values = blockValues(block);
+      auto length = interpolationLength(block);
+      if (index > 0 && length.count() > 0) {
+        auto previous = blockValues(blocks[index - 1]);
+        if (previous.cartesian == values.cartesian) {
+          auto start = blockStart(block);
+          std::size_t interpolationEnd =
+              firstTimeFrom(times, begin, end, start + length);
+          interpolate(destinations, previous, values, times, start, length,
+                      begin, interpolationEnd);
+          begin = interpolationEnd;
+        }
+      }
+      hold(destinations, values, begin, end);
+      begin = end;
+    }
+
+    cursor.index_ = index;
+  }
+
+  void AudioChannelFormat::evaluateObjects(
+      const std::chrono::nanoseconds* times, std::size_t count,
+      const ObjectsParameterBuffers& out) const {
+    BlockCursor cursor;
+    evaluateObjects(times, count, out, cursor);
+  }
+
+}  // namespace adm
@@ -1,7 +1,7 @@
 #include "adm/elements/time.hpp"
 #include <boost/integer/common_factor.hpp>
-#include <iomanip>
-#include <regex>
+#include <cstdint>
+#include <limits>
 #include <sstream>
 
 namespace adm {
@@ -48,96 +48,168 @@ namespace adm {
     return boost::apply_visitor(AsFractionalVisitor(), time);
   }
 
-  Time parseTimecode(const std::string& timecode) {
-    const static std::regex commonFormat("(\\d{2}):(\\d{2}):(\\d{2}).(\\d+)");
-    const static std::regex fractionalFormat(
-        "(\\d{2}):(\\d{2}):(\\d{2}).(\\d+)S(\\d+)");
+  namespace {
+    bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    /// parse two digits at pos
+    bool parseTwoDigits(const std::string& str, std::size_t pos, int& value) {
+      if (!isDigit(str[pos]) || !isDigit(str[pos + 1])) return false;
+      value = 10 * (str[pos] - '0') + (str[pos + 1] - '0');
+      return true;
+    }
+
+    /// find the end of a non-empty run of digits starting at pos
+    bool skipDigits(const std::string& str, std::size_t pos,
+                    std::size_t& end) {
+      end = pos;
+      while (end < str.size() && isDigit(str[end])) end++;
+      return end != pos;
+    }
 
-    std::smatch timecodeMatch;
-    if (std::regex_match(timecode, timecodeMatch, commonFormat)) {
-      const std::string& ns_str = timecodeMatch[4];
+    /// parse the digits in [begin, end) as an int, with the same range
+    /// restriction as std::stoi
+    int parseInt(const std::string& timecode, std::size_t begin,
+                 std::size_t end) {
+      int64_t value = 0;
+      for (std::size_t i = begin; i < end; i++) {
+        value = 10 * value + (timecode[i] - '0');
+        if (value > std::numeric_limits<int>::max())
+          throw std::out_of_range("invalid timecode: " + timecode +
+                                  " is out of range");
+      }
+      return static_cast<int>(value);
+    }
 
+    [[noreturn]] void throwInvalidTimecode(const std::string& timecode) {
+      std::stringstream errorString;
+      errorString << "invalid timecode: " << timecode;
+      throw std::runtime_error(errorString.str());
+    }
+  }  // namespace
+
+  Time parseTimecode(const std::string& timecode) {
+    // timecodes have the form hh:mm:ss.fffff or hh:mm:ss.fffffSnnn, where
+    // the fractional part has at least one digit. To match the regular
+    // expressions this replaced, the '.' separator can be any character
+    // other than a line terminator.
+    int hours, minutes, seconds;
+    std::size_t fractionEnd;
+    if (timecode.size() < 10 || !parseTwoDigits(timecode, 0, hours) ||
+        timecode[2] != ':' || !parseTwoDigits(timecode, 3, minutes) ||
+        timecode[5] != ':' || !parseTwoDigits(timecode, 6, seconds) ||
+        timecode[8] == '\n' || timecode[8] == '\r' ||
+        !skipDigits(timecode, 9, fractionEnd))
+      throwInvalidTimecode(timecode);
+
+    if (fractionEnd == timecode.size()) {
       // parse number of nanoseconds as if it always had 9 digits
       int64_t ns = 0;
-      int64_t place_value = 1;
-      for (size_t i = 8; i != (size_t)-1; i--) {
-        if (i < ns_str.size()) ns += place_value * (ns_str[i] - '0');
-        place_value *= 10;
+      for (std::size_t i = 0; i < 9; i++) {
+        ns *= 10;
+        if (9 + i < fractionEnd) ns += timecode[9 + i] - '0';
       }
 
-      return std::chrono::hours(stoi(timecodeMatch[1])) +
-             std::chrono::minutes(stoi(timecodeMatch[2])) +
-             std::chrono::seconds(stoi(timecodeMatch[3])) +
-             std::chrono::nanoseconds(ns);
-    } else if (std::regex_match(timecode, timecodeMatch, fractionalFormat)) {
-      int64_t seconds = 3600 * stoi(timecodeMatch[1]) +
-                        60 * stoi(timecodeMatch[2]) +
-                        1 * stoi(timecodeMatch[3]);
-
-      int64_t numerator = stoi(timecodeMatch[4]);
-      int64_t denominator = stoi(timecodeMatch[5]);
-
-      if (denominator == 0) {
-        std::stringstream errorString;
-        errorString << "invalid timecode: " << timecode
-                    << " has a zero denominator";
-        throw std::runtime_error(errorString.str());
-      }
+      return std::chrono::hours(hours) + std::chrono::minutes(minutes) +
+             std::chrono::seconds(seconds) + std::chrono::nanoseconds(ns);
+    }
 
-      return FractionalTime{seconds * denominator + numerator, denominator};
-    } else {
+    std::size_t denominatorEnd;
+    if (timecode[fractionEnd] != 'S' ||
+        !skipDigits(timecode, fractionEnd + 1, denominatorEnd) ||
+        denominatorEnd != timecode.size())
+      throwInvalidTimecode(timecode);
+
+    int64_t totalSeconds = 3600 * hours + 60 * minutes + seconds;
+    int64_t numerator = parseInt(timecode, 9, fractionEnd);
+    int64_t denominator = parseInt(timecode, fractionEnd + 1, denominatorEnd);
+
+    if (denominator == 0) {
       std::stringstream errorString;
-      errorString << "invalid timecode: " << timecode;
+      errorString << "invalid timecode: " << timecode
+                  << " has a zero denominator";
       throw std::runtime_error(errorString.str());
     }
+
+    return FractionalTime{totalSeconds * denominator + numerator, denominator};
   }
 
-  struct FormatTimeVisitor : public boost::static_visitor<std::string> {
-    std::string operator()(const std::chrono::nanoseconds& time) const {
-      std::stringstream ss;
-      ss << std::setw(2) << std::setfill('0')
-         << std::chrono::duration_cast<std::chrono::hours>(time).count();
-      ss << ":";
-      ss << std::setw(2) << std::setfill('0')
-         << std::chrono::duration_cast<std::chrono::minutes>(time).count() % 60;
-      ss << ":";
-      ss << std::setw(2) << std::setfill('0')
-         << std::chrono::duration_cast<std::chrono::seconds>(time).count() % 60;
-      ss << ".";
-
-      {
+  namespace {
+    /// write value to out, padded with zeros to at least width characters
+    /// in the same way as `os << std::setw(width) << std::setfill('0')`
+    char* writeInt(char* out, int64_t value, int width = 0) {
+      char digits[20];
+      int count = 0;
+      // avoid negating value, which would overflow for the minimum value
+      uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value)
+                                     : static_cast<uint64_t>(value);
+      do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+      } while (magnitude);
+
+      int length = count + (value < 0 ? 1 : 0);
+      for (; length < width; length++) *out++ = '0';
+      if (value < 0) *out++ = '-';
+      while (count) *out++ = digits[--count];
+      return out;
+    }
+
+    struct FormatTimeVisitor : public boost::static_visitor<char*> {
+      explicit FormatTimeVisitor(char* out) : out(out) {}
+
+      char* operator()(const std::chrono::nanoseconds& time) const {
+        using std::chrono::duration_cast;
+        char* p = out;
+        p = writeInt(p, duration_cast<std::chrono::hours>(time).count(), 2);
+        *p++ = ':';
+        p = writeInt(p, duration_cast<std::chrono::minutes>(time).count() % 60,
+                     2);
+        *p++ = ':';
+        p = writeInt(p, duration_cast<std::chrono::seconds>(time).count() % 60,
+                     2);
+        *p++ = '.';
+
         auto ns = time.count() % 1000000000;
-        // drop trailing zero digits, while keeping at least 5 to satisfy BS.2076-2
+        // drop trailing zero digits, while keeping at least 5 to satisfy
+        // BS.2076-2
         int precision = 9;
         while (ns % 10 == 0 && precision > 5) {
           ns /= 10;
           precision--;
         }
-        ss << std::setw(precision) << std::setfill('0') << ns;
+        return writeInt(p, ns, precision);
       }
 
-      return ss.str();
-    }
+      char* operator()(const FractionalTime& time) const {
+        int64_t whole_seconds = time.numerator() / time.denominator();
+        int64_t frac_numerator =
+            time.numerator() - whole_seconds * time.denominator();
+
+        char* p = out;
+        p = writeInt(p, whole_seconds / 3600, 2);
+        *p++ = ':';
+        p = writeInt(p, (whole_seconds / 60) % 60, 2);
+        *p++ = ':';
+        p = writeInt(p, whole_seconds % 60, 2);
+        *p++ = '.';
+        p = writeInt(p, frac_numerator);
+        *p++ = 'S';
+        return writeInt(p, time.denominator());
+      }
 
-    std::string operator()(const FractionalTime& time) const {
-      int64_t whole_seconds = time.numerator() / time.denominator();
-      int64_t frac_numerator =
-          time.numerator() - whole_seconds * time.denominator();
-
-      std::stringstream ss;
-      ss << std::setw(2) << std::setfill('0') << whole_seconds / 3600;
-      ss << ":";
-      ss << std::setw(2) << std::setfill('0') << (whole_seconds / 60) % 60;
-      ss << ":";
-      ss << std::setw(2) << std::setfill('0') << whole_seconds % 60;
-      ss << ".";
-      ss << frac_numerator << "S" << time.denominator();
-      return ss.str();
-    }
-  };
+      char* out;
+    };
+  }  // namespace
+
+  std::size_t formatTimecode(const Time& time, char* buffer) {
+    char* end =
+        boost::apply_visitor(FormatTimeVisitor(buffer), time.asVariant());
+    return static_cast<std::size_t>(end - buffer);
+  }
 
   std::string formatTimecode(const Time& time) {
-    return boost::apply_visitor(FormatTimeVisitor(), time.asVariant());
+    char buffer[maxTimecodeLength];
+    return std::string(buffer, formatTimecode(time, buffer));
   }
 
 }  // namespace adm
@@ -60,11 +60,22 @@ namespace adm {
 
     XmlParsingUnresolvedReference::XmlParsingUnresolvedReference(
         const std::string& id)
-        : XmlParsingError(formatMessage(id)) {}
+        : XmlParsingUnresolvedReference(std::vector<std::string>{id}) {}
+
+    XmlParsingUnresolvedReference::XmlParsingUnresolvedReference(
+        std::vector<std::string> ids)
+        : XmlParsingError(formatMessage(ids)), ids_(std::move(ids)) {}
 
     std::string XmlParsingUnresolvedReference::formatMessage(
-        const std::string& id) {
-      return "Id " + id + " could not be resolved";
+        const std::vector<std::string>& ids) {
+      if (ids.size() == 1)
+        return "Id " + ids.front() + " could not be resolved";
+      std::string message = "Ids ";
+      for (std::size_t i = 0; i < ids.size(); i++) {
+        if (i) message += ", ";
+        message += ids[i];
+      }
+      return message + " could not be resolved";
     }
 
     XmlParsingUnexpectedAttrError::XmlParsingUnexpectedAttrError(
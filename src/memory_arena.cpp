@@ -0,0 +1,65 @@
+#include "adm/memory_arena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace adm {
+
+  constexpr std::size_t MemoryArena::defaultChunkSize;
+
+  MemoryArena::MemoryArena(std::size_t chunkSize)
+      : chunkSize_(std::max(chunkSize, std::size_t{1})) {}
+
+  std::shared_ptr<MemoryArena> MemoryArena::create(std::size_t chunkSize) {
+    return std::shared_ptr<MemoryArena>(new MemoryArena(chunkSize));
+  }
+
+  void* MemoryArena::allocate(std::size_t size, std::size_t alignment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto address = reinterpret_cast<std::uintptr_t>(current_);
+    std::size_t padding = (alignment - address % alignment) % alignment;
+    if (!current_ || padding + size > remaining_) {
+      // chunks from new[] are aligned for any fundamental type, so need no
+      // padding; allocations larger than a chunk get a chunk of their own
+      std::size_t chunkSize = std::max(chunkSize_, size);
+      chunks_.emplace_back(new char[chunkSize]);
+      current_ = chunks_.back().get();
+      remaining_ = chunkSize;
+      padding = 0;
+      stats_.chunks++;
+    }
+
+    void* result = current_ + padding;
+    current_ += padding + size;
+    remaining_ -= padding + size;
+    stats_.allocations++;
+    stats_.bytes += size;
+    return result;
+  }
+
+  MemoryArena::Stats MemoryArena::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+  namespace {
+    std::shared_ptr<MemoryArena>& currentArenaRef() {
+      static thread_local std::shared_ptr<MemoryArena> arena;
+      return arena;
+    }
+  }  // namespace
+
+  ArenaScope::ArenaScope(std::shared_ptr<MemoryArena> arena)
+      : previous_(std::move(currentArenaRef())) {
+    currentArenaRef() = std::move(arena);
+  }
+
+  ArenaScope::~ArenaScope() { currentArenaRef() = std::move(previous_); }
+
+  namespace detail {
+    const std::shared_ptr<MemoryArena>& currentArena() {
+      return currentArenaRef();
+    }
+  }  // namespace detail
+
+}  // namespace adm
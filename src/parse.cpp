@@ -2,28 +2,42 @@
 #include <memory>
 #include <string>
 #include "adm/common_definitions.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/private/document_parser.hpp"
 #include "adm/serial/frame_header_parser.hpp"
 
 namespace adm {
   class FrameHeader;
+
+  namespace {
+    /// create the document to parse into, containing the common definitions
+    std::shared_ptr<Document> createDocument(xml::ParserOptions options) {
+      if (static_cast<bool>(options & xml::ParserOptions::arena)) {
+        auto document = Document::create(MemoryArena::create());
+        addCommonDefinitionsTo(document);
+        return document;
+      }
+      return getCommonDefinitions();
+    }
+  }  // namespace
+
   std::shared_ptr<Document> parseXml(const std::string& filename,
                                      xml::ParserOptions options) {
-    auto commonDefinitions = getCommonDefinitions();
+    auto commonDefinitions = createDocument(options);
     xml::DocumentParser parser(filename, options, commonDefinitions);
     return parser.parse();
   }
 
   std::shared_ptr<Document> parseXml(std::istream& stream,
                                      xml::ParserOptions options) {
-    auto commonDefinitions = getCommonDefinitions();
+    auto commonDefinitions = createDocument(options);
     xml::DocumentParser parser(stream, options, commonDefinitions);
     return parser.parse();
   }
   std::shared_ptr<Document> parseXml(const std::string& filename,
                                      const FrameHeader& header,
                                      xml::ParserOptions options) {
-    auto commonDefinitions = getCommonDefinitions();
+    auto commonDefinitions = createDocument(options);
     xml::DocumentParser parser(filename, options, commonDefinitions);
     parser.setHeader(header);
     return parser.parse();
@@ -31,11 +45,25 @@ namespace adm {
   std::shared_ptr<Document> parseXml(std::istream& stream,
                                      const FrameHeader& header,
                                      xml::ParserOptions options) {
-    auto commonDefinitions = getCommonDefinitions();
+    auto commonDefinitions = createDocument(options);
     xml::DocumentParser parser(stream, options, commonDefinitions);
     parser.setHeader(header);
     return parser.parse();
   }
+  std::shared_ptr<Document> parseXml(const char* data, std::size_t size,
+                                     xml::ParserOptions options) {
+    auto commonDefinitions = createDocument(options);
+    xml::DocumentParser parser(data, size, options, commonDefinitions);
+    return parser.parse();
+  }
+  std::shared_ptr<Document> parseXml(const char* data, std::size_t size,
+                                     const FrameHeader& header,
+                                     xml::ParserOptions options) {
+    auto commonDefinitions = createDocument(options);
+    xml::DocumentParser parser(data, size, options, commonDefinitions);
+    parser.setHeader(header);
+    return parser.parse();
+  }
 
   FrameHeader parseFrameHeader(std::istream& stream,
                                xml::ParserOptions options) {
@@ -48,4 +76,10 @@ namespace adm {
     xml::FrameHeaderParser parser(fileName, options);
     return parser.parse();
   }
+
+  FrameHeader parseFrameHeader(const char* data, std::size_t size,
+                               xml::ParserOptions options) {
+    xml::FrameHeaderParser parser(data, size, options);
+    return parser.parse();
+  }
 }  // namespace adm
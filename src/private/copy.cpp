@@ -4,94 +4,120 @@
 namespace adm {
 
   struct ElementMapping {
-    // clang-format off
-    std::unordered_map<std::shared_ptr<const AudioProgramme>, std::shared_ptr<AudioProgramme>> audioProgramme;
-    std::unordered_map<std::shared_ptr<const AudioContent>, std::shared_ptr<AudioContent>> audioContent;
-    std::unordered_map<std::shared_ptr<const AudioObject>, std::shared_ptr<AudioObject>> audioObject;
-    std::unordered_map<std::shared_ptr<const AudioPackFormat>, std::shared_ptr<AudioPackFormat>> audioPackFormat;
-    std::unordered_map<std::shared_ptr<const AudioChannelFormat>, std::shared_ptr<AudioChannelFormat>> audioChannelFormat;
-    std::unordered_map<std::shared_ptr<const AudioStreamFormat>, std::shared_ptr<AudioStreamFormat>> audioStreamFormat;
-    std::unordered_map<std::shared_ptr<const AudioTrackFormat>, std::shared_ptr<AudioTrackFormat>> audioTrackFormat;
-    std::unordered_map<std::shared_ptr<const AudioTrackUid>, std::shared_ptr<AudioTrackUid>> audioTrackUid;
-    // clang-format on
+    ElementCopies<AudioProgramme> audioProgramme;
+    ElementCopies<AudioContent> audioContent;
+    ElementCopies<AudioObject> audioObject;
+    ElementCopies<AudioPackFormat> audioPackFormat;
+    ElementCopies<AudioChannelFormat> audioChannelFormat;
+    ElementCopies<AudioStreamFormat> audioStreamFormat;
+    ElementCopies<AudioTrackFormat> audioTrackFormat;
+    ElementCopies<AudioTrackUid> audioTrackUid;
   };
 
+  namespace {
+    struct CopyElement {
+      template <typename Element>
+      std::shared_ptr<Element> operator()(const Element& element) const {
+        return element.copy();
+      }
+    };
+
+    template <typename Element>
+    void appendCopies(std::vector<ElementVariant>& elements,
+                      const ElementCopies<Element>& copies) {
+      elements.insert(elements.end(), copies.copies().begin(),
+                      copies.copies().end());
+    }
+  }  // namespace
+
   std::vector<ElementVariant> copyAllElements(
-      std::shared_ptr<const Document> document) {
-    ElementMapping mapping;
-    std::vector<ElementVariant> copiedElements;
+      std::shared_ptr<const Document> document, CopyOptions options) {
+    bool shareBlockFormats =
+        (options & CopyOptions::share_block_formats) != CopyOptions::none;
+    auto programmes = document->getElements<AudioProgramme>();
+    auto contents = document->getElements<AudioContent>();
+    auto objects = document->getElements<AudioObject>();
+    auto packFormats = document->getElements<AudioPackFormat>();
+    auto channelFormats = document->getElements<AudioChannelFormat>();
+    auto streamFormats = document->getElements<AudioStreamFormat>();
+    auto trackFormats = document->getElements<AudioTrackFormat>();
+    auto trackUids = document->getElements<AudioTrackUid>();
+
     // copy
-    for (const auto& element : document->getElements<AudioProgramme>()) {
-      mapping.audioProgramme[element] = element->copy();
-      copiedElements.push_back(mapping.audioProgramme.at(element));
-    }
-    for (const auto& element : document->getElements<AudioContent>()) {
-      mapping.audioContent[element] = element->copy();
-      copiedElements.push_back(mapping.audioContent.at(element));
-    }
-    for (const auto& element : document->getElements<AudioObject>()) {
-      mapping.audioObject[element] = element->copy();
-      copiedElements.push_back(mapping.audioObject.at(element));
-    }
-    for (const auto& element : document->getElements<AudioPackFormat>()) {
-      mapping.audioPackFormat[element] = element->copy();
-      copiedElements.push_back(mapping.audioPackFormat.at(element));
-    }
-    for (const auto& element : document->getElements<AudioChannelFormat>()) {
-      mapping.audioChannelFormat[element] = element->copy();
-      copiedElements.push_back(mapping.audioChannelFormat.at(element));
-    }
-    for (const auto& element : document->getElements<AudioStreamFormat>()) {
-      mapping.audioStreamFormat[element] = element->copy();
-      copiedElements.push_back(mapping.audioStreamFormat.at(element));
-    }
-    for (const auto& element : document->getElements<AudioTrackFormat>()) {
-      mapping.audioTrackFormat[element] = element->copy();
-      copiedElements.push_back(mapping.audioTrackFormat.at(element));
-    }
-    for (const auto& element : document->getElements<AudioTrackUid>()) {
-      mapping.audioTrackUid[element] = element->copy();
-      copiedElements.push_back(mapping.audioTrackUid.at(element));
-    }
+    ElementMapping mapping;
+    mapping.audioProgramme.copy(programmes, CopyElement());
+    mapping.audioContent.copy(contents, CopyElement());
+    mapping.audioObject.copy(objects, CopyElement());
+    mapping.audioPackFormat.copy(packFormats, CopyElement());
+    if (shareBlockFormats)
+      mapping.audioChannelFormat.copy(
+          channelFormats, [](const AudioChannelFormat& element) {
+            return element.copySharingBlockFormats();
+          });
+    else
+      mapping.audioChannelFormat.copy(channelFormats, CopyElement());
+    mapping.audioStreamFormat.copy(streamFormats, CopyElement());
+    mapping.audioTrackFormat.copy(trackFormats, CopyElement());
+    mapping.audioTrackUid.copy(trackUids, CopyElement());
 
     // resolve
-    for (const auto& element : document->getElements<AudioProgramme>()) {
-      resolveReferences(element, mapping.audioProgramme, mapping.audioContent);
+    for (std::size_t i = 0; i < programmes.size(); i++) {
+      auto& element = *programmes[i];
+      auto& copy = mapping.audioProgramme[i];
+      resolveReferences(element, copy, mapping.audioContent);
     }
-    for (const auto& element : document->getElements<AudioContent>()) {
-      resolveReferences(element, mapping.audioContent, mapping.audioObject);
+    for (std::size_t i = 0; i < contents.size(); i++) {
+      auto& element = *contents[i];
+      auto& copy = mapping.audioContent[i];
+      resolveReferences(element, copy, mapping.audioObject);
     }
-    for (const auto& element : document->getElements<AudioObject>()) {
-      resolveReferences(element, mapping.audioObject, mapping.audioObject);
-      resolveReferences(element, mapping.audioObject, mapping.audioPackFormat);
-      resolveReferences(element, mapping.audioObject, mapping.audioTrackUid);
-      resolveComplementaries(element, mapping.audioObject, mapping.audioObject);
+    for (std::size_t i = 0; i < objects.size(); i++) {
+      auto& element = *objects[i];
+      auto& copy = mapping.audioObject[i];
+      resolveReferences(element, copy, mapping.audioObject);
+      resolveReferences(element, copy, mapping.audioPackFormat);
+      resolveReferences(element, copy, mapping.audioTrackUid);
+      resolveComplementaries(element, copy, mapping.audioObject);
     }
-    for (const auto& element : document->getElements<AudioPackFormat>()) {
-      resolveReferences(element, mapping.audioPackFormat,
-                        mapping.audioPackFormat);
-      resolveReferences(element, mapping.audioPackFormat,
-                        mapping.audioChannelFormat);
+    for (std::size_t i = 0; i < packFormats.size(); i++) {
+      auto& element = *packFormats[i];
+      auto& copy = mapping.audioPackFormat[i];
+      resolveReferences(element, copy, mapping.audioPackFormat);
+      resolveReferences(element, copy, mapping.audioChannelFormat);
     }
-    for (const auto& element : document->getElements<AudioStreamFormat>()) {
-      resolveReference(element, mapping.audioStreamFormat,
-                       mapping.audioPackFormat);
-      resolveReference(element, mapping.audioStreamFormat,
-                       mapping.audioChannelFormat);
-      resolveReferences(element, mapping.audioStreamFormat,
-                        mapping.audioTrackFormat);
+    for (std::size_t i = 0; i < streamFormats.size(); i++) {
+      auto& element = *streamFormats[i];
+      auto& copy = mapping.audioStreamFormat[i];
+      resolveReference(element, copy, mapping.audioPackFormat);
+      resolveReference(element, copy, mapping.audioChannelFormat);
+      resolveReferences(element, copy, mapping.audioTrackFormat);
     }
-    for (const auto& element : document->getElements<AudioTrackFormat>()) {
-      resolveReference(element, mapping.audioTrackFormat,
-                       mapping.audioStreamFormat);
+    for (std::size_t i = 0; i < trackFormats.size(); i++) {
+      auto& element = *trackFormats[i];
+      auto& copy = mapping.audioTrackFormat[i];
+      resolveReference(element, copy, mapping.audioStreamFormat);
     }
-    for (const auto& element : document->getElements<AudioTrackUid>()) {
-      resolveReference(element, mapping.audioTrackUid,
-                       mapping.audioTrackFormat);
-      resolveReference(element, mapping.audioTrackUid, mapping.audioPackFormat);
-      resolveReference(element, mapping.audioTrackUid,
-                       mapping.audioChannelFormat);
+    for (std::size_t i = 0; i < trackUids.size(); i++) {
+      auto& element = *trackUids[i];
+      auto& copy = mapping.audioTrackUid[i];
+      resolveReference(element, copy, mapping.audioTrackFormat);
+      resolveReference(element, copy, mapping.audioPackFormat);
+      resolveReference(element, copy, mapping.audioChannelFormat);
     }
+
+    std::vector<ElementVariant> copiedElements;
+    copiedElements.reserve(programmes.size() + contents.size() +
+                           objects.size() + packFormats.size() +
+                           channelFormats.size() + streamFormats.size() +
+                           trackFormats.size() + trackUids.size());
+    appendCopies(copiedElements, mapping.audioProgramme);
+    appendCopies(copiedElements, mapping.audioContent);
+    appendCopies(copiedElements, mapping.audioObject);
+    appendCopies(copiedElements, mapping.audioPackFormat);
+    appendCopies(copiedElements, mapping.audioChannelFormat);
+    appendCopies(copiedElements, mapping.audioStreamFormat);
+    appendCopies(copiedElements, mapping.audioTrackFormat);
+    appendCopies(copiedElements, mapping.audioTrackUid);
     return copiedElements;
   }
 
@@ -1,5 +1,9 @@
 #include "adm/private/document_parser.hpp"
+#include <cstring>
+#include <exception>
+#include <fstream>
 #include "adm/common_definitions.hpp"
+#include "adm/private/parallel_for.hpp"
 #include "adm/private/xml_parser_helper.hpp"
 #include "adm/detail/named_type_validators.hpp"
 #include "adm/errors.hpp"
@@ -17,23 +21,42 @@ namespace adm {
       return static_cast<bool>(options & flag);
     }
 
-    DocumentParser::DocumentParser(rapidxml::file<> file, ParserOptions options,
-                                   std::shared_ptr<Document> destDocument)
-        : xmlFile_(std::move(file)),
-          options_(options),
-          document_(destDocument),
-          idMap_(*destDocument) {}
-
     DocumentParser::DocumentParser(const std::string& filename,
                                    ParserOptions options,
                                    std::shared_ptr<Document> destDocument)
-        : DocumentParser(rapidxml::file<>{filename.c_str()}, options,
-                         std::move(destDocument)) {}
+        : options_(options), document_(destDocument), idMap_(*destDocument) {
+      if (isSet(options_, ParserOptions::incremental)) {
+        fileStream_.reset(new std::ifstream(filename, std::ios::binary));
+        if (!*fileStream_)
+          throw std::runtime_error("cannot open file " + filename);
+        stream_ = fileStream_.get();
+      } else if (isSet(options_, ParserOptions::memory_map)) {
+        input_ = XmlInput::mapFile(filename);
+      } else {
+        input_ = XmlInput::readFile(filename);
+      }
+    }
 
     DocumentParser::DocumentParser(std::istream& stream, ParserOptions options,
                                    std::shared_ptr<Document> destDocument)
-        : DocumentParser(rapidxml::file<>{stream}, options,
-                         std::move(destDocument)) {}
+        : options_(options), document_(destDocument), idMap_(*destDocument) {
+      if (isSet(options_, ParserOptions::incremental))
+        stream_ = &stream;
+      else
+        input_ = XmlInput::readStream(stream);
+    }
+
+    DocumentParser::DocumentParser(const char* data, std::size_t size,
+                                   ParserOptions options,
+                                   std::shared_ptr<Document> destDocument)
+        : options_(options), document_(destDocument), idMap_(*destDocument) {
+      if (isSet(options_, ParserOptions::incremental)) {
+        fileStream_.reset(new MemoryInputStream(data, size));
+        stream_ = fileStream_.get();
+      } else {
+        input_ = XmlInput::copyBuffer(data, size);
+      }
+    }
 
     template <typename Element>
     void DocumentParser::add(std::shared_ptr<Element> el) {
@@ -42,8 +65,12 @@ namespace adm {
     }
 
     std::shared_ptr<Document> DocumentParser::parse() {
+      // allocate elements from the document's arena, if it has one
+      ArenaScope arenaScope(document_->getArena());
+      if (stream_) return parseIncremental();
+
       rapidxml::xml_document<> xmlDocument;
-      xmlDocument.parse<0>(xmlFile_.data());
+      xmlDocument.parse<0>(input_.data());
 
       if (!xmlDocument.first_node())
         throw error::XmlParsingError("xml document is empty");
@@ -64,52 +91,15 @@ namespace adm {
       if (root) {
         setOptionalAttribute<Version>(root, "version", document_);
         // add ADM elements to ADM document
-        for (NodePtr node = root->first_node(); node;
-             node = node->next_sibling()) {
-          std::string nodeName(node->name(), node->name_size());
-
-          if (nodeName == "audioProgramme") {
-            add(parseAudioProgramme(node));
-          } else if (nodeName == "audioContent") {
-            add(parseAudioContent(node));
-          } else if (nodeName == "audioObject") {
-            add(parseAudioObject(node));
-          } else if (nodeName == "audioTrackUID") {
-            add(parseAudioTrackUid(node));
-          } else if (nodeName == "audioPackFormat") {
-            add(parseAudioPackFormat(node));
-          } else if (nodeName == "audioChannelFormat") {
-            add(parseAudioChannelFormat(node));
-          } else if (nodeName == "audioStreamFormat") {
-            add(parseAudioStreamFormat(node));
-          } else if (nodeName == "audioTrackFormat") {
-            add(parseAudioTrackFormat(node));
-          }
-        }
-        resolveReferences(programmeContentRefs_);
-        resolveReferences(contentObjectRefs_);
-        resolveReferences(objectObjectRefs_);
-        // resolve complementary object references
-        for (auto& entry : objectComplementaryObjectRefs_) {
-          for (const auto& id : entry.second) {
-            if (auto element = document_->lookup(id)) {
-              entry.first->addComplementary(element);
-            } else {
-              throw error::XmlParsingUnresolvedReference(formatId(id));
-            }
+        if (isSet(options_, ParserOptions::parallel)) {
+          parseElementsParallel(root);
+        } else {
+          for (NodePtr node = root->first_node(); node;
+               node = node->next_sibling()) {
+            parseElement(node);
           }
         }
-        resolveReferences(objectPackFormatRefs_);
-        resolveTrackUidReferences(objectTrackUidRefs_);
-        resolveReference(trackUidTrackFormatRef_);
-        resolveReference(trackUidChannelFormatRef_);
-        resolveReference(trackUidPackFormatRef_);
-        resolveReferences(packFormatChannelFormatRefs_);
-        resolveReferences(packFormatPackFormatRefs_);
-        resolveReference(trackFormatStreamFormatRef_);
-        resolveReference(streamFormatChannelFormatRef_);
-        resolveReference(streamFormatPackFormatRef_);
-        resolveReferences(streamFormatTrackFormatRefs_);
+        resolveAllReferences();
 
       } else {
         throw error::XmlParsingError("audioFormatExtended node not found");
@@ -117,6 +107,237 @@ namespace adm {
       return document_;
     }
 
+    void DocumentParser::parseElement(NodePtr node) {
+      std::string nodeName(node->name(), node->name_size());
+
+      if (nodeName == "audioProgramme") {
+        add(parseAudioProgramme(node));
+      } else if (nodeName == "audioContent") {
+        add(parseAudioContent(node));
+      } else if (nodeName == "audioObject") {
+        add(parseAudioObject(node));
+      } else if (nodeName == "audioTrackUID") {
+        add(parseAudioTrackUid(node));
+      } else if (nodeName == "audioPackFormat") {
+        add(parseAudioPackFormat(node));
+      } else if (nodeName == "audioChannelFormat") {
+        add(parseAudioChannelFormat(node));
+      } else if (nodeName == "audioStreamFormat") {
+        add(parseAudioStreamFormat(node));
+      } else if (nodeName == "audioTrackFormat") {
+        add(parseAudioTrackFormat(node));
+      }
+    }
+
+    /**
+     * audioChannelFormats, which hold nearly all of the data in large
+     * documents, only depend on their own sub-tree, so they are converted on
+     * a pool of threads first. The results are then added to the document in
+     * document order, interleaved with the other elements, which are
+     * converted on this thread as they would be by parse(). Those record
+     * references in the parser for later resolution, so are not converted in
+     * parallel.
+     *
+     * Errors are reported in document order, so the exception thrown is the
+     * same as for a sequential parse.
+     */
+    void DocumentParser::parseElementsParallel(NodePtr root) {
+      std::vector<NodePtr> nodes;
+      std::vector<std::size_t> channelIndices;
+      for (NodePtr node = root->first_node(); node;
+           node = node->next_sibling()) {
+        if (std::strcmp(node->name(), "audioChannelFormat") == 0)
+          channelIndices.push_back(nodes.size());
+        nodes.push_back(node);
+      }
+
+      std::vector<std::shared_ptr<AudioChannelFormat>> channels(nodes.size());
+      std::vector<std::exception_ptr> errors(nodes.size());
+      // errors are kept to be thrown in document order, rather than thrown
+      // by parallelFor, as other elements may have errors before them
+      ::adm::detail::parallelFor(channelIndices.size(), [&](std::size_t i) {
+        ArenaScope arenaScope(document_->getArena());
+        std::size_t index = channelIndices[i];
+        try {
+          channels[index] = parseAudioChannelFormat(nodes[index]);
+        } catch (...) {
+          errors[index] = std::current_exception();
+        }
+      });
+
+      for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (errors[i]) std::rethrow_exception(errors[i]);
+        if (channels[i]) {
+          // the check in parseAudioChannelFormat can't see channels from
+          // this document, which were not added yet
+          auto id = channels[i]->get<AudioChannelFormatId>();
+          if (idMap_.contains(id))
+            throw error::XmlParsingDuplicateId(formatId(id),
+                                               getDocumentLine(nodes[i]));
+          add(std::move(channels[i]));
+        } else {
+          parseElement(nodes[i]);
+        }
+      }
+    }
+
+    /**
+     * All references are resolved before reporting any which could not be,
+     * so that the error lists every unresolved ID rather than just the first.
+     */
+    void DocumentParser::resolveAllReferences() {
+      resolveReferences(programmeContentRefs_);
+      resolveReferences(contentObjectRefs_);
+      resolveReferences(objectObjectRefs_);
+      resolveEach(objectComplementaryObjectRefs_,
+                  [](AudioObject& object, std::shared_ptr<AudioObject> other) {
+                    object.addComplementary(std::move(other));
+                  });
+      resolveReferences(objectPackFormatRefs_);
+      resolveTrackUidReferences(objectTrackUidRefs_);
+      resolveReference(trackUidTrackFormatRef_);
+      resolveReference(trackUidChannelFormatRef_);
+      resolveReference(trackUidPackFormatRef_);
+      resolveReferences(packFormatChannelFormatRefs_);
+      resolveReferences(packFormatPackFormatRefs_);
+      resolveReference(trackFormatStreamFormatRef_);
+      resolveReference(streamFormatChannelFormatRef_);
+      resolveReference(streamFormatPackFormatRef_);
+      resolveReferences(streamFormatTrackFormatRefs_);
+
+      if (!unresolvedIds_.empty()) {
+        auto ids = std::move(unresolvedIds_);
+        unresolvedIds_.clear();
+        unresolvedIdSet_.clear();
+        throw error::XmlParsingUnresolvedReference(std::move(ids));
+      }
+    }
+
+    void DocumentParser::unresolved(std::string id) {
+      // report each ID once, however many times it is referenced
+      if (unresolvedIdSet_.insert(id).second)
+        unresolvedIds_.push_back(std::move(id));
+    }
+
+    /// parses fragments of the input with rapidxml, reusing the buffer and
+    /// memory pool between fragments
+    class DocumentParser::FragmentParser {
+     public:
+      NodePtr parse(const std::string& text) {
+        buffer_.assign(text.begin(), text.end());
+        buffer_.push_back('\0');
+        document_.clear();
+        document_.parse<0>(buffer_.data());
+        return document_.first_node();
+      }
+
+     private:
+      std::vector<char> buffer_;
+      rapidxml::xml_document<> document_;
+    };
+
+    namespace {
+      bool isAudioFormatExtendedPath(const std::vector<std::string>& path,
+                                     ParserOptions options) {
+        if (path.back() != "audioFormatExtended") return false;
+        if (path.size() == 2 && path[0] == "frame") return true;
+        if (isSet(options, ParserOptions::recursive_node_search)) return true;
+        return path.size() == 4 && path[0] == "ebuCoreMain" &&
+               path[1] == "coreMetadata" && path[2] == "format";
+      }
+
+      /// turn a start tag into an empty element with the same attributes
+      std::string emptyElement(const std::string& startTag) {
+        return startTag.substr(0, startTag.size() - 1) + "/>";
+      }
+    }  // namespace
+
+    /**
+     * Incremental parsing converts elements as they are read from the input,
+     * so that neither the whole input nor a DOM of it is ever held in memory.
+     * Each element within audioFormatExtended is parsed on its own as an XML
+     * fragment, except for audioChannelFormats, which are split further into
+     * individual audioBlockFormats so that long channels are never held in
+     * memory as text either.
+     *
+     * This finds the same audioFormatExtended element as parse(), except that
+     * the uniqueness of the coreMetadata and format elements is not checked.
+     * Line numbers in errors are relative to the start of the fragment.
+     */
+    std::shared_ptr<Document> DocumentParser::parseIncremental() {
+      XmlTagReader reader(*stream_);
+      FragmentParser fragment;
+
+      std::vector<std::string> path;
+      bool empty = true;
+      while (reader.next()) {
+        if (reader.type() == XmlTagReader::TagType::end) {
+          if (!path.empty()) path.pop_back();
+          continue;
+        }
+        empty = false;
+        path.push_back(reader.name());
+        if (isAudioFormatExtendedPath(path, options_)) {
+          parseAudioFormatExtendedIncremental(reader, fragment);
+          resolveAllReferences();
+          return document_;
+        }
+        if (reader.type() == XmlTagReader::TagType::empty) path.pop_back();
+      }
+
+      if (empty) throw error::XmlParsingError("xml document is empty");
+      throw error::XmlParsingError("audioFormatExtended node not found");
+    }
+
+    void DocumentParser::parseAudioFormatExtendedIncremental(
+        XmlTagReader& reader, FragmentParser& fragment) {
+      bool isEmpty = reader.type() == XmlTagReader::TagType::empty;
+      auto root = fragment.parse(isEmpty ? reader.tag()
+                                         : emptyElement(reader.tag()));
+      setOptionalAttribute<Version>(root, "version", document_);
+      if (isEmpty) return;
+
+      while (reader.next()) {
+        if (reader.type() == XmlTagReader::TagType::end) return;
+
+        if (reader.name() == "audioChannelFormat" &&
+            reader.type() == XmlTagReader::TagType::start)
+          parseAudioChannelFormatIncremental(reader, fragment);
+        else
+          parseElement(fragment.parse(reader.captureElement()));
+      }
+      throw error::XmlParsingError("unexpected end of XML input");
+    }
+
+    void DocumentParser::parseAudioChannelFormatIncremental(
+        XmlTagReader& reader, FragmentParser& fragment) {
+      auto startTag = reader.tag();
+      auto audioChannelFormat =
+          parseAudioChannelFormat(fragment.parse(emptyElement(startTag)));
+
+      // sub-elements other than audioBlockFormat are collected and parsed
+      // together at the end
+      std::string properties;
+      while (reader.next()) {
+        if (reader.type() == XmlTagReader::TagType::end) {
+          if (!properties.empty()) {
+            auto node = fragment.parse(startTag + properties + reader.tag());
+            setAudioChannelFormatProperties(audioChannelFormat, node);
+          }
+          add(std::move(audioChannelFormat));
+          return;
+        }
+
+        bool isBlock = reader.name() == "audioBlockFormat";
+        auto element = reader.captureElement();
+        if (isBlock)
+          addAudioBlockFormat(audioChannelFormat, fragment.parse(element));
+        else
+          properties += element;
+      }
+      throw error::XmlParsingError("unexpected end of XML input");
+    }
+
     boost::optional<TimeReference> DocumentParser::getTimeReference() const {
       if (isSet(options_, ParserOptions::permit_time_reference_mismatch)) {
         return boost::optional<TimeReference>{};
@@ -386,17 +607,14 @@ namespace adm {
     }
 
     void DocumentParser::resolveTrackUidReferences(
-        const std::map<std::shared_ptr<AudioObject>,
-                       std::vector<AudioTrackUidId>>& map) {
-      for (const auto& entry : map) {
-        for (const auto& id : entry.second) {
-          if (*id.get<AudioTrackUidIdValue>() == 0)
-            entry.first->addReference(AudioTrackUid::getSilent(document_));
-          else if (const auto& element = document_->lookup(id))
-            entry.first->addReference(element);
-          else
-            throw error::XmlParsingUnresolvedReference(formatId(id));
-        }
+        const PendingReferences<AudioObject, AudioTrackUidId>& refs) {
+      for (const auto& ref : refs.entries()) {
+        if (*ref.id.get<AudioTrackUidIdValue>() == 0)
+          ref.source->addReference(AudioTrackUid::getSilent(document_));
+        else if (auto element = idMap_.lookup(ref.id))
+          ref.source->addReference(std::move(element));
+        else
+          unresolved(formatId(ref.id));
       }
     }
 
@@ -423,43 +641,46 @@ namespace adm {
       auto typeLabel = parseOptionalAttribute<TypeDescriptor>(node, "typeLabel", &parseTypeLabel);
       auto typeDefinition = parseOptionalAttribute<TypeDescriptor>(node, "typeDefinition", &parseTypeDefinition);
       checkChannelType(id, typeLabel, typeDefinition);
-
-      setOptionalMultiElement<Frequency>(node, "frequency", audioChannelFormat, &parseFrequency);
       // clang-format on
 
-      auto elements = detail::findElements(node, "audioBlockFormat");
+      setAudioChannelFormatProperties(audioChannelFormat, node);
 
+      for (auto& element : detail::findElements(node, "audioBlockFormat")) {
+        addAudioBlockFormat(audioChannelFormat, element);
+      }
+      return audioChannelFormat;
+    }
+
+    void DocumentParser::setAudioChannelFormatProperties(
+        const std::shared_ptr<AudioChannelFormat>& audioChannelFormat,
+        NodePtr node) {
+      setOptionalMultiElement<Frequency>(node, "frequency", audioChannelFormat,
+                                         &parseFrequency);
+    }
+
+    void DocumentParser::addAudioBlockFormat(
+        const std::shared_ptr<AudioChannelFormat>& audioChannelFormat,
+        NodePtr node) {
       if (audioChannelFormat->get<TypeDescriptor>() ==
           TypeDefinition::DIRECT_SPEAKERS) {
-        for (auto& element : elements) {
-          audioChannelFormat->add(
-              parseAudioBlockFormatDirectSpeakers(element, getTimeReference()));
-        }
+        audioChannelFormat->add(
+            parseAudioBlockFormatDirectSpeakers(node, getTimeReference()));
       } else if (audioChannelFormat->get<TypeDescriptor>() ==
                  TypeDefinition::MATRIX) {
-        // for (auto& element : elements) {
-        //    audioChannelFormat->add(parseAudioBlockFormatMatrix(element));
-        // }
+        // audioChannelFormat->add(parseAudioBlockFormatMatrix(node));
       } else if (audioChannelFormat->get<TypeDescriptor>() ==
                  TypeDefinition::OBJECTS) {
-        for (auto& element : elements) {
-          audioChannelFormat->add(
-              parseAudioBlockFormatObjects(element, getTimeReference()));
-        }
+        audioChannelFormat->add(
+            parseAudioBlockFormatObjects(node, getTimeReference()));
       } else if (audioChannelFormat->get<TypeDescriptor>() ==
                  TypeDefinition::HOA) {
-        for (auto& element : elements) {
-          audioChannelFormat->add(
-              parseAudioBlockFormatHoa(element, getTimeReference()));
-        }
+        audioChannelFormat->add(
+            parseAudioBlockFormatHoa(node, getTimeReference()));
       } else if (audioChannelFormat->get<TypeDescriptor>() ==
                  TypeDefinition::BINAURAL) {
-        for (auto& element : elements) {
-          audioChannelFormat->add(
-              parseAudioBlockFormatBinaural(element, getTimeReference()));
-        }
+        audioChannelFormat->add(
+            parseAudioBlockFormatBinaural(node, getTimeReference()));
       }
-      return audioChannelFormat;
     }
 
     std::shared_ptr<AudioStreamFormat> DocumentParser::parseAudioStreamFormat(
@@ -798,7 +1019,7 @@ namespace adm {
 
     Gain parseGain(NodePtr node) {
       auto unitAttr = node->first_attribute("gainUnit");
-      double value = std::stod(node->value());
+      double value = detail::parseNumber<double>(node->value());
       if (unitAttr) {
         std::string unitAttrStr{unitAttr->value()};
         if (unitAttrStr == "linear")
@@ -974,7 +1195,7 @@ namespace adm {
     }
 
     DialogueId parseDialogueId(NodePtr node) {
-      return DialogueId(std::stoi(node->value()));
+      return DialogueId(detail::parseNumber<int>(node->value()));
     }
 
     ContentKind parseContentKind(NodePtr node) {
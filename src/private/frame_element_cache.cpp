@@ -0,0 +1,63 @@
+#include "adm/private/frame_element_cache.hpp"
+#include "adm/serial/changed_ids.hpp"
+
+namespace adm {
+  namespace xml {
+
+    namespace {
+      template <typename Id, typename ChangedIdsT>
+      void collectChanged(std::vector<Id> &ids, const ChangedIdsT &changed) {
+        ids.clear();
+        for (auto &changedId : changed) {
+          if (changedId.template get<ChangedIdStatus>() !=
+              ChangedIdStatus::EXPIRED)
+            ids.push_back(changedId.template get<Id>());
+        }
+      }
+    }  // namespace
+
+    void FrameElementCache::startFrame(XmlStreamWriter &writer,
+                                       const FrameHeader &header) {
+      writer_ = &writer;
+      frame_++;
+
+      const auto &frameFormat = header.get<FrameFormat>();
+      if (frameFormat.has<ChangedIds>())
+        setChanged(frameFormat.get<ChangedIds>());
+      else
+        setChanged(ChangedIds{});
+    }
+
+    void FrameElementCache::setChanged(const ChangedIds &changedIds) {
+      collectChanged(std::get<std::vector<AudioProgrammeId>>(changed_),
+                     changedIds.get<ChangedAudioProgrammeIds>());
+      collectChanged(std::get<std::vector<AudioContentId>>(changed_),
+                     changedIds.get<ChangedAudioContentIds>());
+      collectChanged(std::get<std::vector<AudioObjectId>>(changed_),
+                     changedIds.get<ChangedAudioObjectIds>());
+      collectChanged(std::get<std::vector<AudioPackFormatId>>(changed_),
+                     changedIds.get<ChangedAudioPackFormatIds>());
+      collectChanged(std::get<std::vector<AudioChannelFormatId>>(changed_),
+                     changedIds.get<ChangedAudioChannelFormatIds>());
+      collectChanged(std::get<std::vector<AudioStreamFormatId>>(changed_),
+                     changedIds.get<ChangedAudioStreamFormatIds>());
+      collectChanged(std::get<std::vector<AudioTrackFormatId>>(changed_),
+                     changedIds.get<ChangedAudioTrackFormatIds>());
+      collectChanged(std::get<std::vector<AudioTrackUidId>>(changed_),
+                     changedIds.get<ChangedAudioTrackUidIds>());
+    }
+
+    void FrameElementCache::endFrame() {
+      for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.frame != frame_)
+          it = entries_.erase(it);
+        else
+          ++it;
+      }
+      writer_ = nullptr;
+    }
+
+    void FrameElementCache::clear() { entries_.clear(); }
+
+  }  // namespace xml
+}  // namespace adm
@@ -0,0 +1,247 @@
+#include "adm/private/number_parser.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace adm {
+  namespace xml {
+    namespace detail {
+
+      namespace {
+        bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+        char toLower(char c) {
+          return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a')
+                                        : c;
+        }
+
+        /// does [first, last) start with word (which is lower case),
+        /// ignoring case?
+        bool startsWithWord(const char* first, const char* last,
+                            const char* word) {
+          for (; *word; ++word, ++first)
+            if (first == last || toLower(*first) != *word) return false;
+          return true;
+        }
+
+        /// the parts of a decimal floating point number
+        struct DecimalNumber {
+          bool negative = false;
+          /// up to 19 significant digits
+          uint64_t mantissa = 0;
+          /// the value is mantissa * 10^exponent
+          int64_t exponent = 0;
+          /// were there more significant digits than fit in mantissa?
+          bool truncated = false;
+        };
+
+        /// parse a decimal floating point number into its parts, returning
+        /// the end of the number, or nullptr if there isn't one
+        const char* scanDecimal(const char* first, const char* last,
+                                DecimalNumber& number) {
+          const char* p = first;
+          if (p != last && (*p == '+' || *p == '-'))
+            number.negative = *p++ == '-';
+
+          int digits = 0;
+          bool anyDigits = false;
+          auto addDigit = [&](char c, bool fraction) {
+            anyDigits = true;
+            if (number.mantissa == 0 && c == '0') {
+              if (fraction) number.exponent--;
+              return;
+            }
+            if (digits < 19) {
+              number.mantissa = 10 * number.mantissa + (c - '0');
+              digits++;
+              if (fraction) number.exponent--;
+            } else {
+              if (c != '0') number.truncated = true;
+              if (!fraction) number.exponent++;
+            }
+          };
+
+          for (; p != last && isDigit(*p); ++p) addDigit(*p, false);
+          if (p != last && *p == '.') {
+            ++p;
+            for (; p != last && isDigit(*p); ++p) addDigit(*p, true);
+          }
+          if (!anyDigits) return nullptr;
+
+          if (p != last && (*p == 'e' || *p == 'E')) {
+            const char* e = p + 1;
+            bool negativeExponent = false;
+            if (e != last && (*e == '+' || *e == '-'))
+              negativeExponent = *e++ == '-';
+            if (e != last && isDigit(*e)) {
+              int64_t exponent = 0;
+              for (; e != last && isDigit(*e); ++e)
+                // saturate; anything this large is out of range anyway
+                if (exponent < 100000) exponent = 10 * exponent + (*e - '0');
+              number.exponent += negativeExponent ? -exponent : exponent;
+              p = e;
+            }
+          }
+          return p;
+        }
+
+        template <typename T>
+        const T* powersOfTen();
+
+        template <>
+        const double* powersOfTen<double>() {
+          static const double powers[] = {
+              1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+              1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+              1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+          return powers;
+        }
+
+        template <>
+        const float* powersOfTen<float>() {
+          static const float powers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                         1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+          return powers;
+        }
+
+        /// largest exponent and mantissa for which the fast path is exact:
+        /// both the mantissa and the power of ten are representable, so the
+        /// single multiplication or division is correctly rounded
+        template <typename T>
+        struct FastPathLimits;
+
+        template <>
+        struct FastPathLimits<double> {
+          static constexpr int64_t maxExponent = 22;
+          static constexpr uint64_t maxMantissa = uint64_t{1} << 53;
+        };
+
+        template <>
+        struct FastPathLimits<float> {
+          static constexpr int64_t maxExponent = 10;
+          static constexpr uint64_t maxMantissa = uint64_t{1} << 24;
+        };
+
+        template <typename T>
+        ParseNumberResult parseFloatingPoint(const char* first,
+                                             const char* last, T& value) {
+          // special values
+          {
+            const char* p = first;
+            bool negative = false;
+            if (p != last && (*p == '+' || *p == '-')) negative = *p++ == '-';
+            if (startsWithWord(p, last, "inf")) {
+              p += startsWithWord(p, last, "infinity") ? 8 : 3;
+              value = negative ? -std::numeric_limits<T>::infinity()
+                               : std::numeric_limits<T>::infinity();
+              return {p, std::errc()};
+            }
+            if (startsWithWord(p, last, "nan")) {
+              value = negative ? -std::numeric_limits<T>::quiet_NaN()
+                               : std::numeric_limits<T>::quiet_NaN();
+              return {p + 3, std::errc()};
+            }
+          }
+
+          DecimalNumber number;
+          const char* end = scanDecimal(first, last, number);
+          if (!end) return {first, std::errc::invalid_argument};
+
+          using Limits = FastPathLimits<T>;
+          if (number.mantissa == 0) {
+            value = number.negative ? -T(0) : T(0);
+            return {end, std::errc()};
+          }
+          if (!number.truncated && number.mantissa <= Limits::maxMantissa &&
+              number.exponent >= -Limits::maxExponent &&
+              number.exponent <= Limits::maxExponent) {
+            T result = static_cast<T>(number.mantissa);
+            if (number.exponent < 0)
+              result /= powersOfTen<T>()[-number.exponent];
+            else
+              result *= powersOfTen<T>()[number.exponent];
+            value = number.negative ? -result : result;
+            return {end, std::errc()};
+          }
+
+          // slow path: let the standard library do the correct rounding,
+          // with the classic locale so that the decimal point is always '.'
+          std::istringstream stream(std::string(first, end));
+          stream.imbue(std::locale::classic());
+          T result;
+          stream >> result;
+          // the mantissa is not zero, so a zero or subnormal result has
+          // underflowed; these are out of range, as with std::stod
+          if (stream.fail() || std::isinf(result) || !std::isnormal(result))
+            return {end, std::errc::result_out_of_range};
+          value = result;
+          return {end, std::errc()};
+        }
+
+        template <typename T>
+        ParseNumberResult parseInteger(const char* first, const char* last,
+                                       T& value) {
+          const char* p = first;
+          bool negative = false;
+          if (p != last && (*p == '+' || *p == '-')) negative = *p++ == '-';
+          if (p == last || !isDigit(*p))
+            return {first, std::errc::invalid_argument};
+
+          // accumulate the magnitude, noting overflow but carrying on to
+          // find the end of the number
+          using Limits = std::numeric_limits<T>;
+          const uint64_t limit =
+              negative ? uint64_t{0} - static_cast<uint64_t>(Limits::min())
+                       : static_cast<uint64_t>(Limits::max());
+          uint64_t magnitude = 0;
+          bool overflow = false;
+          for (; p != last && isDigit(*p); ++p) {
+            magnitude = 10 * magnitude + static_cast<uint64_t>(*p - '0');
+            if (magnitude > limit) {
+              overflow = true;
+              magnitude = limit;
+            }
+          }
+          if (overflow) return {p, std::errc::result_out_of_range};
+
+          value = negative ? static_cast<T>(0 - static_cast<int64_t>(magnitude))
+                           : static_cast<T>(magnitude);
+          return {p, std::errc()};
+        }
+      }  // namespace
+
+      ParseNumberResult parseNumber(const char* first, const char* last,
+                                    double& value) {
+        return parseFloatingPoint(first, last, value);
+      }
+
+      ParseNumberResult parseNumber(const char* first, const char* last,
+                                    float& value) {
+        return parseFloatingPoint(first, last, value);
+      }
+
+      ParseNumberResult parseNumber(const char* first, const char* last,
+                                    int& value) {
+        return parseInteger(first, last, value);
+      }
+
+      ParseNumberResult parseNumber(const char* first, const char* last,
+                                    unsigned int& value) {
+        return parseInteger(first, last, value);
+      }
+
+      void throwNumberError(const char* first, const char* last,
+                            ParseNumberResult result) {
+        std::string message = "'" + std::string(first, last) + "'";
+        if (result.ec == std::errc::result_out_of_range)
+          throw std::out_of_range("number out of range: " + message);
+        throw std::invalid_argument("invalid number: " + message);
+      }
+
+    }  // namespace detail
+  }  // namespace xml
+}  // namespace adm
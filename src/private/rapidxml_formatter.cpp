@@ -310,31 +310,70 @@ namespace adm {
       // clang-format on
     }
 
-    void formatAudioChannelFormat(
-        XmlNode &node, std::shared_ptr<const AudioChannelFormat> channelFormat,
-        TimeReference timeReference) {
+    namespace detail {
+      template <typename Block, typename Callable>
+      void addBlocks(XmlNode &node,
+                     const std::shared_ptr<const AudioChannelFormat> &channel,
+                     Callable formatter, TimeReference timeReference,
+                     const BlockTimeWindow *window) {
+        auto blocks = window ? channel->getElementsInWindow<Block>(
+                                   window->start, window->end)
+                             : channel->getElements<Block>();
+        for (auto &block : blocks) {
+          node.addElement(block, "audioBlockFormat",
+                          wrapWithTimeRef(formatter, timeReference));
+        }
+      }
+
+      void formatAudioChannelFormat(
+          XmlNode &node,
+          const std::shared_ptr<const AudioChannelFormat> &channelFormat,
+          TimeReference timeReference, const BlockTimeWindow *window) {
+        formatAudioChannelFormatParameters(node, channelFormat);
+
+        // clang-format off
+        auto channelType = channelFormat->get<TypeDescriptor>();
+        if (channelType == TypeDefinition::DIRECT_SPEAKERS) {
+          addBlocks<AudioBlockFormatDirectSpeakers>(node, channelFormat, formatBlockFormatDirectSpeakers, timeReference, window);
+        } else if (channelType == TypeDefinition::MATRIX) {
+          addBlocks<AudioBlockFormatMatrix>(node, channelFormat, formatBlockFormatMatrix, timeReference, window);
+        } else if (channelType == TypeDefinition::OBJECTS) {
+          addBlocks<AudioBlockFormatObjects>(node, channelFormat, formatBlockFormatObjects, timeReference, window);
+        } else if (channelType == TypeDefinition::HOA) {
+          addBlocks<AudioBlockFormatHoa>(node, channelFormat, formatBlockFormatHoa, timeReference, window);
+        } else if (channelType == TypeDefinition::BINAURAL) {
+          addBlocks<AudioBlockFormatBinaural>(node, channelFormat, formatBlockFormatBinaural, timeReference, window);
+        }
+        // clang-format on
+      }
+    }  // namespace detail
+
+    void formatAudioChannelFormatParameters(
+        XmlNode &node,
+        const std::shared_ptr<const AudioChannelFormat> channelFormat) {
       // clang-format off
       node.addAttribute<AudioChannelFormatId>(channelFormat, "audioChannelFormatID");
       node.addOptionalAttribute<AudioChannelFormatName>(channelFormat, "audioChannelFormatName");
       node.addOptionalAttribute<TypeDescriptor>(channelFormat, "typeLabel", &formatTypeLabel);
       node.addOptionalAttribute<TypeDescriptor>(channelFormat, "typeDefinition", &formatTypeDefinition);
       node.addOptionalMultiElement<Frequency>(channelFormat, "frequency", &formatFrequency);
-
-      auto channelType = channelFormat->get<TypeDescriptor>();
-      if (channelType == TypeDefinition::DIRECT_SPEAKERS) {
-        node.addElements<AudioBlockFormatDirectSpeakers>(channelFormat, "audioBlockFormat", detail::wrapWithTimeRef(formatBlockFormatDirectSpeakers, timeReference));
-      } else if (channelType == TypeDefinition::MATRIX) {
-        node.addElements<AudioBlockFormatMatrix>(channelFormat, "audioBlockFormat", detail::wrapWithTimeRef(formatBlockFormatMatrix, timeReference));
-      } else if (channelType == TypeDefinition::OBJECTS) {
-        node.addElements<AudioBlockFormatObjects>(channelFormat, "audioBlockFormat", detail::wrapWithTimeRef(formatBlockFormatObjects, timeReference));
-      } else if (channelType == TypeDefinition::HOA) {
-        node.addElements<AudioBlockFormatHoa>(channelFormat, "audioBlockFormat", detail::wrapWithTimeRef(formatBlockFormatHoa, timeReference));
-      } else if (channelType == TypeDefinition::BINAURAL) {
-        node.addElements<AudioBlockFormatBinaural>(channelFormat, "audioBlockFormat", detail::wrapWithTimeRef(formatBlockFormatBinaural, timeReference));
-      }
       // clang-format on
     }
 
+    void formatAudioChannelFormat(
+        XmlNode &node, std::shared_ptr<const AudioChannelFormat> channelFormat,
+        TimeReference timeReference) {
+      detail::formatAudioChannelFormat(node, channelFormat, timeReference,
+                                       nullptr);
+    }
+
+    void formatAudioChannelFormat(
+        XmlNode &node, std::shared_ptr<const AudioChannelFormat> channelFormat,
+        TimeReference timeReference, const BlockTimeWindow &window) {
+      detail::formatAudioChannelFormat(node, channelFormat, timeReference,
+                                       &window);
+    }
+
     void formatBlockFormatDirectSpeakers(
         XmlNode &node, const AudioBlockFormatDirectSpeakers &audioBlock,
         TimeReference timeReference) {
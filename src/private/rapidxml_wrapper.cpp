@@ -3,39 +3,26 @@
 namespace adm {
   namespace xml {
 
-    // ---- XML DOCUMENT WRAPPER ---- //
+    // ---- XML SINK ---- //
 
-    XmlNode XmlDocument::addNode(const std::string &name) {
-      auto nameString = doc_.allocate_string(name.c_str());
-      auto childNode = doc_.allocate_node(rapidxml::node_element, nameString);
-      doc_.append_node(childNode);
-      return XmlNode(childNode, discardDefaultValues_);
+    XmlNode XmlSink::addNode(const std::string &name) {
+      return XmlNode(this, addNode(rootId(), name), discardDefaultValues_);
     }
 
-    XmlNode XmlDocument::addDeclaration() {
-      auto declaration = doc_.allocate_node(rapidxml::node_declaration);
-      declaration->append_attribute(doc_.allocate_attribute("version", "1.0"));
-      declaration->append_attribute(
-          doc_.allocate_attribute("encoding", "utf-8"));
-      doc_.append_node(declaration);
-      return XmlNode(declaration, discardDefaultValues_);
-    }
-
-    XmlNode XmlDocument::addItuStructure() {
+    XmlNode XmlSink::addItuStructure() {
       auto ituAdmNode = addNode("ituADM");
       auto audioFormatExtendedNode = ituAdmNode.addNode("audioFormatExtended");
       return audioFormatExtendedNode;
     }
 
-    XmlNode XmlDocument::addCoreMetadataAudioFormatExtended(
-        XmlNode &parent) const {
+    XmlNode XmlSink::addCoreMetadataAudioFormatExtended(XmlNode &parent) const {
       auto coreMetaDataNode = parent.addNode("coreMetadata");
       auto formatNode = coreMetaDataNode.addNode("format");
       auto audioFormatExtendedNode = formatNode.addNode("audioFormatExtended");
       return audioFormatExtendedNode;
     }
 
-    XmlNode XmlDocument::addEbuStructure() {
+    XmlNode XmlSink::addEbuStructure() {
       auto ebuCoreMainNode = addNode("ebuCoreMain");
       ebuCoreMainNode.addAttribute("xmlns:dc",
                                    "http://purl.org/dc/elements/1.1/");
@@ -48,31 +35,59 @@ namespace adm {
       return addCoreMetadataAudioFormatExtended(ebuCoreMainNode);
     }
 
+    // ---- XML DOCUMENT WRAPPER ---- //
+
+    void XmlDocument::addDeclaration() {
+      auto declaration = doc_.allocate_node(rapidxml::node_declaration);
+      declaration->append_attribute(doc_.allocate_attribute("version", "1.0"));
+      declaration->append_attribute(
+          doc_.allocate_attribute("encoding", "utf-8"));
+      doc_.append_node(declaration);
+    }
+
+    XmlSink::NodeId XmlDocument::addNode(NodeId parent,
+                                         const std::string &name) {
+      auto nameString = doc_.allocate_string(name.c_str());
+      auto childNode = doc_.allocate_node(rapidxml::node_element, nameString);
+      toNode(parent)->append_node(childNode);
+      return reinterpret_cast<NodeId>(childNode);
+    }
+
+    void XmlDocument::addAttribute(NodeId node, const std::string &name,
+                                   const std::string &value) {
+      auto nameString = doc_.allocate_string(name.c_str());
+      auto valueString = doc_.allocate_string(value.c_str());
+      auto attribute = doc_.allocate_attribute(nameString, valueString);
+      toNode(node)->append_attribute(attribute);
+    }
+
+    void XmlDocument::setValue(NodeId node, const std::string &value) {
+      auto valueString = doc_.allocate_string(value.c_str());
+      toNode(node)->value(valueString);
+    }
+
+    XmlSink::NodeId XmlDocument::rootId() const {
+      const rapidxml::xml_node<> *root = &doc_;
+      return reinterpret_cast<NodeId>(root);
+    }
+
     // ---- XML NODE WRAPPER ---- //
 
-    XmlNode::XmlNode(NodePtr node, bool discardDefaults)
-        : node_(node), discardDefaultValues_(discardDefaults) {}
+    XmlNode::XmlNode(XmlSink *sink, XmlSink::NodeId node, bool discardDefaults)
+        : sink_(sink), node_(node), discardDefaultValues_(discardDefaults) {}
 
     void XmlNode::setValue(const std::string &value) {
-      auto valueString = node_->document()->allocate_string(value.c_str());
-      node_->value(valueString);
+      sink_->setValue(node_, value);
     }
 
     XmlNode XmlNode::addNode(const std::string &name) {
-      auto nameString = node_->document()->allocate_string(name.c_str());
-      auto childNode =
-          node_->document()->allocate_node(rapidxml::node_element, nameString);
-      node_->append_node(childNode);
-      return XmlNode(childNode, discardDefaultValues_);
+      return XmlNode(sink_, sink_->addNode(node_, name),
+                     discardDefaultValues_);
     }
 
     void XmlNode::addAttribute(const std::string &name,
                                const std::string &value) {
-      auto nameString = node_->document()->allocate_string(name.c_str());
-      auto valueString = node_->document()->allocate_string(value.c_str());
-      auto attribute =
-          node_->document()->allocate_attribute(nameString, valueString);
-      node_->append_attribute(attribute);
+      sink_->addAttribute(node_, name, value);
     }
 
     void XmlNode::addElement(const std::string &name,
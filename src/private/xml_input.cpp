@@ -0,0 +1,148 @@
+#include "adm/private/xml_input.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ADM_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace adm {
+  namespace xml {
+
+    XmlInput::XmlInput(XmlInput&& other) noexcept
+        : buffer_(std::move(other.buffer_)),
+          mapping_(other.mapping_),
+          mappingSize_(other.mappingSize_),
+          size_(other.size_) {
+      other.mapping_ = nullptr;
+      other.mappingSize_ = 0;
+      other.size_ = 0;
+    }
+
+    XmlInput& XmlInput::operator=(XmlInput&& other) noexcept {
+      if (this != &other) {
+        release();
+        buffer_ = std::move(other.buffer_);
+        mapping_ = other.mapping_;
+        mappingSize_ = other.mappingSize_;
+        size_ = other.size_;
+        other.mapping_ = nullptr;
+        other.mappingSize_ = 0;
+        other.size_ = 0;
+      }
+      return *this;
+    }
+
+    XmlInput::~XmlInput() { release(); }
+
+    void XmlInput::release() {
+#ifdef ADM_HAS_MMAP
+      if (mapping_) munmap(mapping_, mappingSize_);
+#endif
+      mapping_ = nullptr;
+      mappingSize_ = 0;
+    }
+
+    char* XmlInput::data() {
+      if (mapping_) return static_cast<char*>(mapping_);
+      if (buffer_.empty()) buffer_.push_back('\0');
+      return buffer_.data();
+    }
+
+    XmlInput XmlInput::readFile(const std::string& filename) {
+      std::ifstream stream(filename, std::ios::binary);
+      if (!stream) throw std::runtime_error("cannot open file " + filename);
+      stream.seekg(0, std::ios::end);
+      auto size = static_cast<std::size_t>(stream.tellg());
+      stream.seekg(0);
+
+      XmlInput input;
+      input.buffer_.resize(size + 1);
+      stream.read(input.buffer_.data(), static_cast<std::streamsize>(size));
+      input.buffer_[size] = '\0';
+      input.size_ = size;
+      return input;
+    }
+
+    XmlInput XmlInput::mapFile(const std::string& filename) {
+#ifdef ADM_HAS_MMAP
+      int fd = open(filename.c_str(), O_RDONLY);
+      if (fd < 0) throw std::runtime_error("cannot open file " + filename);
+
+      struct stat status;
+      if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode) ||
+          status.st_size == 0) {
+        close(fd);
+        return readFile(filename);
+      }
+      auto size = static_cast<std::size_t>(status.st_size);
+
+      // rapidxml needs a terminator after the input, so reserve enough
+      // zeroed pages for the file plus one byte, then map the file over the
+      // start of them. Both mappings are private, so writes by the parser
+      // never reach the file.
+      auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+      std::size_t mappingSize = (size / pageSize + 1) * pageSize;
+      void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mapping == MAP_FAILED) {
+        close(fd);
+        return readFile(filename);
+      }
+      void* fileMapping = mmap(mapping, size, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_FIXED, fd, 0);
+      close(fd);
+      if (fileMapping == MAP_FAILED) {
+        munmap(mapping, mappingSize);
+        return readFile(filename);
+      }
+
+      XmlInput input;
+      input.mapping_ = mapping;
+      input.mappingSize_ = mappingSize;
+      input.size_ = size;
+      return input;
+#else
+      return readFile(filename);
+#endif
+    }
+
+    XmlInput XmlInput::readStream(std::istream& stream) {
+      XmlInput input;
+      input.buffer_.assign(std::istreambuf_iterator<char>(stream),
+                           std::istreambuf_iterator<char>());
+      if (stream.fail() || stream.bad())
+        throw std::runtime_error("error reading stream");
+      input.size_ = input.buffer_.size();
+      input.buffer_.push_back('\0');
+      return input;
+    }
+
+    XmlInput XmlInput::copyBuffer(const char* data, std::size_t size) {
+      XmlInput input;
+      input.buffer_.resize(size + 1);
+      if (size) std::memcpy(input.buffer_.data(), data, size);
+      input.buffer_[size] = '\0';
+      input.size_ = size;
+      return input;
+    }
+
+    MemoryInputStream::Buffer::Buffer(const char* data, std::size_t size) {
+      // the get area is never written through, so casting away const is safe
+      char* begin = const_cast<char*>(data);
+      setg(begin, begin, begin + size);
+    }
+
+    MemoryInputStream::MemoryInputStream(const char* data, std::size_t size)
+        : std::istream(nullptr), buffer_(data, size) {
+      rdbuf(&buffer_);
+    }
+
+  }  // namespace xml
+}  // namespace adm
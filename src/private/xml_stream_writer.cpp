@@ -0,0 +1,212 @@
+#include "adm/private/xml_stream_writer.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace adm {
+  namespace xml {
+
+    namespace {
+      /// write to the stream in chunks of about this size
+      constexpr std::size_t flushSize = 64 * 1024;
+    }  // namespace
+
+    // the output matches rapidxml::print with default flags: each node is
+    // on its own line, indented with tabs, and elements with no value or
+    // children are written as empty-element tags. Like XmlDocument (which
+    // copies strings with allocate_string), names and values end at the
+    // first null character.
+
+    XmlStreamWriter::XmlStreamWriter(std::ostream &stream) {
+      buffer_.reserve(flushSize + flushSize / 4);
+      reset(&stream, 0);
+    }
+
+    XmlStreamWriter::XmlStreamWriter(std::size_t indent) {
+      reset(nullptr, indent);
+    }
+
+    void XmlStreamWriter::reset(std::ostream &stream) {
+      buffer_.reserve(flushSize + flushSize / 4);
+      reset(&stream, 0);
+    }
+
+    void XmlStreamWriter::reset(std::size_t indent) { reset(nullptr, indent); }
+
+    void XmlStreamWriter::reset(std::ostream *stream, std::size_t indent) {
+      stream_ = stream;
+      indent_ = indent;
+      buffer_.clear();
+      if (open_.empty()) open_.emplace_back();
+      open_[0].id = rootId();
+      open_[0].name.clear();
+      open_[0].value.clear();
+      open_[0].hasChildren = false;
+      depth_ = 1;
+      nextId_ = 1;
+    }
+
+    void XmlStreamWriter::addDeclaration() {
+      buffer_ += "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+    }
+
+    XmlSink::NodeId XmlStreamWriter::addNode(NodeId parent,
+                                             const std::string &name) {
+      startChild(parent);
+      writeIndent(depth_ - 1);
+      buffer_ += '<';
+      writeName(name);
+
+      if (depth_ == open_.size()) open_.emplace_back();
+      OpenElement &element = open_[depth_++];
+      element.id = nextId_++;
+      element.name.assign(name.c_str());
+      element.value.clear();
+      element.hasChildren = false;
+      return element.id;
+    }
+
+    void XmlStreamWriter::addAttribute(NodeId node, const std::string &name,
+                                       const std::string &value) {
+      const OpenElement &element = open_[depth_ - 1];
+      if (depth_ == 1 || element.id != node || element.hasChildren)
+        throw std::logic_error(
+            "XmlStreamWriter: attributes must be added to an element before "
+            "its children");
+
+      buffer_ += ' ';
+      writeName(name);
+      buffer_ += '=';
+      // use single quotes if the value contains a double quote
+      if (std::strchr(value.c_str(), '"')) {
+        buffer_ += '\'';
+        writeEscaped(value.c_str(), '"');
+        buffer_ += '\'';
+      } else {
+        buffer_ += '"';
+        writeEscaped(value.c_str(), '\'');
+        buffer_ += '"';
+      }
+    }
+
+    void XmlStreamWriter::setValue(NodeId node, const std::string &value) {
+      // the value of an element with children is not written, but this is
+      // only known once it is finished
+      findOpen(node).value.assign(value.c_str());
+    }
+
+    void XmlStreamWriter::finish() {
+      closeTo(rootId());
+      if (stream_) {
+        // the document node itself is followed by a newline
+        buffer_ += '\n';
+        flush();
+      }
+    }
+
+    std::string XmlStreamWriter::takeFragment() {
+      std::string fragment;
+      fragment.swap(buffer_);
+      return fragment;
+    }
+
+    std::size_t XmlStreamWriter::childIndent(NodeId parent) {
+      OpenElement &element = findOpen(parent);
+      return indent_ + static_cast<std::size_t>(&element - open_.data());
+    }
+
+    void XmlStreamWriter::addFragment(NodeId parent,
+                                      const std::string &fragment) {
+      startChild(parent);
+      buffer_ += fragment;
+      flushIfFull();
+    }
+
+    void XmlStreamWriter::startChild(NodeId parent) {
+      closeTo(parent);
+      OpenElement &parentElement = open_[depth_ - 1];
+      if (depth_ > 1 && !parentElement.hasChildren) buffer_ += ">\n";
+      parentElement.hasChildren = true;
+    }
+
+    void XmlStreamWriter::closeTo(NodeId node) {
+      findOpen(node);
+      while (open_[depth_ - 1].id != node) closeElement();
+    }
+
+    void XmlStreamWriter::closeElement() {
+      const OpenElement &element = open_[depth_ - 1];
+      if (element.hasChildren) {
+        writeIndent(depth_ - 2);
+        buffer_ += "</";
+        buffer_ += element.name;
+        buffer_ += ">\n";
+      } else if (element.value.empty()) {
+        buffer_ += "/>\n";
+      } else {
+        buffer_ += '>';
+        writeEscaped(element.value.c_str(), '\0');
+        buffer_ += "</";
+        buffer_ += element.name;
+        buffer_ += ">\n";
+      }
+      depth_--;
+      flushIfFull();
+    }
+
+    XmlStreamWriter::OpenElement &XmlStreamWriter::findOpen(NodeId node) {
+      // ids increase with depth, and node is almost always the innermost
+      for (std::size_t i = depth_; i > 0; i--)
+        if (open_[i - 1].id == node) return open_[i - 1];
+      throw std::logic_error(
+          "XmlStreamWriter: element has already been written");
+    }
+
+    void XmlStreamWriter::writeIndent(std::size_t depth) {
+      buffer_.append(indent_ + depth, '\t');
+    }
+
+    void XmlStreamWriter::writeName(const std::string &name) {
+      buffer_ += name.c_str();
+    }
+
+    void XmlStreamWriter::writeEscaped(const char *str, char noExpand) {
+      for (; *str; ++str) {
+        char c = *str;
+        if (c == noExpand) {
+          buffer_ += c;
+          continue;
+        }
+        switch (c) {
+          case '<':
+            buffer_ += "&lt;";
+            break;
+          case '>':
+            buffer_ += "&gt;";
+            break;
+          case '\'':
+            buffer_ += "&apos;";
+            break;
+          case '"':
+            buffer_ += "&quot;";
+            break;
+          case '&':
+            buffer_ += "&amp;";
+            break;
+          default:
+            buffer_ += c;
+        }
+      }
+    }
+
+    void XmlStreamWriter::flushIfFull() {
+      if (stream_ && buffer_.size() >= flushSize) flush();
+    }
+
+    void XmlStreamWriter::flush() {
+      stream_->write(buffer_.data(),
+                     static_cast<std::streamsize>(buffer_.size()));
+      buffer_.clear();
+    }
+
+  }  // namespace xml
+}  // namespace adm
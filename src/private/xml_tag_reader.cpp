@@ -0,0 +1,139 @@
+#include "adm/private/xml_tag_reader.hpp"
+#include <cstring>
+#include <istream>
+#include "adm/errors.hpp"
+
+namespace adm {
+  namespace xml {
+
+    XmlTagReader::XmlTagReader(std::istream& stream, std::size_t chunkSize)
+        : stream_(stream), chunkSize_(chunkSize) {}
+
+    bool XmlTagReader::next() {
+      // drop consumed input once there is enough of it that moving the rest
+      // to the front of the buffer is cheap in comparison
+      tagStart_ = pos_;
+      std::size_t keep = keepFrom();
+      if (keep >= chunkSize_) {
+        buffer_.erase(0, keep);
+        pos_ -= keep;
+        tagStart_ -= keep;
+        if (capturing_) captureStart_ -= keep;
+      }
+
+      while (true) {
+        std::size_t start = buffer_.find('<', pos_);
+        while (start == std::string::npos) {
+          pos_ = buffer_.size();
+          if (!fill()) return false;
+          start = buffer_.find('<', pos_);
+        }
+
+        require(start, std::strlen("<![CDATA["));
+        if (startsWith(start, "<?")) {
+          pos_ = find("?>", start + 2) + 2;
+        } else if (startsWith(start, "<!--")) {
+          pos_ = find("-->", start + 4) + 3;
+        } else if (startsWith(start, "<![CDATA[")) {
+          pos_ = find("]]>", start + 9) + 3;
+        } else if (startsWith(start, "<!")) {
+          pos_ = findTagEnd(start + 2) + 1;
+        } else {
+          std::size_t end = findTagEnd(start + 1);
+          std::size_t nameStart = start + 1;
+          if (buffer_[nameStart] == '/') {
+            type_ = TagType::end;
+            ++nameStart;
+          } else if (buffer_[end - 1] == '/') {
+            type_ = TagType::empty;
+          } else {
+            type_ = TagType::start;
+          }
+          std::size_t nameEnd = buffer_.find_first_of(" \t\r\n/>", nameStart);
+          name_.assign(buffer_, nameStart, nameEnd - nameStart);
+          tagStart_ = start;
+          pos_ = end + 1;
+          return true;
+        }
+      }
+    }
+
+    std::string XmlTagReader::tag() const {
+      return buffer_.substr(tagStart_, pos_ - tagStart_);
+    }
+
+    std::string XmlTagReader::captureElement() {
+      if (type_ == TagType::empty) return tag();
+
+      capturing_ = true;
+      captureStart_ = tagStart_;
+      int depth = 1;
+      while (depth > 0) {
+        if (!next())
+          throw error::XmlParsingError("unexpected end of XML input");
+        if (type_ == TagType::start)
+          ++depth;
+        else if (type_ == TagType::end)
+          --depth;
+      }
+      capturing_ = false;
+      return buffer_.substr(captureStart_, pos_ - captureStart_);
+    }
+
+    bool XmlTagReader::fill() {
+      std::size_t size = buffer_.size();
+      buffer_.resize(size + chunkSize_);
+      stream_.read(&buffer_[size], static_cast<std::streamsize>(chunkSize_));
+      auto read = static_cast<std::size_t>(stream_.gcount());
+      buffer_.resize(size + read);
+      return read > 0;
+    }
+
+    std::size_t XmlTagReader::keepFrom() const {
+      return capturing_ ? captureStart_ : tagStart_;
+    }
+
+    std::size_t XmlTagReader::find(const char* str, std::size_t from) {
+      std::size_t length = std::strlen(str);
+      while (true) {
+        std::size_t found = buffer_.find(str, from);
+        if (found != std::string::npos) return found;
+        // a match may start in the last few characters
+        if (buffer_.size() >= length) from = buffer_.size() - length + 1;
+        if (!fill())
+          throw error::XmlParsingError("unexpected end of XML input");
+      }
+    }
+
+    std::size_t XmlTagReader::findTagEnd(std::size_t pos) {
+      char quote = 0;
+      int brackets = 0;  // for an internal DTD subset
+      for (;; ++pos) {
+        if (pos == buffer_.size() && !fill())
+          throw error::XmlParsingError("unexpected end of XML input");
+        char c = buffer_[pos];
+        if (quote) {
+          if (c == quote) quote = 0;
+        } else if (c == '"' || c == '\'') {
+          quote = c;
+        } else if (c == '[') {
+          ++brackets;
+        } else if (c == ']') {
+          --brackets;
+        } else if (c == '>' && brackets == 0) {
+          return pos;
+        }
+      }
+    }
+
+    void XmlTagReader::require(std::size_t pos, std::size_t n) {
+      while (buffer_.size() < pos + n && fill()) {
+      }
+    }
+
+    bool XmlTagReader::startsWith(std::size_t pos, const char* str) {
+      return buffer_.compare(pos, std::strlen(str), str) == 0;
+    }
+
+  }  // namespace xml
+}  // namespace adm
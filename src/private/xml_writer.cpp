@@ -1,11 +1,16 @@
 #include "adm/private/xml_writer.hpp"
 #include "adm/elements.hpp"
 #include "adm/document.hpp"
+#include "adm/private/parallel_for.hpp"
 #include "adm/private/rapidxml_formatter.hpp"
 #include "rapidxml/rapidxml.hpp"
 #include "rapidxml/rapidxml_print.hpp"
 #include "rapidxml/rapidxml_utils.hpp"
 #include "adm/private/rapidxml_wrapper.hpp"
+#include "adm/private/xml_stream_writer.hpp"
+#include "adm/serial/frame_view.hpp"
+#include <algorithm>
+#include <vector>
 
 namespace adm {
   namespace xml {
@@ -24,73 +29,255 @@ namespace adm {
         return static_cast<bool>(options & flag);
       }
 
-      void add_document_to_node(
+      /// format a channel format, with only the blocks in window if it is
+      /// not null
+      void format_channel_format(
+          XmlNode& node,
+          const std::shared_ptr<const AudioChannelFormat>& channelFormat,
+          TimeReference timeReference, const BlockTimeWindow* window) {
+        if (window)
+          formatAudioChannelFormat(node, channelFormat, timeReference, *window);
+        else
+          formatAudioChannelFormat(node, channelFormat, timeReference);
+      }
+
+      void add_channel_formats_sequential(
           XmlNode& audioFormatExtended,
-          std::shared_ptr<Document const> document,
-          TimeReference timeReference = TimeReference::TOTAL) {
+          const std::shared_ptr<Document const>& document,
+          TimeReference timeReference, const BlockTimeWindow* window) {
+        audioFormatExtended
+            .addBaseElements<AudioChannelFormat, AudioChannelFormatId>(
+                document, "audioChannelFormat",
+                [timeReference, window](
+                    XmlNode& node,
+                    std::shared_ptr<const AudioChannelFormat> channelFormat) {
+                  format_channel_format(node, channelFormat, timeReference,
+                                        window);
+                });
+      }
+
+      /**
+       * Format each audioChannelFormat into a separate fragment on a pool of
+       * threads, then add these to audioFormatExtended in document order.
+       *
+       * This gives exactly the same output as
+       * add_channel_formats_sequential, but is only possible when writing
+       * to a stream; with other sinks, the channel formats are written
+       * sequentially.
+       */
+      void add_channel_formats_parallel(
+          XmlNode& audioFormatExtended,
+          const std::shared_ptr<Document const>& document,
+          TimeReference timeReference, const BlockTimeWindow* window) {
+        auto writer =
+            dynamic_cast<XmlStreamWriter*>(audioFormatExtended.sink());
+        if (!writer) {
+          add_channel_formats_sequential(audioFormatExtended, document,
+                                         timeReference, window);
+          return;
+        }
+
+        std::vector<std::shared_ptr<const AudioChannelFormat>> channelFormats;
+        for (auto& channelFormat :
+             document->getElements<AudioChannelFormat>()) {
+          if (!isCommonDefinitionsId(
+                  channelFormat->get<AudioChannelFormatId>()))
+            channelFormats.push_back(channelFormat);
+        }
+
+        std::size_t indent = writer->childIndent(audioFormatExtended.id());
+        bool discardDefaults = writer->discardDefaults();
+        std::vector<std::string> fragments(channelFormats.size());
+        ::adm::detail::parallelFor(channelFormats.size(), [&](std::size_t i) {
+          XmlStreamWriter fragmentWriter(indent);
+          fragmentWriter.setDiscardDefaults(discardDefaults);
+          auto node = fragmentWriter.addNode("audioChannelFormat");
+          format_channel_format(node, channelFormats[i], timeReference,
+                                window);
+          fragmentWriter.finish();
+          fragments[i] = fragmentWriter.takeFragment();
+        });
+
+        for (std::size_t i = 0; i < fragments.size(); i++) {
+          writer->addFragment(audioFormatExtended.id(), fragments[i]);
+          std::string().swap(fragments[i]);
+        }
+      }
+
+      FrameSettings frame_settings(const FrameView& frameView,
+                                   FrameElementCache* cache) {
+        return FrameSettings{
+            BlockTimeWindow{frameView.getStart().asNanoseconds(),
+                            frameView.getEnd().asNanoseconds()},
+            cache};
+      }
+
+      template <typename Element, typename Callable>
+      void add_element(XmlNode& parent,
+                       const std::shared_ptr<const Element>& element,
+                       const std::string& name, Callable formatter,
+                       FrameSettings* frame) {
+        if (frame && frame->cache)
+          frame->cache->addElement(parent, element, name, formatter);
+        else
+          parent.addElement(element, name, formatter);
+      }
+
+      template <typename Element, typename Callable>
+      void add_base_elements(XmlNode& parent,
+                             const std::shared_ptr<Document const>& document,
+                             const std::string& name, Callable formatter,
+                             FrameSettings* frame) {
+        using Id = typename Element::id_type;
+        for (auto& element : document->getElements<Element>()) {
+          if (!isCommonDefinitionsId(element->template get<Id>()))
+            add_element(parent, element, name, formatter, frame);
+        }
+      }
+
+      void add_document_to_node(XmlNode& audioFormatExtended,
+                                std::shared_ptr<Document const> document,
+                                TimeReference timeReference, bool parallel,
+                                FrameSettings* frame = nullptr) {
+        const BlockTimeWindow* window = frame ? &frame->window : nullptr;
         // clang-format off
         audioFormatExtended.addOptionalAttribute<Version>(document, "version");
-        audioFormatExtended.addBaseElements<AudioProgramme, AudioProgrammeId>(document, "audioProgramme", &formatAudioProgramme);
-        audioFormatExtended.addBaseElements<AudioContent, AudioContentId>(document, "audioContent", &formatAudioContent);
-        audioFormatExtended.addBaseElements<AudioObject, AudioObjectId>(document, "audioObject", &formatAudioObject);
-        audioFormatExtended.addBaseElements<AudioPackFormat, AudioPackFormatId>(document, "audioPackFormat", &formatAudioPackFormat);
-        audioFormatExtended.addBaseElements<AudioChannelFormat, AudioChannelFormatId>(document, "audioChannelFormat",
-                                                                                      [timeReference](XmlNode& node, std::shared_ptr<const AudioChannelFormat> channelFormat){formatAudioChannelFormat(
-                                                                                          node, std::move(channelFormat), timeReference);});
-        audioFormatExtended.addBaseElements<AudioStreamFormat, AudioStreamFormatId>(document, "audioStreamFormat", &formatAudioStreamFormat);
-        audioFormatExtended.addBaseElements<AudioTrackFormat, AudioTrackFormatId>(document, "audioTrackFormat", &formatAudioTrackFormat);
+        add_base_elements<AudioProgramme>(audioFormatExtended, document, "audioProgramme", &formatAudioProgramme, frame);
+        add_base_elements<AudioContent>(audioFormatExtended, document, "audioContent", &formatAudioContent, frame);
+        add_base_elements<AudioObject>(audioFormatExtended, document, "audioObject", &formatAudioObject, frame);
+        add_base_elements<AudioPackFormat>(audioFormatExtended, document, "audioPackFormat", &formatAudioPackFormat, frame);
+        // clang-format on
+        if (parallel)
+          add_channel_formats_parallel(audioFormatExtended, document,
+                                       timeReference, window);
+        else
+          add_channel_formats_sequential(audioFormatExtended, document,
+                                         timeReference, window);
+        // clang-format off
+        add_base_elements<AudioStreamFormat>(audioFormatExtended, document, "audioStreamFormat", &formatAudioStreamFormat, frame);
+        add_base_elements<AudioTrackFormat>(audioFormatExtended, document, "audioTrackFormat", &formatAudioTrackFormat, frame);
 
         for (auto &element : document->template getElements<AudioTrackUid>()) {
           auto id = element->template get<AudioTrackUidId>();
           if (!isCommonDefinitionsId(id) && !element->isSilent()) {
-            audioFormatExtended.addElement(element, "audioTrackUID", &formatAudioTrackUid);
+            add_element(audioFormatExtended, element, "audioTrackUID", &formatAudioTrackUid, frame);
           }
         }
         // clang-format on
       }
+
+      /// add the frame, frameHeader and audioFormatExtended elements,
+      /// returning the audioFormatExtended node
+      XmlNode add_frame_envelope(XmlSink& sink, SadmWriterOptions options,
+                                 const FrameHeader& frameHeader) {
+        sink.setDiscardDefaults(
+            !isSet(options, SadmWriterOptions::write_default_values));
+        sink.addDeclaration();
+        auto root = sink.addNode("frame");
+        root.addAttribute("version", "ITU-R_BS.2125-1");
+        root.addElement(frameHeader, "frameHeader", &formatFrameHeader);
+        if (isSet(options, SadmWriterOptions::core_metadata)) {
+          return sink.addCoreMetadataAudioFormatExtended(root);
+        } else {
+          return root.addNode("audioFormatExtended");
+        }
+      }
     }  // namespace
 
     using NodePtr = rapidxml::xml_node<>*;
 
-    XmlWriter::XmlWriter(WriterOptions options) : options_(options) {}
+    XmlWriter::XmlWriter(WriterOptions options, XmlWriterBackend backend)
+        : options_(options), backend_(backend) {}
 
     std::ostream& XmlWriter::write(std::shared_ptr<const Document> document,
                                    std::ostream& stream) {
-      XmlDocument xmlDocument;
-      xmlDocument.setDiscardDefaults(
+      if (backend_ == XmlWriterBackend::dom) {
+        XmlDocument xmlDocument;
+        write(xmlDocument, std::move(document));
+        return stream << xmlDocument;
+      }
+      XmlStreamWriter writer(stream);
+      write(writer, std::move(document));
+      writer.finish();
+      return stream;
+    }
+
+    void XmlWriter::write(XmlSink& sink,
+                          std::shared_ptr<const Document> document) {
+      sink.setDiscardDefaults(
           !isSet(options_, WriterOptions::write_default_values));
-      xmlDocument.addDeclaration();
+      sink.addDeclaration();
       XmlNode root;
       if (isSet(options_, WriterOptions::itu_structure)) {
-        root = xmlDocument.addItuStructure();
+        root = sink.addItuStructure();
       } else {
-        root = xmlDocument.addEbuStructure();
+        root = sink.addEbuStructure();
       }
-      add_document_to_node(root, document);
-      return stream << xmlDocument;
+      add_document_to_node(root, document, TimeReference::TOTAL,
+                           isSet(options_, WriterOptions::parallel));
     }
 
-    SadmXmlWriter::SadmXmlWriter(SadmWriterOptions options)
-        : options_{options} {}
+    SadmXmlWriter::SadmXmlWriter(SadmWriterOptions options,
+                                 XmlWriterBackend backend)
+        : options_{options}, backend_{backend} {}
+
     std::ostream& SadmXmlWriter::write(std::shared_ptr<const Document> document,
                                        const FrameHeader& frameHeader,
                                        std::ostream& stream) {
-      XmlDocument xmlDocument;
-      xmlDocument.setDiscardDefaults(
-          !isSet(options_, SadmWriterOptions::write_default_values));
-      xmlDocument.addDeclaration();
-      auto root = xmlDocument.addNode("frame");
-      root.addAttribute("version", "ITU-R_BS.2125-1");
-      root.addElement(frameHeader, "frameHeader", &formatFrameHeader);
-      XmlNode formatExtended;
-      if (isSet(options_, SadmWriterOptions::core_metadata)) {
-        formatExtended = xmlDocument.addCoreMetadataAudioFormatExtended(root);
-      } else {
-        formatExtended = root.addNode("audioFormatExtended");
+      return write(std::move(document), frameHeader, stream, nullptr);
+    }
+
+    std::ostream& SadmXmlWriter::write(const FrameView& frameView,
+                                       const FrameHeader& frameHeader,
+                                       std::ostream& stream) {
+      auto frame = frame_settings(frameView, nullptr);
+      return write(frameView.getDocument(), frameHeader, stream, &frame);
+    }
+
+    std::ostream& SadmXmlWriter::write(std::shared_ptr<const Document> document,
+                                       const FrameHeader& frameHeader,
+                                       std::ostream& stream,
+                                       FrameSettings* frame) {
+      if (backend_ == XmlWriterBackend::dom) {
+        XmlDocument xmlDocument;
+        write(xmlDocument, std::move(document), frameHeader, frame);
+        return stream << xmlDocument;
       }
-      add_document_to_node(formatExtended, document,
-                           frameHeader.get<FrameFormat>().get<TimeReference>());
-      return stream << xmlDocument;
+      XmlStreamWriter writer(stream);
+      write(writer, std::move(document), frameHeader, frame);
+      writer.finish();
+      return stream;
+    }
+
+    void SadmXmlWriter::write(XmlSink& sink,
+                              std::shared_ptr<const Document> document,
+                              const FrameHeader& frameHeader,
+                              FrameSettings* frame) {
+      auto formatExtended = add_frame_envelope(sink, options_, frameHeader);
+      add_document_to_node(
+          formatExtended, document,
+          frameHeader.get<FrameFormat>().get<TimeReference>(),
+          isSet(options_, SadmWriterOptions::parallel), frame);
+    }
+
+    SadmFrameXmlWriter::SadmFrameXmlWriter(SadmWriterOptions options)
+        : options_{options} {}
+
+    std::ostream& SadmFrameXmlWriter::write(
+        std::shared_ptr<const Document> document,
+        const FrameHeader& frameHeader, std::ostream& stream) {
+      auto frame = frame_settings(FrameView(document, frameHeader), &cache_);
+
+      writer_.reset(stream);
+      cache_.startFrame(writer_, frameHeader);
+      auto formatExtended = add_frame_envelope(writer_, options_, frameHeader);
+      add_document_to_node(
+          formatExtended, document,
+          frameHeader.get<FrameFormat>().get<TimeReference>(),
+          isSet(options_, SadmWriterOptions::parallel), &frame);
+      writer_.finish();
+      cache_.endFrame();
+      return stream;
     }
   }  // namespace xml
 }  // namespace adm
@@ -0,0 +1,142 @@
+#include "adm/serial/document_diff.hpp"
+#include <vector>
+#include <boost/optional.hpp>
+#include "adm/utilities/id_assignment.hpp"
+
+namespace adm {
+
+  namespace {
+
+    template <typename Block>
+    unsigned blockCounter(const Block& block) {
+      return block.template get<AudioBlockFormatId>()
+          .template get<AudioBlockFormatIdCounter>()
+          .get();
+    }
+
+    /// combine the statuses of parts of an element: any change makes the
+    /// whole element changed
+    void combine(boost::optional<ChangedIdStatus>& status,
+                 boost::optional<ChangedIdStatus> part) {
+      if (part && (!status || *part == ChangedIdStatus::CHANGED))
+        status = part;
+    }
+
+    class DocumentDiff {
+     public:
+      DocumentDiff(const Document& previous, const Document& current)
+          : previous_(previous), current_(current) {}
+
+      ChangedIds run() {
+        ChangedIds changedIds;
+        diff<AudioProgramme>(changedIds);
+        diff<AudioContent>(changedIds);
+        diff<AudioObject>(changedIds);
+        diff<AudioPackFormat>(changedIds);
+        diff<AudioChannelFormat>(changedIds);
+        diff<AudioStreamFormat>(changedIds);
+        diff<AudioTrackFormat>(changedIds);
+        diff<AudioTrackUid>(changedIds);
+        return changedIds;
+      }
+
+     private:
+      template <typename Element>
+      void diff(ChangedIds& changedIds) {
+        using Id = typename Element::id_type;
+        std::vector<ChangedId<Element>> changed;
+
+        for (const auto& element : current_.getElements<Element>()) {
+          auto id = element->template get<Id>();
+          if (isCommonDefinitionsId(id)) continue;
+          auto old = previous_.lookup(id);
+          if (!old) {
+            changed.emplace_back(id, ChangedIdStatus::NEW);
+          } else if (auto status = compare(old, element)) {
+            changed.emplace_back(id, *status);
+          }
+        }
+
+        for (const auto& element : previous_.getElements<Element>()) {
+          auto id = element->template get<Id>();
+          if (isCommonDefinitionsId(id)) continue;
+          if (!current_.lookup(id))
+            changed.emplace_back(id, ChangedIdStatus::EXPIRED);
+        }
+
+        if (!changed.empty()) changedIds.set(std::move(changed));
+      }
+
+      template <typename Element>
+      boost::optional<ChangedIdStatus> compare(
+          const std::shared_ptr<const Element>& old,
+          const std::shared_ptr<const Element>& element) {
+        if (old->contentHash() != element->contentHash())
+          return ChangedIdStatus::CHANGED;
+        return boost::none;
+      }
+
+      boost::optional<ChangedIdStatus> compare(
+          const std::shared_ptr<const AudioChannelFormat>& old,
+          const std::shared_ptr<const AudioChannelFormat>& element) {
+        if (old->contentHash() != element->contentHash())
+          return ChangedIdStatus::CHANGED;
+
+        boost::optional<ChangedIdStatus> status;
+        // clang-format off
+        combine(status, compareBlocks<AudioBlockFormatDirectSpeakers>(*old, *element));
+        combine(status, compareBlocks<AudioBlockFormatMatrix>(*old, *element));
+        combine(status, compareBlocks<AudioBlockFormatObjects>(*old, *element));
+        combine(status, compareBlocks<AudioBlockFormatHoa>(*old, *element));
+        combine(status, compareBlocks<AudioBlockFormatBinaural>(*old, *element));
+        // clang-format on
+        return status;
+      }
+
+      /// compare the blocks of one type in two versions of a channel
+      ///
+      /// blocks are matched by counter, which increase through each
+      /// channel; blocks with the same counter must match, and blocks in
+      /// element after the last block in old make it extended
+      template <typename Block>
+      boost::optional<ChangedIdStatus> compareBlocks(
+          const AudioChannelFormat& old, const AudioChannelFormat& element) {
+        auto oldBlocks = old.getElements<Block>();
+        auto blocks = element.getElements<Block>();
+        if (blocks.empty()) return boost::none;
+        if (oldBlocks.empty()) return ChangedIdStatus::EXTENDED;
+
+        auto oldIt = oldBlocks.begin();
+        auto it = blocks.begin();
+        while (oldIt != oldBlocks.end() && it != blocks.end()) {
+          auto oldCounter = blockCounter(*oldIt);
+          auto counter = blockCounter(*it);
+          if (oldCounter < counter) {
+            ++oldIt;
+          } else if (counter < oldCounter) {
+            // a block which is not in old, but is before its end
+            return ChangedIdStatus::CHANGED;
+          } else {
+            if (oldIt->contentHash() != it->contentHash())
+              return ChangedIdStatus::CHANGED;
+            ++oldIt;
+            ++it;
+          }
+        }
+
+        if (it != blocks.end()) return ChangedIdStatus::EXTENDED;
+        return boost::none;
+      }
+
+      const Document& previous_;
+      const Document& current_;
+    };
+
+  }  // namespace
+
+  ChangedIds diffDocuments(std::shared_ptr<const Document> previous,
+                           std::shared_ptr<const Document> current) {
+    return DocumentDiff(*previous, *current).run();
+  }
+
+}  // namespace adm
@@ -2,6 +2,7 @@
 #include "adm/private/xml_parser_helper.hpp"
 #include "adm/errors.hpp"
 #include "adm/private/rapidxml_utils.hpp"
+#include "adm/private/xml_input.hpp"
 #include "rapidxml/rapidxml.hpp"
 #include "rapidxml/rapidxml_utils.hpp"
 #include "adm/private/document_parser.hpp"
@@ -12,19 +13,28 @@ namespace adm {
   namespace xml {
     FrameHeaderParser::FrameHeaderParser(const std::string& filename,
                                          ParserOptions options)
-        : FrameHeaderParser(rapidxml::file<>(filename.c_str()), options) {}
+        : FrameHeaderParser(
+              static_cast<bool>(options & ParserOptions::memory_map)
+                  ? XmlInput::mapFile(filename)
+                  : XmlInput::readFile(filename),
+              options) {}
 
     FrameHeaderParser::FrameHeaderParser(std::istream& stream,
                                          ParserOptions options)
-        : FrameHeaderParser(rapidxml::file<>(stream), options) {}
+        : FrameHeaderParser(XmlInput::readStream(stream), options) {}
 
-    FrameHeaderParser::FrameHeaderParser(rapidxml::file<> file,
+    FrameHeaderParser::FrameHeaderParser(const char* data, std::size_t size,
                                          ParserOptions options)
-        : file{std::move(file)}, options{std::move(options)} {}
+        : FrameHeaderParser(XmlInput::copyBuffer(data, size), options) {}
+
+    FrameHeaderParser::FrameHeaderParser(XmlInput input, ParserOptions options)
+        : input{new XmlInput(std::move(input))}, options{std::move(options)} {}
+
+    FrameHeaderParser::~FrameHeaderParser() = default;
 
     FrameHeader FrameHeaderParser::parse() {
       rapidxml::xml_document<> document;
-      document.parse<0>(file.data());
+      document.parse<0>(input->data());
 
       if (!document.first_node())
         throw error::XmlParsingError("xml document is empty");
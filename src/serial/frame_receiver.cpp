@@ -0,0 +1,452 @@
+#include "adm/serial/frame_receiver.hpp"
+#include <algorithm>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "adm/detail/for_each_element.hpp"
+#include "adm/detail/hash.hpp"
+#include "adm/serial/changed_ids.hpp"
+
+namespace adm {
+
+  namespace {
+
+    /// what happens to the elements of one type in a frame
+    template <typename Element>
+    struct ElementChanges {
+      using element_type = Element;
+      using Id = typename Element::id_type;
+
+      /// status of each ID in the frame header's changedIDs
+      std::unordered_map<Id, ChangedIdStatus, detail::IdHash> status;
+      /// elements in the live document which are replaced, and their
+      /// replacements
+      std::unordered_map<const Element*, std::shared_ptr<Element>> replaced;
+      /// elements in the frame, and the copies which are added to the live
+      /// document; this includes the replacements
+      std::vector<
+          std::pair<std::shared_ptr<const Element>, std::shared_ptr<Element>>>
+          copies;
+    };
+
+    /// should an existing element with the given status be replaced?
+    template <typename Element>
+    bool isReplacedBy(ChangedIdStatus status) {
+      return status != ChangedIdStatus::EXPIRED;
+    }
+
+    /// audioChannelFormats are extended by adding blocks instead
+    template <>
+    bool isReplacedBy<AudioChannelFormat>(ChangedIdStatus status) {
+      return status == ChangedIdStatus::NEW ||
+             status == ChangedIdStatus::CHANGED;
+    }
+
+    template <typename Block>
+    unsigned blockCounter(const Block& block) {
+      return block.template get<AudioBlockFormatId>()
+          .template get<AudioBlockFormatIdCounter>()
+          .get();
+    }
+
+    /// append the blocks in frame after the last block in live; if their
+    /// counters do not follow on, replace the blocks in live instead
+    template <typename Block>
+    void appendBlocks(AudioChannelFormat& live,
+                      const AudioChannelFormat& frame) {
+      auto frameBlocks = frame.getElements<Block>();
+      auto liveBlocks = live.getElements<Block>();
+      auto first = frameBlocks.begin();
+      if (!liveBlocks.empty()) {
+        auto last = blockCounter(liveBlocks.back());
+        first = std::find_if(
+            frameBlocks.begin(), frameBlocks.end(),
+            [last](const Block& block) { return blockCounter(block) > last; });
+        if (first == frameBlocks.end()) return;
+
+        if (blockCounter(*first) != last + 1) {
+          live.clearAudioBlockFormats();
+          first = frameBlocks.begin();
+        }
+      }
+      for (auto it = first; it != frameBlocks.end(); ++it) live.add(*it);
+    }
+
+    /// add the blocks in old which are before the first block in
+    /// replacement to the start of replacement, if the counters follow on
+    template <typename Block>
+    void keepEarlierBlocks(const AudioChannelFormat& old,
+                           AudioChannelFormat& replacement) {
+      auto oldBlocks = old.getElements<Block>();
+      auto newBlocks = replacement.getElements<Block>();
+      if (oldBlocks.empty() || newBlocks.empty()) return;
+
+      auto firstCounter = blockCounter(newBlocks.front());
+      auto end = std::find_if(oldBlocks.begin(), oldBlocks.end(),
+                              [firstCounter](const Block& block) {
+                                return blockCounter(block) >= firstCounter;
+                              });
+      if (end == oldBlocks.begin() ||
+          blockCounter(*std::prev(end)) + 1 != firstCounter)
+        return;
+
+      std::vector<Block> blocks(oldBlocks.begin(), end);
+      blocks.insert(blocks.end(), newBlocks.begin(), newBlocks.end());
+      replacement.clearAudioBlockFormats();
+      for (auto& block : blocks) replacement.add(std::move(block));
+    }
+
+    /// update an element which is not replaced
+    template <typename Element>
+    void update(Element&, const Element&) {}
+
+    void update(AudioChannelFormat& live, const AudioChannelFormat& frame) {
+      appendBlocks<AudioBlockFormatDirectSpeakers>(live, frame);
+      appendBlocks<AudioBlockFormatMatrix>(live, frame);
+      appendBlocks<AudioBlockFormatObjects>(live, frame);
+      appendBlocks<AudioBlockFormatHoa>(live, frame);
+      appendBlocks<AudioBlockFormatBinaural>(live, frame);
+    }
+
+    /// prepare a replacement for an element in the live document
+    template <typename Element>
+    void prepareReplacement(const Element&, Element&) {}
+
+    void prepareReplacement(const AudioChannelFormat& old,
+                            AudioChannelFormat& replacement) {
+      keepEarlierBlocks<AudioBlockFormatDirectSpeakers>(old, replacement);
+      keepEarlierBlocks<AudioBlockFormatMatrix>(old, replacement);
+      keepEarlierBlocks<AudioBlockFormatObjects>(old, replacement);
+      keepEarlierBlocks<AudioBlockFormatHoa>(old, replacement);
+      keepEarlierBlocks<AudioBlockFormatBinaural>(old, replacement);
+    }
+
+    /// merge one frame into the live document
+    class FrameMerge {
+     public:
+      FrameMerge(Document& document, const Document& frame)
+          : document_(document), frame_(frame) {}
+
+      void run(const FrameHeader& header) {
+        const auto& frameFormat = header.get<FrameFormat>();
+        if (frameFormat.has<ChangedIds>()) {
+          auto changedIds = frameFormat.get<ChangedIds>();
+          changes_.visit(
+              [&](auto& changes) { setStatus(changes, changedIds); });
+        }
+
+        changes_.visit([&](auto& changes) { removeExpired(changes); });
+        changes_.visit([&](auto& changes) { copyElements(changes); });
+
+        // references to replaced elements are removed along with them, so
+        // find these first and restore them once the replacements are added
+        if (anyReplaced_) {
+          keepReferencesTo();
+          changes_.visit([&](auto& changes) { removeReplaced(changes); });
+        }
+        changes_.visit([&](auto& changes) { addCopies(changes); });
+        for (auto& restore : restore_) restore();
+        changes_.visit([&](auto& changes) { resolveCopies(changes); });
+      }
+
+     private:
+      template <typename Element>
+      void setStatus(ElementChanges<Element>& changes,
+                     const ChangedIds& changedIds) {
+        using Id = typename Element::id_type;
+        for (auto& changedId :
+             changedIds.get<std::vector<ChangedId<Element>>>())
+          changes.status[changedId.template get<Id>()] =
+              changedId.template get<ChangedIdStatus>();
+      }
+
+      template <typename Element>
+      void removeExpired(ElementChanges<Element>& changes) {
+        for (auto& status : changes.status) {
+          if (status.second != ChangedIdStatus::EXPIRED) continue;
+          if (auto element = document_.lookup(status.first))
+            document_.remove(element);
+        }
+      }
+
+      template <typename Element>
+      void copyElements(ElementChanges<Element>& changes) {
+        using Id = typename Element::id_type;
+        for (auto frameElement : frame_.getElements<Element>()) {
+          auto id = frameElement->template get<Id>();
+          auto status = changes.status.find(id);
+          bool listed = status != changes.status.end();
+          if (listed && status->second == ChangedIdStatus::EXPIRED) continue;
+
+          auto live = document_.lookup(id);
+          if (!live) {
+            changes.copies.emplace_back(frameElement, frameElement->copy());
+          } else if (listed && isReplacedBy<Element>(status->second)) {
+            auto replacement = frameElement->copy();
+            prepareReplacement(*live, *replacement);
+            changes.replaced.emplace(live.get(), replacement);
+            changes.copies.emplace_back(frameElement, std::move(replacement));
+            anyReplaced_ = true;
+          } else {
+            update(*live, *frameElement);
+          }
+        }
+      }
+
+      template <typename Element>
+      void removeReplaced(ElementChanges<Element>& changes) {
+        for (auto& replaced : changes.replaced)
+          document_.remove(
+              document_.lookup(replaced.second->template get<
+                               typename Element::id_type>()));
+      }
+
+      template <typename Element>
+      void addCopies(ElementChanges<Element>& changes) {
+        for (auto& copy : changes.copies) document_.add(copy.second);
+      }
+
+      template <typename Element>
+      void resolveCopies(ElementChanges<Element>& changes) {
+        for (auto& copy : changes.copies) resolve(*copy.second, *copy.first);
+      }
+
+      /// the replacement for element, or nullptr if it is not replaced
+      template <typename Element>
+      std::shared_ptr<Element> replacementFor(const Element* element) const {
+        auto& replaced = changes_.get<Element>().replaced;
+        auto it = replaced.find(element);
+        return it != replaced.end() ? it->second : nullptr;
+      }
+
+      /// the element in the live document with the same ID as an element in
+      /// the frame
+      template <typename Element>
+      std::shared_ptr<Element> liveElement(
+          const std::shared_ptr<const Element>& frameElement) const {
+        if (!frameElement) return nullptr;
+        return document_.lookup(
+            frameElement->template get<typename Element::id_type>());
+      }
+
+      // restoring references to replaced elements
+
+      void keepReferencesTo() {
+        for (auto& programme : document_.getElements<AudioProgramme>()) {
+          if (replacementFor<AudioProgramme>(programme.get())) continue;
+          keepReferences<AudioContent>(programme);
+        }
+        for (auto& content : document_.getElements<AudioContent>()) {
+          if (replacementFor<AudioContent>(content.get())) continue;
+          keepReferences<AudioObject>(content);
+        }
+        for (auto& object : document_.getElements<AudioObject>()) {
+          if (replacementFor<AudioObject>(object.get())) continue;
+          keepReferences<AudioObject>(object);
+          keepReferences<AudioPackFormat>(object);
+          keepReferences<AudioTrackUid>(object);
+          keepComplementaries(object);
+        }
+        for (auto& packFormat : document_.getElements<AudioPackFormat>()) {
+          if (replacementFor<AudioPackFormat>(packFormat.get())) continue;
+          keepReferences<AudioChannelFormat>(packFormat);
+          keepReferences<AudioPackFormat>(packFormat);
+        }
+        for (auto& streamFormat : document_.getElements<AudioStreamFormat>()) {
+          if (replacementFor<AudioStreamFormat>(streamFormat.get())) continue;
+          keepReference<AudioChannelFormat>(streamFormat);
+          keepReference<AudioPackFormat>(streamFormat);
+          keepTrackFormatReferences(streamFormat);
+        }
+        for (auto& trackFormat : document_.getElements<AudioTrackFormat>()) {
+          if (replacementFor<AudioTrackFormat>(trackFormat.get())) continue;
+          keepReference<AudioStreamFormat>(trackFormat);
+        }
+        for (auto& trackUid : document_.getElements<AudioTrackUid>()) {
+          if (replacementFor<AudioTrackUid>(trackUid.get())) continue;
+          keepReference<AudioTrackFormat>(trackUid);
+          keepReference<AudioPackFormat>(trackUid);
+          keepReference<AudioChannelFormat>(trackUid);
+        }
+      }
+
+      template <typename Target, typename Element>
+      void keepReferences(const std::shared_ptr<Element>& element) {
+        auto references = element->template getReferences<Target>();
+        if (std::none_of(references.begin(), references.end(),
+                         [this](const std::shared_ptr<Target>& reference) {
+                           return replacementFor(reference.get()) != nullptr;
+                         }))
+          return;
+
+        std::vector<std::shared_ptr<Target>> newReferences;
+        for (auto& reference : references) {
+          auto replacement = replacementFor(reference.get());
+          newReferences.push_back(replacement ? replacement : reference);
+        }
+        restore_.push_back([element, newReferences]() {
+          element->template clearReferences<Target>();
+          for (auto& reference : newReferences)
+            element->addReference(reference);
+        });
+      }
+
+      void keepComplementaries(const std::shared_ptr<AudioObject>& object) {
+        auto& complementaries = object->getComplementaryObjects();
+        if (std::none_of(complementaries.begin(), complementaries.end(),
+                         [this](const std::shared_ptr<AudioObject>& reference) {
+                           return replacementFor(reference.get()) != nullptr;
+                         }))
+          return;
+
+        std::vector<std::shared_ptr<AudioObject>> newComplementaries;
+        for (auto& reference : complementaries) {
+          auto replacement = replacementFor(reference.get());
+          newComplementaries.push_back(replacement ? replacement : reference);
+        }
+        restore_.push_back([object, newComplementaries]() {
+          object->clearComplementaryObjects();
+          for (auto& reference : newComplementaries)
+            object->addComplementary(reference);
+        });
+      }
+
+      void keepTrackFormatReferences(
+          const std::shared_ptr<AudioStreamFormat>& streamFormat) {
+        std::vector<std::shared_ptr<AudioTrackFormat>> references;
+        bool anyReplaced = false;
+        for (auto& weakReference :
+             streamFormat->getAudioTrackFormatReferences()) {
+          auto reference = weakReference.lock();
+          if (!reference) continue;
+          if (auto replacement = replacementFor(reference.get())) {
+            reference = replacement;
+            anyReplaced = true;
+          }
+          references.push_back(reference);
+        }
+        if (!anyReplaced) return;
+
+        restore_.push_back([streamFormat, references]() {
+          streamFormat->clearReferences<AudioTrackFormat>();
+          for (auto& reference : references)
+            streamFormat->addReference(
+                std::weak_ptr<AudioTrackFormat>(reference));
+        });
+      }
+
+      template <typename Target, typename Element>
+      void keepReference(const std::shared_ptr<Element>& element) {
+        auto reference = element->template getReference<Target>();
+        if (auto replacement = replacementFor<Target>(reference.get()))
+          restore_.push_back(
+              [element, replacement]() { element->setReference(replacement); });
+      }
+
+      // resolving references of copied elements by ID
+
+      template <typename Target, typename Element>
+      void addReferences(Element& copy, const Element& frameElement) {
+        for (auto reference : frameElement.template getReferences<Target>())
+          if (auto live = liveElement<Target>(reference))
+            copy.addReference(live);
+      }
+
+      template <typename Target, typename Element>
+      void setReference(Element& copy, const Element& frameElement) {
+        if (auto live = liveElement<Target>(
+                frameElement.template getReference<Target>()))
+          copy.setReference(live);
+      }
+
+      void resolve(AudioProgramme& copy, const AudioProgramme& frameElement) {
+        addReferences<AudioContent>(copy, frameElement);
+      }
+
+      void resolve(AudioContent& copy, const AudioContent& frameElement) {
+        addReferences<AudioObject>(copy, frameElement);
+      }
+
+      void resolve(AudioObject& copy, const AudioObject& frameElement) {
+        addReferences<AudioObject>(copy, frameElement);
+        addReferences<AudioPackFormat>(copy, frameElement);
+        addReferences<AudioTrackUid>(copy, frameElement);
+        for (auto& reference : frameElement.getComplementaryObjects())
+          if (auto live = liveElement<AudioObject>(reference))
+            copy.addComplementary(live);
+      }
+
+      void resolve(AudioPackFormat& copy, const AudioPackFormat& frameElement) {
+        addReferences<AudioChannelFormat>(copy, frameElement);
+        addReferences<AudioPackFormat>(copy, frameElement);
+      }
+
+      void resolve(AudioChannelFormat&, const AudioChannelFormat&) {}
+
+      void resolve(AudioStreamFormat& copy,
+                   const AudioStreamFormat& frameElement) {
+        setReference<AudioChannelFormat>(copy, frameElement);
+        setReference<AudioPackFormat>(copy, frameElement);
+        for (auto& weakReference : frameElement.getAudioTrackFormatReferences())
+          if (auto live = liveElement<AudioTrackFormat>(weakReference.lock()))
+            copy.addReference(std::weak_ptr<AudioTrackFormat>(live));
+      }
+
+      void resolve(AudioTrackFormat& copy,
+                   const AudioTrackFormat& frameElement) {
+        setReference<AudioStreamFormat>(copy, frameElement);
+      }
+
+      void resolve(AudioTrackUid& copy, const AudioTrackUid& frameElement) {
+        setReference<AudioTrackFormat>(copy, frameElement);
+        setReference<AudioPackFormat>(copy, frameElement);
+        setReference<AudioChannelFormat>(copy, frameElement);
+      }
+
+      Document& document_;
+      const Document& frame_;
+      detail::ForEachElement<ElementChanges> changes_;
+      bool anyReplaced_ = false;
+      std::vector<std::function<void()>> restore_;
+    };
+
+  }  // namespace
+
+  SadmFrameReceiver::SadmFrameReceiver(xml::ParserOptions options)
+      : options_(options) {}
+
+  FrameHeader SadmFrameReceiver::receive(std::istream& stream) {
+    buffer_.assign(std::istreambuf_iterator<char>(stream),
+                   std::istreambuf_iterator<char>());
+    return receive(buffer_.data(), buffer_.size());
+  }
+
+  FrameHeader SadmFrameReceiver::receive(const char* data, std::size_t size) {
+    auto header = parseFrameHeader(data, size, options_);
+    auto frame = parseXml(data, size, header, options_);
+    if (document_)
+      merge(*frame, header);
+    else
+      document_ = std::move(frame);
+    return header;
+  }
+
+  void SadmFrameReceiver::apply(std::shared_ptr<const Document> frame,
+                                const FrameHeader& header) {
+    if (document_)
+      merge(*frame, header);
+    else
+      document_ = frame->deepCopy();
+  }
+
+  void SadmFrameReceiver::reset() { document_.reset(); }
+
+  void SadmFrameReceiver::merge(const Document& frame,
+                                const FrameHeader& header) {
+    FrameMerge(*document_, frame).run(header);
+  }
+
+}  // namespace adm
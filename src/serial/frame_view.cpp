@@ -0,0 +1,28 @@
+#include "adm/serial/frame_view.hpp"
+
+namespace adm {
+
+  namespace {
+    Time windowStart(const FrameFormat& frameFormat) {
+      if (frameFormat.get<TimeReference>() == TimeReference::LOCAL)
+        return std::chrono::nanoseconds::zero();
+      return frameFormat.get<Start>().get();
+    }
+  }  // namespace
+
+  FrameView::FrameView(std::shared_ptr<const Document> document,
+                       const FrameHeader& header)
+      : document_(std::move(document)) {
+    const auto& frameFormat = header.get<FrameFormat>();
+    start_ = windowStart(frameFormat);
+    end_ = start_.asNanoseconds() +
+           frameFormat.get<Duration>()->asNanoseconds();
+  }
+
+  FrameView::FrameView(std::shared_ptr<const Document> document, Time start,
+                       Time end)
+      : document_(std::move(document)),
+        start_(std::move(start)),
+        end_(std::move(end)) {}
+
+}  // namespace adm
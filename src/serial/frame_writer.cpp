@@ -0,0 +1,19 @@
+#include "adm/serial/frame_writer.hpp"
+#include "adm/private/xml_writer.hpp"
+
+namespace adm {
+
+  SadmFrameWriter::SadmFrameWriter(xml::SadmWriterOptions options)
+      : writer_(new xml::SadmFrameXmlWriter(options)) {}
+
+  SadmFrameWriter::~SadmFrameWriter() = default;
+
+  std::ostream& SadmFrameWriter::write(std::shared_ptr<const Document> document,
+                                       const FrameHeader& header,
+                                       std::ostream& stream) {
+    return writer_->write(std::move(document), header, stream);
+  }
+
+  void SadmFrameWriter::clearCache() { writer_->clearCache(); }
+
+}  // namespace adm
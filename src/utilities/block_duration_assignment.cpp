@@ -6,7 +6,9 @@
 #include <memory>
 #include <map>
 #include <stdexcept>
+#include <adm/utilities/tick_time.hpp>
 #include <adm/utilities/time_conversion.hpp>
+#include <vector>
 
 namespace adm {
 
@@ -87,6 +89,102 @@ namespace adm {
       block.set(newDuration);
   }
 
+  namespace {
+    /// convert the difference between two times (in the same timebase) back
+    /// to a Time, in the same form as subtractTimes would give
+    Time timeOfDifference(const Timebase& timebase, TickTime difference,
+                          const Time& firstTime, const Time& secondTime) {
+      if (firstTime.isNanoseconds() && secondTime.isNanoseconds())
+        return timebase.toNanoseconds(difference);
+
+      if (firstTime.isFractional() && secondTime.isFractional()) {
+        int64_t denominator = firstTime.asFractional().denominator();
+        if (denominator == secondTime.asFractional().denominator())
+          return timebase.toFractional(difference, denominator);
+      }
+
+      return timebase.toFractional(difference);
+    }
+
+    /// convert time to ticks of timebase, extending it if necessary
+    ///
+    /// returns boost::none if this is not possible; if timebase was
+    /// extended, extended is set, and times converted before are invalid
+    boost::optional<TickTime> toTicksExtending(Timebase& timebase,
+                                               const Time& time,
+                                               bool& extended) {
+      if (auto ticks = timebase.toTicks(time)) return ticks;
+      if (!timebase.extendTo(time)) return boost::none;
+      extended = true;
+      return timebase.toTicks(time);
+    }
+  }  // namespace
+
+  /// same as the loop in updateBlockFormatDurationWithType, but with all
+  /// times converted to ticks of a common timebase first, so that each
+  /// block only needs integer subtraction and comparison
+  ///
+  /// returns false without changing anything if the times can not be
+  /// represented in a common timebase
+  template <typename BlockType>
+  bool updateBlockFormatDurationWithTicks(BlockFormatsRange<BlockType> blocks,
+                                          const Time& channelFormatDuration) {
+    std::size_t size = blocks.size();
+    Timebase timebase;
+    if (!timebase.extendTo(channelFormatDuration)) return false;
+
+    // start of each block, then the end of the channel
+    std::vector<TickTime> rtimes;
+    rtimes.reserve(size + 1);
+    std::vector<boost::optional<TickTime>> durations;
+    durations.reserve(size);
+
+    // the timebase is extended as times are found which need it; this
+    // normally happens within the first few blocks, and the conversion is
+    // restarted each time
+    for (bool extended = true; extended;) {
+      extended = false;
+      rtimes.clear();
+      durations.clear();
+
+      for (const auto& block : blocks) {
+        auto rtime = toTicksExtending(
+            timebase, block.template get<Rtime>().get(), extended);
+        if (!rtime) return false;
+        if (extended) break;
+        rtimes.push_back(*rtime);
+
+        if (block.template has<Duration>()) {
+          auto duration = toTicksExtending(
+              timebase, block.template get<Duration>().get(), extended);
+          if (!duration) return false;
+          if (extended) break;
+          durations.push_back(duration);
+        } else {
+          durations.emplace_back();
+        }
+      }
+    }
+    auto end = timebase.toTicks(channelFormatDuration);
+    if (!end) return false;
+    rtimes.push_back(*end);
+
+    for (std::size_t i = 0; i < size; i++) {
+      TickTime duration = rtimes[i + 1] - rtimes[i];
+
+      // a single time can have multiple representations, so if the current
+      // time is correct it should be kept
+      if (durations[i] && *durations[i] == duration) continue;
+
+      Time start = blocks[i].template get<Rtime>().get();
+      Time next = i + 1 < size ? blocks[i + 1].template get<Rtime>().get()
+                               : channelFormatDuration;
+      blocks[i].set(
+          Duration{timeOfDifference(timebase, duration, next, start)});
+    }
+    return true;
+  }
+
   template <typename BlockType>
   void updateBlockFormatDurationWithType(AudioChannelFormat* channel,
                                          Time channelFormatDuration) {
@@ -97,6 +195,10 @@ namespace adm {
           channel->get<AudioChannelFormatId>(),
           "AudioChannelFormat has no audioBlockFormats");
 
+    if (updateBlockFormatDurationWithTicks<BlockType>(
+            channel->getElements<BlockType>(), channelFormatDuration))
+      return;
+
     auto next = current;
     next++;
     while (next != end(channel->getElements<BlockType>())) {
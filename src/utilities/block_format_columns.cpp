@@ -0,0 +1,144 @@
+#include "adm/utilities/block_format_columns.hpp"
+#include <algorithm>
+
+namespace adm {
+
+  namespace {
+    /// true if block has parameters other than those in the dense columns,
+    /// or values which they can not represent exactly
+    bool hasOtherParameters(const AudioBlockFormatObjects& block) {
+      if (block.get<Rtime>().get().isFractional()) return true;
+      if (block.has<Duration>() && block.get<Duration>().get().isFractional())
+        return true;
+      if (!block.isDefault<Gain>() && block.get<Gain>().isDb()) return true;
+
+      if (block.has<CartesianPosition>()) {
+        if (block.get<CartesianPosition>().has<ScreenEdgeLock>()) return true;
+      } else if (block.has<SphericalPosition>()) {
+        if (block.get<SphericalPosition>().has<ScreenEdgeLock>()) return true;
+        if (!block.isDefault<Cartesian>()) return true;
+      } else {
+        return true;
+      }
+
+      return block.has<InitializeBlock>() || !block.isDefault<Width>() ||
+             !block.isDefault<Height>() || !block.isDefault<Depth>() ||
+             !block.isDefault<Diffuse>() || !block.isDefault<Importance>() ||
+             !block.isDefault<HeadphoneVirtualise>() ||
+             !block.isDefault<HeadLocked>() || !block.isDefault<ScreenRef>() ||
+             block.has<ScreenEdgeLock>() || !block.isDefault<ChannelLock>() ||
+             !block.isDefault<ObjectDivergence>() ||
+             !block.isDefault<JumpPosition>();
+    }
+  }  // namespace
+
+  AudioBlockFormatObjectsColumns::AudioBlockFormatObjectsColumns(
+      BlockFormatsConstRange<AudioBlockFormatObjects> blockFormats) {
+    reserve(blockFormats.size());
+    for (auto& blockFormat : blockFormats) push_back(blockFormat);
+  }
+
+  AudioBlockFormatObjectsColumns::AudioBlockFormatObjectsColumns(
+      BlockFormatsRange<AudioBlockFormatObjects> blockFormats) {
+    reserve(blockFormats.size());
+    for (auto& blockFormat : blockFormats) push_back(blockFormat);
+  }
+
+  void AudioBlockFormatObjectsColumns::reserve(std::size_t size) {
+    ids_.reserve(size);
+    rtimes_.reserve(size);
+    durations_.reserve(size);
+    azimuthsOrX_.reserve(size);
+    elevationsOrY_.reserve(size);
+    distancesOrZ_.reserve(size);
+    gains_.reserve(size);
+    flags_.reserve(size);
+  }
+
+  void AudioBlockFormatObjectsColumns::push_back(
+      const AudioBlockFormatObjects& blockFormat) {
+    std::uint8_t flags = 0;
+
+    ids_.push_back(blockFormat.get<AudioBlockFormatId>());
+
+    if (!blockFormat.isDefault<Rtime>()) flags |= HAS_RTIME;
+    rtimes_.push_back(blockFormat.get<Rtime>().get().asNanoseconds());
+
+    if (blockFormat.has<Duration>()) {
+      flags |= HAS_DURATION;
+      durations_.push_back(blockFormat.get<Duration>().get().asNanoseconds());
+    } else {
+      durations_.push_back(std::chrono::nanoseconds::zero());
+    }
+
+    if (blockFormat.has<CartesianPosition>()) {
+      auto position = blockFormat.get<CartesianPosition>();
+      flags |= CARTESIAN;
+      if (!position.isDefault<Z>()) flags |= HAS_DISTANCE_OR_Z;
+      azimuthsOrX_.push_back(position.get<X>().get());
+      elevationsOrY_.push_back(position.get<Y>().get());
+      distancesOrZ_.push_back(position.get<Z>().get());
+    } else if (blockFormat.has<SphericalPosition>()) {
+      auto position = blockFormat.get<SphericalPosition>();
+      if (!position.isDefault<Distance>()) flags |= HAS_DISTANCE_OR_Z;
+      azimuthsOrX_.push_back(position.get<Azimuth>().get());
+      elevationsOrY_.push_back(position.get<Elevation>().get());
+      distancesOrZ_.push_back(position.get<Distance>().get());
+    } else {
+      azimuthsOrX_.push_back(0.0f);
+      elevationsOrY_.push_back(0.0f);
+      distancesOrZ_.push_back(0.0f);
+    }
+
+    if (!blockFormat.isDefault<Gain>()) flags |= HAS_GAIN;
+    gains_.push_back(blockFormat.get<Gain>().asLinear());
+
+    if (hasOtherParameters(blockFormat)) {
+      flags |= OTHER;
+      others_.emplace_back(flags_.size(), blockFormat);
+    }
+    flags_.push_back(flags);
+  }
+
+  AudioBlockFormatObjects
+  AudioBlockFormatObjectsColumns::BlockView::toBlockFormat() const {
+    auto flags = this->flags();
+    if (flags & OTHER) {
+      auto& others = columns_->others_;
+      auto it = std::lower_bound(
+          others.begin(), others.end(), index_,
+          [](const std::pair<std::size_t, AudioBlockFormatObjects>& other,
+             std::size_t index) { return other.first < index; });
+      return it->second;
+    }
+
+    auto blockFormat = [&]() {
+      if (flags & CARTESIAN) {
+        CartesianPosition position{X{azimuthOrX()}, Y{elevationOrY()}};
+        if (flags & HAS_DISTANCE_OR_Z) position.set(Z{distanceOrZ()});
+        return AudioBlockFormatObjects{position};
+      } else {
+        SphericalPosition position{Azimuth{azimuthOrX()},
+                                   Elevation{elevationOrY()}};
+        if (flags & HAS_DISTANCE_OR_Z) position.set(Distance{distanceOrZ()});
+        return AudioBlockFormatObjects{position};
+      }
+    }();
+
+    blockFormat.set(id());
+    if (flags & HAS_RTIME) blockFormat.set(Rtime{Time{rtime()}});
+    if (flags & HAS_DURATION)
+      blockFormat.set(Duration{Time{columns_->durations_[index_]}});
+    if (flags & HAS_GAIN) blockFormat.set(Gain::fromLinear(gain()));
+    return blockFormat;
+  }
+
+  std::vector<AudioBlockFormatObjects>
+  AudioBlockFormatObjectsColumns::toBlockFormats() const {
+    std::vector<AudioBlockFormatObjects> blockFormats;
+    blockFormats.reserve(size());
+    for (auto block : *this) blockFormats.push_back(block.toBlockFormat());
+    return blockFormats;
+  }
+
+}  // namespace adm
@@ -4,13 +4,15 @@
 
 namespace adm {
 
-  std::shared_ptr<Document> deepCopy(std::shared_ptr<const Document> document) {
-    return document->deepCopy();
+  std::shared_ptr<Document> deepCopy(std::shared_ptr<const Document> document,
+                                     CopyOptions options) {
+    return document->deepCopy(options);
   }
 
   void deepCopyTo(std::shared_ptr<const Document> src,
-                  std::shared_ptr<Document> dest) {
-    auto copiedElements = copyAllElements(src);
+                  std::shared_ptr<Document> dest, CopyOptions options) {
+    ArenaScope arenaScope(dest->getArena());
+    auto copiedElements = copyAllElements(src, options);
     addElements(copiedElements, dest);
   }
 
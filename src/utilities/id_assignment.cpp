@@ -1,24 +1,81 @@
 #include "adm/utilities/id_assignment.hpp"
+#include "adm/detail/for_each_element.hpp"
+#include "adm/private/parallel_for.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
 
 namespace adm {
+  namespace {
+    template <typename Element>
+    using NewIds =
+        std::unordered_map<const Element*, typename Element::id_type>;
+
+    /**
+     * @brief Number of ID values issued from each range
+     *
+     * Values are issued counting up from 0x1001 (0x00000001 for
+     * AudioTrackUids). AudioChannelFormats, AudioStreamFormats and
+     * AudioTrackFormats share one range for each type descriptor.
+     */
+    struct IdCounts {
+      uint64_t audioProgrammes{0};
+      uint64_t audioContents{0};
+      uint64_t audioObjects{0};
+      uint64_t audioTrackUids{0};
+      std::map<TypeDescriptor, uint64_t> audioPackFormats;
+      std::map<TypeDescriptor, uint64_t> audioChannelStreamTrackFormats;
+    };
+
+    uint64_t countIn(const std::map<TypeDescriptor, uint64_t>& counts,
+                     TypeDescriptor typeDescriptor) {
+      auto it = counts.find(typeDescriptor);
+      return it != counts.end() ? it->second : 0;
+    }
+
+    void checkRange(uint64_t first, uint64_t count, uint64_t last,
+                    const char* message) {
+      if (count && first + count - 1 > last) throw std::runtime_error(message);
+    }
+
+    /// check that the issued ID values fit in the ranges allowed
+    void checkRanges(const IdCounts& counts) {
+      checkRange(0x1001u, counts.audioProgrammes, 0xFFFFu,
+                 "No AudioProgrammeId available");
+      checkRange(0x1001u, counts.audioContents, 0xFFFFu,
+                 "No AudioContentId available");
+      checkRange(0x1001u, counts.audioObjects, 0xFFFFu,
+                 "No AudioObjectId available");
+      checkRange(0x00000001u, counts.audioTrackUids, 0xFFFFFFFFu,
+                 "No AudioTrackUidId available");
+      for (auto& count : counts.audioPackFormats)
+        checkRange(0x1001u, count.second, 0xFFFFu,
+                   "No AudioPackFormatId available");
+      for (auto& count : counts.audioChannelStreamTrackFormats)
+        checkRange(0x1001u, count.second, 0xFFFFu,
+                   "No common AudioChannelFormat, AudioStreamFormat, "
+                   "AudioTrackFormat ID value available");
+    }
+  }  // namespace
+
   /**
    * @brief Reassigns ID's to all elements within a Document.
    *
-   * Works by clearing existing ID's and then reassigning unique
-   * ID's to each element. For AudioTrackFormat, AudioStreamFormat
-   * and AudioChannelFormat, new ID's are only assigned if they
-   * form a functional part of the ADM though releationships to
-   * other elements. Those that don't do not get assigned new ID's
-   * after being cleared and are therefore marked as elements to
-   * be ignored.
-   * 
+   * Works in two passes: plan() finds the new ID of each element, storing
+   * them in hash maps without changing the document, then apply() sets
+   * them all, updating the document's ID index once at the end. For
+   * AudioTrackFormat, AudioStreamFormat and AudioChannelFormat, new ID's
+   * are only assigned if they form a functional part of the ADM though
+   * releationships to other elements. Those that don't are given undefined
+   * ID's and are therefore marked as elements to be ignored.
+   *
    * @note This class differs from IdAssigner in that it is more
-   * efficient for this purpose. IdAssigner uses lookups to find
-   * an available ID, which has exponential complexity. 
-   * IdReassigner uses the IdIssuer class to track ID's through
-   * simple incrementation and so has linear complexity.
-   * 
-   * @param document Document that will have element ID's 
+   * efficient for this purpose. IdAssigner has to avoid the ID's
+   * already in the document, while IdReassigner uses the IdIssuer
+   * class to track ID's through simple incrementation, and so has
+   * linear complexity.
+   *
+   * @param document Document that will have element ID's
    * reassigned.
    */
   class IdReassigner {
@@ -26,6 +83,14 @@ namespace adm {
     IdReassigner(std::shared_ptr<Document> document);
     void reassignAllIds();
 
+    /// find the new ID's, without changing the document
+    void plan();
+    /// the number of ID values issued by plan()
+    const IdCounts& counts() const { return idIssuer.counts(); }
+    /// set the ID's found by plan(), with values in each range increased by
+    /// the counts in offsets
+    void apply(const IdCounts& offsets);
+
    private:
     void reassignAudioProgrammeIds();
     void reassignAudioContentIds();
@@ -33,22 +98,29 @@ namespace adm {
     void reassignAudioPackFormatIds();
     void reassignAudioStreamFormatIds();
     void reassignAudioTrackUidIds();
-    void reassignAudioBlockFormatIds(
-        std::shared_ptr<AudioChannelFormat> audioChannelFormat);
+
+    template <typename Element>
+    void undefineIds();
+    template <typename Element>
+    void applyIds(const IdCounts& offsets);
+    void applyAudioBlockFormatIds(
+        const std::shared_ptr<AudioChannelFormat>& audioChannelFormat);
 
     /**
      * @brief Class responsible for issuing new ID's for elements.
      *
-     * Starts at initial ID values and counts up as ID's are 
+     * Starts at initial ID values and counts up as ID's are
      * handed out. Ensures ID's are sequential and unique.
      * A single ID value can also be issued for a related group
-     * of AudioTrackFormat, AudioStreamFormat and 
+     * of AudioTrackFormat, AudioStreamFormat and
      * AudioChannelFormat elements to make the ADM XML easier to
      * follow.
+     *
+     * The ranges are checked when the ID's are applied, as ID's issued for
+     * several documents are offset into disjoint ranges.
      */
     class IdIssuer {
      public:
-      IdIssuer();
       AudioProgrammeId issueAudioProgrammeId();
       AudioContentId issueAudioContentId();
       AudioObjectId issueAudioObjectId();
@@ -56,44 +128,68 @@ namespace adm {
       AudioPackFormatId issueAudioPackFormatId(TypeDescriptor typeDescriptor);
       AudioChannelFormatId issueAudioChannelFormatId(
           TypeDescriptor typeDescriptor);
-      uint16_t issueAudioChannelStreamTrackFormatIdValue(
+      uint32_t issueAudioChannelStreamTrackFormatIdValue(
           TypeDescriptor typeDescriptor);
 
-     private:
-      uint32_t nextAudioProgrammeIdValue{0x1001u};
-      uint32_t nextAudioContentIdValue{0x1001u};
-      uint32_t nextAudioObjectIdValue{0x1001u};
-      uint64_t nextAudioTrackUidIdValue{0x00000001u};
-      std::map<TypeDescriptor, uint32_t> nextAudioPackFormatIdValue;
-      std::map<TypeDescriptor, uint32_t>
-          nextAudioChannelStreamTrackFormatIdValue;
+      const IdCounts& counts() const { return counts_; }
 
+     private:
+      IdCounts counts_;
     } idIssuer;
 
     std::shared_ptr<Document> document;
+    detail::ForEachElement<NewIds> newIds;
+    /// AudioChannelFormats which were given a new ID, so their
+    /// audioBlockFormats need new IDs too
+    std::unordered_set<const AudioChannelFormat*> blockFormatsToReassign;
   };
 
-  template <typename It>
-  void undefineIds(It begin, It end) {
-    for (auto it = begin; it != end; ++it) {
-      auto element = *it;
-      using ElementId = typename decltype(element)::element_type::id_type;
-      auto id = element->template get<ElementId>();
-      if (!isCommonDefinitionsId(id)) {
-        element->set(ElementId());
-      }
-    }
-  }
-
   void reassignIds(std::shared_ptr<Document> document) {
     IdReassigner idReassigner(document);
     idReassigner.reassignAllIds();
   }
 
+  void reassignIds(const std::vector<std::shared_ptr<Document>>& documents) {
+    std::vector<IdReassigner> idReassigners;
+    idReassigners.reserve(documents.size());
+    for (auto& document : documents) idReassigners.emplace_back(document);
+
+    detail::parallelFor(documents.size(),
+                        [&](std::size_t i) { idReassigners[i].plan(); });
+
+    // each document starts where the previous one finished
+    std::vector<IdCounts> offsets(documents.size());
+    IdCounts total;
+    for (std::size_t i = 0; i < documents.size(); i++) {
+      offsets[i] = total;
+      const auto& counts = idReassigners[i].counts();
+      total.audioProgrammes += counts.audioProgrammes;
+      total.audioContents += counts.audioContents;
+      total.audioObjects += counts.audioObjects;
+      total.audioTrackUids += counts.audioTrackUids;
+      for (auto& count : counts.audioPackFormats)
+        total.audioPackFormats[count.first] += count.second;
+      for (auto& count : counts.audioChannelStreamTrackFormats)
+        total.audioChannelStreamTrackFormats[count.first] += count.second;
+    }
+
+    checkRanges(total);
+
+    detail::parallelFor(documents.size(), [&](std::size_t i) {
+      idReassigners[i].apply(offsets[i]);
+    });
+  }
+
   IdReassigner::IdReassigner(std::shared_ptr<Document> document)
       : document{document} {}
 
   void IdReassigner::reassignAllIds() {
+    plan();
+    checkRanges(idIssuer.counts());
+    apply(IdCounts{});
+  }
+
+  void IdReassigner::plan() {
     reassignAudioProgrammeIds();
     reassignAudioContentIds();
     reassignAudioObjectIds();
@@ -102,71 +198,79 @@ namespace adm {
      * Initialize all audioTrackFormatIds and audioChanneldFormatIds to zero.
      * The reason behind this is, that the reassignAudioStreamFormatIds
      * algorithm only gives new IDs to audioTrackFormats and
-     * audioChannelFormats which are referenced by an audioStreamFormat. 
-     * Additionally, audioStreamFormats are only given a valid ID if they 
-     * reference an audioChannelFormat. This should be the right way to do it 
-     * for 2076-0/1 structures. Unreferenced elements will get an ID with 
+     * audioChannelFormats which are referenced by an audioStreamFormat.
+     * Additionally, audioStreamFormats are only given a valid ID if they
+     * reference an audioChannelFormat. This should be the right way to do it
+     * for 2076-0/1 structures. Unreferenced elements will get an ID with
      * value 0 and are thereby marked as elements which should be ignored.
      * For 2076-2 structures, reassignAudioTrackUidIds will apply a unique ID
      * to audioChannelFormats referenced directly from audioTrackUids.
      */
-    undefineIds(document->getElements<AudioTrackFormat>().begin(),
-                document->getElements<AudioTrackFormat>().end());
-    undefineIds(document->getElements<AudioChannelFormat>().begin(),
-                document->getElements<AudioChannelFormat>().end());
+    undefineIds<AudioTrackFormat>();
+    undefineIds<AudioChannelFormat>();
     reassignAudioStreamFormatIds();
     reassignAudioTrackUidIds();
   }
 
+  template <typename Element>
+  void IdReassigner::undefineIds() {
+    using ElementId = typename Element::id_type;
+    auto& ids = newIds.get<Element>();
+    for (auto& element : document->getElements<Element>()) {
+      if (!isCommonDefinitionsId(element->template get<ElementId>())) {
+        ids[element.get()] = ElementId();
+      }
+    }
+  }
+
   void IdReassigner::reassignAudioProgrammeIds() {
-    auto audioProgrammes = document->getElements<AudioProgramme>();
-    undefineIds(audioProgrammes.begin(), audioProgrammes.end());
-    for (auto audioProgramme : audioProgrammes) {
+    auto& ids = newIds.get<AudioProgramme>();
+    for (auto& audioProgramme : document->getElements<AudioProgramme>()) {
       auto audioProgrammeId = audioProgramme->get<AudioProgrammeId>();
       if (!isCommonDefinitionsId(audioProgrammeId)) {
-        audioProgramme->set(idIssuer.issueAudioProgrammeId());
+        ids[audioProgramme.get()] = idIssuer.issueAudioProgrammeId();
       }
     }
   }
 
   void IdReassigner::reassignAudioContentIds() {
-    auto audioContents = document->getElements<AudioContent>();
-    undefineIds(audioContents.begin(), audioContents.end());
-    for (auto audioContent : audioContents) {
+    auto& ids = newIds.get<AudioContent>();
+    for (auto& audioContent : document->getElements<AudioContent>()) {
       auto audioContentId = audioContent->get<AudioContentId>();
       if (!isCommonDefinitionsId(audioContentId)) {
-        audioContent->set(idIssuer.issueAudioContentId());
+        ids[audioContent.get()] = idIssuer.issueAudioContentId();
       }
     }
   }
 
   void IdReassigner::reassignAudioObjectIds() {
-    auto audioObjects = document->getElements<AudioObject>();
-    undefineIds(audioObjects.begin(), audioObjects.end());
-    for (auto audioObject : audioObjects) {
+    auto& ids = newIds.get<AudioObject>();
+    for (auto& audioObject : document->getElements<AudioObject>()) {
       auto audioObjectId = audioObject->get<AudioObjectId>();
       if (!isCommonDefinitionsId(audioObjectId)) {
-        audioObject->set(idIssuer.issueAudioObjectId());
+        ids[audioObject.get()] = idIssuer.issueAudioObjectId();
       }
     }
   }
 
   void IdReassigner::reassignAudioPackFormatIds() {
-    auto audioPackFormats = document->getElements<AudioPackFormat>();
-    undefineIds(audioPackFormats.begin(), audioPackFormats.end());
-    for (auto audioPackFormat : audioPackFormats) {
+    auto& ids = newIds.get<AudioPackFormat>();
+    for (auto& audioPackFormat : document->getElements<AudioPackFormat>()) {
       auto typeDescriptor = audioPackFormat->get<TypeDescriptor>();
       auto audioPackFormatId = audioPackFormat->get<AudioPackFormatId>();
       if (!isCommonDefinitionsId(audioPackFormatId)) {
-        audioPackFormat->set(idIssuer.issueAudioPackFormatId(typeDescriptor));
+        ids[audioPackFormat.get()] =
+            idIssuer.issueAudioPackFormatId(typeDescriptor);
       }
     }
   }
 
   void IdReassigner::reassignAudioStreamFormatIds() {
-    auto audioStreamFormats = document->getElements<AudioStreamFormat>();
-    undefineIds(audioStreamFormats.begin(), audioStreamFormats.end());
-    for (auto audioStreamFormat : audioStreamFormats) {
+    undefineIds<AudioStreamFormat>();
+    auto& streamFormatIds = newIds.get<AudioStreamFormat>();
+    auto& channelFormatIds = newIds.get<AudioChannelFormat>();
+    auto& trackFormatIds = newIds.get<AudioTrackFormat>();
+    for (auto& audioStreamFormat : document->getElements<AudioStreamFormat>()) {
       auto audioChannelFormat =
           audioStreamFormat->getReference<AudioChannelFormat>();
       if (!audioChannelFormat) {
@@ -174,7 +278,7 @@ namespace adm {
         continue;
       }
       auto typeDescriptor = audioChannelFormat->get<TypeDescriptor>();
-      uint16_t idValue =
+      uint32_t idValue =
           0;  // don't issue unless needed - 0 (invalid) denotes unset
 
       // AudioStreamFormat
@@ -183,9 +287,8 @@ namespace adm {
         if (idValue == 0)
           idValue = idIssuer.issueAudioChannelStreamTrackFormatIdValue(
               typeDescriptor);
-        audioStreamFormatId.set(typeDescriptor);
-        audioStreamFormatId.set(AudioStreamFormatIdValue{idValue});
-        audioStreamFormat->set(audioStreamFormatId);
+        streamFormatIds[audioStreamFormat.get()] = AudioStreamFormatId(
+            typeDescriptor, AudioStreamFormatIdValue{idValue});
       }
 
       // AudioChannelFormat
@@ -195,10 +298,9 @@ namespace adm {
         if (idValue == 0)
           idValue = idIssuer.issueAudioChannelStreamTrackFormatIdValue(
               typeDescriptor);
-        audioChannelFormatId.set(typeDescriptor);
-        audioChannelFormatId.set(AudioChannelFormatIdValue{idValue});
-        audioChannelFormat->set(audioChannelFormatId);
-        reassignAudioBlockFormatIds(audioChannelFormat);
+        channelFormatIds[audioChannelFormat.get()] = AudioChannelFormatId(
+            typeDescriptor, AudioChannelFormatIdValue{idValue});
+        blockFormatsToReassign.insert(audioChannelFormat.get());
       }
 
       // AudioTrackFormats
@@ -216,10 +318,9 @@ namespace adm {
                 typeDescriptor);
           if (audioTrackFormatIdCounter > 0xFFu)
             throw std::runtime_error("No AudioTrackFormatIdCounter available");
-          audioTrackFormatId.set(typeDescriptor);
-          audioTrackFormatId.set(AudioTrackFormatIdValue{idValue});
-          audioTrackFormatId.set(audioTrackFormatIdCounter);
-          audioTrackFormat->set(audioTrackFormatId);
+          trackFormatIds[audioTrackFormat.get()] = AudioTrackFormatId(
+              typeDescriptor, AudioTrackFormatIdValue{idValue},
+              audioTrackFormatIdCounter);
           audioTrackFormatIdCounter++;
         }
       }
@@ -227,10 +328,10 @@ namespace adm {
   }
 
   void IdReassigner::reassignAudioTrackUidIds() {
-    auto audioTrackUids = document->getElements<AudioTrackUid>();
-    undefineIds(audioTrackUids.begin(), audioTrackUids.end());
-    for (auto audioTrackUid : audioTrackUids) {
-      audioTrackUid->set(idIssuer.issueAudioTrackUidId());
+    auto& trackUidIds = newIds.get<AudioTrackUid>();
+    auto& channelFormatIds = newIds.get<AudioChannelFormat>();
+    for (auto& audioTrackUid : document->getElements<AudioTrackUid>()) {
+      trackUidIds[audioTrackUid.get()] = idIssuer.issueAudioTrackUidId();
       auto audioChannelFormat =
           audioTrackUid->getReference<adm::AudioChannelFormat>();
       if (audioChannelFormat) {
@@ -238,14 +339,103 @@ namespace adm {
             audioChannelFormat->get<AudioChannelFormatId>();
         if (!isCommonDefinitionsId(audioChannelFormatId)) {
           auto typeDescriptor = audioChannelFormat->get<TypeDescriptor>();
-          audioChannelFormat->set(
-              idIssuer.issueAudioChannelFormatId(typeDescriptor));
-          reassignAudioBlockFormatIds(audioChannelFormat);
+          channelFormatIds[audioChannelFormat.get()] =
+              idIssuer.issueAudioChannelFormatId(typeDescriptor);
+          blockFormatsToReassign.insert(audioChannelFormat.get());
         }
       }
     }
   }
 
+  namespace {
+    /// offset the issued values in id by the values issued before it
+    AudioProgrammeId offsetId(AudioProgrammeId id, const IdCounts& offsets) {
+      auto value = id.get<AudioProgrammeIdValue>().get();
+      if (value) id.set(AudioProgrammeIdValue(value + offsets.audioProgrammes));
+      return id;
+    }
+    AudioContentId offsetId(AudioContentId id, const IdCounts& offsets) {
+      auto value = id.get<AudioContentIdValue>().get();
+      if (value) id.set(AudioContentIdValue(value + offsets.audioContents));
+      return id;
+    }
+    AudioObjectId offsetId(AudioObjectId id, const IdCounts& offsets) {
+      auto value = id.get<AudioObjectIdValue>().get();
+      if (value) id.set(AudioObjectIdValue(value + offsets.audioObjects));
+      return id;
+    }
+    AudioTrackUidId offsetId(AudioTrackUidId id, const IdCounts& offsets) {
+      auto value = id.get<AudioTrackUidIdValue>().get();
+      if (value)
+        id.set(AudioTrackUidIdValue(
+            static_cast<uint32_t>(value + offsets.audioTrackUids)));
+      return id;
+    }
+    AudioPackFormatId offsetId(AudioPackFormatId id, const IdCounts& offsets) {
+      auto value = id.get<AudioPackFormatIdValue>().get();
+      if (value)
+        id.set(AudioPackFormatIdValue(
+            value +
+            countIn(offsets.audioPackFormats, id.get<TypeDescriptor>())));
+      return id;
+    }
+    AudioChannelFormatId offsetId(AudioChannelFormatId id,
+                                  const IdCounts& offsets) {
+      auto value = id.get<AudioChannelFormatIdValue>().get();
+      if (value)
+        id.set(AudioChannelFormatIdValue(
+            value + countIn(offsets.audioChannelStreamTrackFormats,
+                            id.get<TypeDescriptor>())));
+      return id;
+    }
+    AudioStreamFormatId offsetId(AudioStreamFormatId id,
+                                 const IdCounts& offsets) {
+      auto value = id.get<AudioStreamFormatIdValue>().get();
+      if (value)
+        id.set(AudioStreamFormatIdValue(
+            value + countIn(offsets.audioChannelStreamTrackFormats,
+                            id.get<TypeDescriptor>())));
+      return id;
+    }
+    AudioTrackFormatId offsetId(AudioTrackFormatId id,
+                                const IdCounts& offsets) {
+      auto value = id.get<AudioTrackFormatIdValue>().get();
+      if (value)
+        id.set(AudioTrackFormatIdValue(
+            value + countIn(offsets.audioChannelStreamTrackFormats,
+                            id.get<TypeDescriptor>())));
+      return id;
+    }
+  }  // namespace
+
+  void IdReassigner::apply(const IdCounts& offsets) {
+    // the new ID's may be in use by elements which have not been updated
+    // yet, so the document's ID index is rebuilt once all are set
+    document->beginIdChanges();
+    applyIds<AudioProgramme>(offsets);
+    applyIds<AudioContent>(offsets);
+    applyIds<AudioObject>(offsets);
+    applyIds<AudioPackFormat>(offsets);
+    applyIds<AudioChannelFormat>(offsets);
+    applyIds<AudioStreamFormat>(offsets);
+    applyIds<AudioTrackFormat>(offsets);
+    applyIds<AudioTrackUid>(offsets);
+
+    for (auto& audioChannelFormat : document->getElements<AudioChannelFormat>())
+      if (blockFormatsToReassign.count(audioChannelFormat.get()))
+        applyAudioBlockFormatIds(audioChannelFormat);
+    document->endIdChanges();
+  }
+
+  template <typename Element>
+  void IdReassigner::applyIds(const IdCounts& offsets) {
+    auto& ids = newIds.get<Element>();
+    for (auto& element : document->getElements<Element>()) {
+      auto it = ids.find(element.get());
+      if (it != ids.end()) element->set(offsetId(it->second, offsets));
+    }
+  }
+
   namespace {
     template <typename T>
     void reassignBlockFormats(std::shared_ptr<AudioChannelFormat> const& acf) {
@@ -266,8 +456,8 @@ namespace adm {
     }
   }  // namespace
 
-  void IdReassigner::reassignAudioBlockFormatIds(
-      std::shared_ptr<AudioChannelFormat> audioChannelFormat) {
+  void IdReassigner::applyAudioBlockFormatIds(
+      const std::shared_ptr<AudioChannelFormat>& audioChannelFormat) {
     auto typeDefinition = audioChannelFormat->get<TypeDescriptor>();
     if (typeDefinition == TypeDefinition::DIRECT_SPEAKERS) {
       reassignBlockFormats<AudioBlockFormatDirectSpeakers>(audioChannelFormat);
@@ -282,73 +472,56 @@ namespace adm {
     }
   }
 
-  IdReassigner::IdIssuer::IdIssuer() {}
   AudioProgrammeId IdReassigner::IdIssuer::issueAudioProgrammeId() {
-    if (nextAudioProgrammeIdValue > 0xFFFFu)
-      throw std::runtime_error("No AudioProgrammeId available");
     AudioProgrammeId id;
-    id.set(AudioProgrammeIdValue(nextAudioProgrammeIdValue++));
+    id.set(AudioProgrammeIdValue(
+        static_cast<uint32_t>(0x1001u + counts_.audioProgrammes++)));
     return id;
   }
 
   AudioContentId IdReassigner::IdIssuer::issueAudioContentId() {
-    if (nextAudioContentIdValue > 0xFFFFu)
-      throw std::runtime_error("No AudioContentId available");
     AudioContentId id;
-    id.set(AudioContentIdValue(nextAudioContentIdValue++));
+    id.set(AudioContentIdValue(
+        static_cast<uint32_t>(0x1001u + counts_.audioContents++)));
     return id;
   }
 
   AudioObjectId IdReassigner::IdIssuer::issueAudioObjectId() {
-    if (nextAudioObjectIdValue > 0xFFFFu)
-      throw std::runtime_error("No AudioObjectId available");
     AudioObjectId id;
-    id.set(AudioObjectIdValue(nextAudioObjectIdValue++));
+    id.set(AudioObjectIdValue(
+        static_cast<uint32_t>(0x1001u + counts_.audioObjects++)));
     return id;
   }
 
   AudioTrackUidId IdReassigner::IdIssuer::issueAudioTrackUidId() {
-    if (nextAudioTrackUidIdValue > 0xFFFFFFFFu)
-      throw std::runtime_error("No AudioTrackUidId available");
     AudioTrackUidId id;
     id.set(AudioTrackUidIdValue(
-        static_cast<uint32_t>(nextAudioTrackUidIdValue++)));
+        static_cast<uint32_t>(0x00000001u + counts_.audioTrackUids++)));
     return id;
   }
 
   AudioPackFormatId IdReassigner::IdIssuer::issueAudioPackFormatId(
       TypeDescriptor typeDescriptor) {
-    auto it = nextAudioPackFormatIdValue.emplace(typeDescriptor, 0x1001).first;
-    if (it->second > 0xFFFFu)
-      throw std::runtime_error("No AudioPackFormatId available");
+    auto& count = counts_.audioPackFormats[typeDescriptor];
     AudioPackFormatId id;
     id.set(typeDescriptor);
-    id.set(AudioPackFormatIdValue(it->second++));
+    id.set(AudioPackFormatIdValue(static_cast<uint32_t>(0x1001u + count++)));
     return id;
   }
 
   AudioChannelFormatId IdReassigner::IdIssuer::issueAudioChannelFormatId(
       TypeDescriptor typeDescriptor) {
-    auto it =
-        nextAudioChannelStreamTrackFormatIdValue.emplace(typeDescriptor, 0x1001)
-            .first;
-    if (it->second > 0xFFFFu)
-      throw std::runtime_error("No AudioChannelFormatId available");
     AudioChannelFormatId id;
     id.set(typeDescriptor);
-    id.set(AudioChannelFormatIdValue(it->second++));
+    id.set(AudioChannelFormatIdValue(
+        issueAudioChannelStreamTrackFormatIdValue(typeDescriptor)));
     return id;
   }
-  uint16_t IdReassigner::IdIssuer::issueAudioChannelStreamTrackFormatIdValue(
+
+  uint32_t IdReassigner::IdIssuer::issueAudioChannelStreamTrackFormatIdValue(
       TypeDescriptor typeDescriptor) {
-    auto it =
-        nextAudioChannelStreamTrackFormatIdValue.emplace(typeDescriptor, 0x1001)
-            .first;
-    if (it->second > 0xFFFFu)
-      throw std::runtime_error(
-          "No common AudioChannelFormat, AudioStreamFormat, AudioTrackFormat "
-          "ID value available");
-    return static_cast<uint16_t>(it->second++);
+    auto& count = counts_.audioChannelStreamTrackFormats[typeDescriptor];
+    return static_cast<uint32_t>(0x1001u + count++);
   }
 
 }  // namespace adm
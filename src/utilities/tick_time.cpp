@@ -0,0 +1,102 @@
+#include "adm/utilities/tick_time.hpp"
+#include <boost/integer/common_factor.hpp>
+#include <limits>
+#include <stdexcept>
+
+namespace adm {
+
+  namespace {
+    const int64_t nanosecondsPerSecond = 1000000000;
+
+    bool multiplyOverflows(int64_t a, int64_t b) {
+      // b is always positive here; avoid the divisions for small values,
+      // which are by far the most common
+      const int64_t small = int64_t{1} << 31;
+      if (a > -small && a < small && b < small) return false;
+      return a > std::numeric_limits<int64_t>::max() / b ||
+             a < std::numeric_limits<int64_t>::min() / b;
+    }
+  }  // namespace
+
+  Timebase::Timebase(int64_t ticksPerSecond)
+      : ticksPerSecond_(ticksPerSecond) {
+    if (ticksPerSecond < 1)
+      throw std::invalid_argument("Timebase ticksPerSecond must be positive");
+    updateNanosecondScale();
+  }
+
+  void Timebase::updateNanosecondScale() {
+    int64_t gcd = boost::integer::gcd(ticksPerSecond_, nanosecondsPerSecond);
+    nanosecondDivisor_ = nanosecondsPerSecond / gcd;
+    nanosecondFactor_ = ticksPerSecond_ / gcd;
+  }
+
+  bool Timebase::extendTo(const Time& time) {
+    int64_t denominator;
+    if (auto ns = boost::get<std::chrono::nanoseconds>(&time.asVariant())) {
+      if (ns->count() % nanosecondDivisor_ == 0) return true;
+      // the form of times in nanoseconds is not kept, so use the smallest
+      // denominator which represents them
+      denominator = nanosecondsPerSecond /
+                    boost::integer::gcd(ns->count(), nanosecondsPerSecond);
+    } else {
+      denominator = boost::get<FractionalTime>(time.asVariant()).denominator();
+      if (ticksPerSecond_ % denominator == 0) return true;
+    }
+
+    int64_t factor =
+        denominator / boost::integer::gcd(ticksPerSecond_, denominator);
+    if (multiplyOverflows(ticksPerSecond_, factor)) return false;
+    ticksPerSecond_ *= factor;
+    updateNanosecondScale();
+    return true;
+  }
+
+  boost::optional<TickTime> Timebase::toTicks(const Time& time) const {
+    if (auto ns = boost::get<std::chrono::nanoseconds>(&time.asVariant())) {
+      if (ns->count() % nanosecondDivisor_ != 0) return boost::none;
+      int64_t quotient = ns->count() / nanosecondDivisor_;
+      if (multiplyOverflows(quotient, nanosecondFactor_)) return boost::none;
+      return TickTime{quotient * nanosecondFactor_};
+    }
+
+    auto& fractional = boost::get<FractionalTime>(time.asVariant());
+    int64_t numerator = fractional.numerator();
+    int64_t denominator = fractional.denominator();
+    if (ticksPerSecond_ % denominator != 0) {
+      // may still be representable once common factors are removed
+      int64_t gcd = boost::integer::gcd(numerator, denominator);
+      numerator /= gcd;
+      denominator /= gcd;
+      if (ticksPerSecond_ % denominator != 0) return boost::none;
+    }
+
+    int64_t factor = ticksPerSecond_ / denominator;
+    if (multiplyOverflows(numerator, factor)) return boost::none;
+    return TickTime{numerator * factor};
+  }
+
+  std::chrono::nanoseconds Timebase::toNanoseconds(TickTime time) const {
+    if (ticksPerSecond_ % nanosecondsPerSecond == 0)
+      return std::chrono::nanoseconds{
+          time.ticks / (ticksPerSecond_ / nanosecondsPerSecond)};
+    if (nanosecondsPerSecond % ticksPerSecond_ == 0)
+      return std::chrono::nanoseconds{
+          time.ticks * (nanosecondsPerSecond / ticksPerSecond_)};
+    return Time{toFractional(time)}.asNanoseconds();
+  }
+
+  FractionalTime Timebase::toFractional(TickTime time) const {
+    int64_t gcd = boost::integer::gcd(time.ticks, ticksPerSecond_);
+    return {time.ticks / gcd, ticksPerSecond_ / gcd};
+  }
+
+  FractionalTime Timebase::toFractional(TickTime time,
+                                        int64_t denominator) const {
+    if (denominator < 1 || ticksPerSecond_ % denominator != 0)
+      throw std::invalid_argument(
+          "denominator must divide the Timebase ticksPerSecond");
+    return {time.ticks / (ticksPerSecond_ / denominator), denominator};
+  }
+
+}  // namespace adm
@@ -1,6 +1,7 @@
 #include "adm/write.hpp"
 #include <fstream>
 #include "adm/private/xml_writer.hpp"
+#include "adm/serial/frame_view.hpp"
 
 namespace adm {
 
@@ -33,4 +34,11 @@ namespace adm {
     xml::SadmXmlWriter writer(options);
     return writer.write(admDocument, frameHeader, stream);
   }
+
+  std::ostream& writeXml(std::ostream& stream, const FrameView& frameView,
+                         FrameHeader const& frameHeader,
+                         xml::SadmWriterOptions options) {
+    xml::SadmXmlWriter writer(options);
+    return writer.write(frameView, frameHeader, stream);
+  }
 }  // namespace adm
@@ -1,5 +1,32 @@
 #include <catch2/catch.hpp>
+#include <fstream>
+#include <regex>
+#include <sstream>
 #include "adm/common_definitions.hpp"
+#include "adm/common_definitions_tables.hpp"
+#include "adm/parse.hpp"
+#include "adm/write.hpp"
+
+namespace {
+  // the writer skips elements with common definitions IDs, so to compare
+  // them, move them out of the common definitions range by adding 0x1000 to
+  // all ID values
+  template <typename Element, typename IdValue>
+  void moveIds(std::shared_ptr<adm::Document> document) {
+    using Id = typename Element::id_type;
+    for (auto element : document->getElements<Element>()) {
+      auto id = element->template get<Id>();
+      id.set(IdValue(id.template get<IdValue>().get() + 0x1000));
+      element->set(id);
+    }
+  }
+
+  /// the same as moveIds, but on the common definitions XML
+  std::string moveIds(const std::string& xml) {
+    return std::regex_replace(xml, std::regex("(A[BCPST])_([0-9a-f]{4})0"),
+                              "$1_$021");
+  }
+}  // namespace
 
 TEST_CASE("basic_document") {
   using namespace adm;
@@ -8,6 +35,107 @@ TEST_CASE("basic_document") {
   { auto commonDefinitions = getCommonDefinitions(); }
 }
 
+TEST_CASE("common definitions are independent copies") {
+  using namespace adm;
+
+  auto first = getCommonDefinitions();
+  auto second = getCommonDefinitions();
+  auto id = parseAudioPackFormatId("AP_00010002");
+
+  auto firstPack = first->lookup(id);
+  auto secondPack = second->lookup(id);
+  REQUIRE(firstPack != nullptr);
+  REQUIRE(secondPack != nullptr);
+  REQUIRE(firstPack != secondPack);
+
+  REQUIRE(first->remove(firstPack));
+  REQUIRE(first->lookup(id) == nullptr);
+  REQUIRE(getCommonDefinitions()->lookup(id) != nullptr);
+  REQUIRE(second->getElements<AudioPackFormat>().size() ==
+          getCommonDefinitions()->getElements<AudioPackFormat>().size());
+}
+
+TEST_CASE("common definitions match the XML file") {
+  using namespace adm;
+
+  std::ifstream file("common_definitions.xml");
+  std::stringstream xml;
+  xml << file.rdbuf();
+  std::stringstream movedXml(moveIds(xml.str()));
+  auto parsed =
+      parseXml(movedXml, xml::ParserOptions::recursive_node_search);
+
+  auto generated = getCommonDefinitions();
+  REQUIRE(generated->getElements<AudioPackFormat>().size() == 43);
+  REQUIRE(generated->getElements<AudioChannelFormat>().size() == 300);
+  moveIds<AudioPackFormat, AudioPackFormatIdValue>(generated);
+  moveIds<AudioChannelFormat, AudioChannelFormatIdValue>(generated);
+  moveIds<AudioStreamFormat, AudioStreamFormatIdValue>(generated);
+  moveIds<AudioTrackFormat, AudioTrackFormatIdValue>(generated);
+
+  std::stringstream parsedXml;
+  writeXml(parsedXml, parsed);
+  std::stringstream generatedXml;
+  writeXml(generatedXml, generated);
+  REQUIRE(generatedXml.str().size() > xml.str().size() / 2);
+  REQUIRE(generatedXml.str() == parsedXml.str());
+}
+
+TEST_CASE("common definitions tables") {
+  using namespace adm;
+  using namespace adm::common_definitions;
+
+  SECTION("lookup by ID") {
+    auto pack = lookup(parseAudioPackFormatId("AP_00010003"));
+    REQUIRE(pack != nullptr);
+    REQUIRE(pack->name == std::string("urn:itu:bs:2051:0:pack:5.1_(0+5+0)"));
+    REQUIRE(getId(*pack) == parseAudioPackFormatId("AP_00010003"));
+    REQUIRE(pack->channelFormats.size() == 6);
+
+    auto& lfe = channelFormats()[pack->channelFormats[3]];
+    REQUIRE(lookup(parseAudioChannelFormatId("AC_00010004")) == &lfe);
+    REQUIRE(lfe.speakerLabel == std::string("urn:itu:bs:2051:0:speaker:LFE"));
+    REQUIRE(lfe.hasLowPass);
+    REQUIRE(lfe.lowPass == 120.0f);
+    REQUIRE(lfe.elevation == -30.0f);
+
+    auto track = lookup(parseAudioTrackFormatId("AT_00040011_01"));
+    REQUIRE(track != nullptr);
+    auto& stream = streamFormats()[track->streamFormat];
+    REQUIRE(getId(stream) == parseAudioStreamFormatId("AS_00040011"));
+    auto& hoaChannel = channelFormats()[stream.channelFormat];
+    REQUIRE(hoaChannel.order == 4);
+    REQUIRE(hoaChannel.degree == -4);
+    REQUIRE(hoaChannel.normalization == std::string("SN3D"));
+
+    REQUIRE(lookup(parseAudioPackFormatId("AP_00011001")) == nullptr);
+    REQUIRE(lookup(parseAudioTrackFormatId("AT_00010001_02")) == nullptr);
+  }
+
+  SECTION("all entries can be found by ID") {
+    for (auto& entry : packFormats()) REQUIRE(lookup(getId(entry)) == &entry);
+    for (auto& entry : channelFormats())
+      REQUIRE(lookup(getId(entry)) == &entry);
+    for (auto& entry : streamFormats()) REQUIRE(lookup(getId(entry)) == &entry);
+    for (auto& entry : trackFormats()) REQUIRE(lookup(getId(entry)) == &entry);
+  }
+
+  SECTION("lookup by layout") {
+    auto pack = lookupSpeakerLayout("0+2+0");
+    REQUIRE(pack != nullptr);
+    REQUIRE(getId(*pack) == parseAudioPackFormatId("AP_00010002"));
+    REQUIRE(lookupSpeakerLayout("9+10+3")->channelFormats.size() == 24);
+    REQUIRE(lookupSpeakerLayout("1+2+3") == nullptr);
+
+    // higher order FuMa packs are not in the common definitions
+    REQUIRE(lookupSpeakerLayout("FuMa-Order3-3D") != nullptr);
+    REQUIRE(lookupSpeakerLayout("FuMa-Order4-3D") == nullptr);
+    for (auto& layout : speakerLayouts())
+      if (std::string(layout.name).find("FuMa") != 0)
+        REQUIRE(lookupSpeakerLayout(layout.name) != nullptr);
+  }
+}
+
 TEST_CASE("Parse HOA") {
     using namespace adm;
 
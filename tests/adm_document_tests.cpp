@@ -1,4 +1,5 @@
 #include <catch2/catch.hpp>
+#include "adm/common_definitions.hpp"
 #include "adm/document.hpp"
 #include "adm/elements.hpp"
 #include "adm/utilities/id_assignment.hpp"
@@ -356,6 +357,63 @@ TEST_CASE("copy_document_all_adm_elements") {
           copy->getElements<AudioChannelFormat>()[0]);
 }
 
+TEST_CASE("deep_copy_sharing_block_formats") {
+  using namespace adm;
+  auto document = Document::create();
+  auto holder = addSimpleObjectTo(document, "object");
+  for (int i = 0; i < 3; i++)
+    holder.audioChannelFormat->add(AudioBlockFormatObjects(
+        SphericalPosition(Azimuth(static_cast<float>(i)))));
+  std::shared_ptr<const AudioChannelFormat> channel =
+      holder.audioChannelFormat;
+
+  auto firstBlock = [](std::shared_ptr<const AudioChannelFormat> channel) {
+    return &*channel->getElements<AudioBlockFormatObjects>().begin();
+  };
+
+  SECTION("default copies blocks") {
+    auto copy = document->deepCopy();
+    std::shared_ptr<const AudioChannelFormat> channelCopy =
+        copy->getElements<AudioChannelFormat>()[0];
+    CHECK(firstBlock(channelCopy) != firstBlock(channel));
+  }
+
+  SECTION("blocks shared until modified") {
+    auto copy = document->deepCopy(CopyOptions::share_block_formats);
+    auto channelCopy = copy->getElements<AudioChannelFormat>()[0];
+    REQUIRE(channelCopy != holder.audioChannelFormat);
+    CHECK(firstBlock(channelCopy) == firstBlock(channel));
+
+    // modifying the copy leaves the original alone
+    channelCopy->add(AudioBlockFormatObjects(SphericalPosition()));
+    CHECK(firstBlock(channelCopy) != firstBlock(channel));
+    CHECK(channelCopy->getElements<AudioBlockFormatObjects>().size() == 4);
+    CHECK(channel->getElements<AudioBlockFormatObjects>().size() == 3);
+    CHECK(channelCopy->getElements<AudioBlockFormatObjects>()[1]
+              .get<AudioBlockFormatId>() ==
+          channel->getElements<AudioBlockFormatObjects>()[1]
+              .get<AudioBlockFormatId>());
+  }
+
+  SECTION("modifying the original leaves the copy alone") {
+    auto copy = deepCopy(document, CopyOptions::share_block_formats);
+    std::shared_ptr<const AudioChannelFormat> channelCopy =
+        copy->getElements<AudioChannelFormat>()[0];
+
+    for (auto& block :
+         holder.audioChannelFormat->getElements<AudioBlockFormatObjects>())
+      block.set(Gain::fromLinear(0.5));
+    CHECK(channelCopy->getElements<AudioBlockFormatObjects>()[0]
+              .isDefault<Gain>());
+    CHECK(!channel->getElements<AudioBlockFormatObjects>()[0]
+               .isDefault<Gain>());
+
+    holder.audioChannelFormat->clearAudioBlockFormats();
+    CHECK(channel->getElements<AudioBlockFormatObjects>().empty());
+    CHECK(channelCopy->getElements<AudioBlockFormatObjects>().size() == 3);
+  }
+}
+
 template <typename T>
 std::vector<T> asVector(std::initializer_list<T> l) {
   return std::vector<T>{l};
@@ -632,6 +690,318 @@ TEST_CASE("remove_elements") {
   }
 }
 
+TEST_CASE("lookup_follows_changes") {
+  using namespace adm;
+  auto document = Document::create();
+  auto object = AudioObject::create(AudioObjectName("MyObject"));
+  auto object2 = AudioObject::create(AudioObjectName("MyObject2"));
+  document->add(object);
+  document->add(object2);
+
+  auto id = object->get<AudioObjectId>();
+  REQUIRE(document->lookup(id) == object);
+  REQUIRE(document->lookup(object2->get<AudioObjectId>()) == object2);
+
+  SECTION("id changed") {
+    AudioObjectId newId(AudioObjectIdValue(0x2000));
+    object->set(newId);
+    REQUIRE(document->lookup(newId) == object);
+    REQUIRE(document->lookup(id) == nullptr);
+    REQUIRE_THROWS_AS(object2->set(newId), std::runtime_error);
+  }
+
+  SECTION("removed") {
+    REQUIRE(document->remove(object));
+    REQUIRE(document->lookup(id) == nullptr);
+    REQUIRE(document->lookup(object2->get<AudioObjectId>()) == object2);
+
+    object->set(AudioObjectId(AudioObjectIdValue(0x2000)));
+    REQUIRE(document->lookup(object->get<AudioObjectId>()) == nullptr);
+  }
+
+  SECTION("duplicate undefined ids") {
+    AudioObjectId undefinedId;
+    object2->set(undefinedId);
+    object->set(undefinedId);
+    REQUIRE(document->lookup(undefinedId) == object);
+    REQUIRE(document->remove(object));
+    REQUIRE(document->lookup(undefinedId) == object2);
+  }
+
+  SECTION("copied") {
+    auto copy = document->deepCopy();
+    auto objectCopy = copy->lookup(id);
+    REQUIRE(objectCopy != nullptr);
+    REQUIRE(objectCopy != object);
+    REQUIRE(objectCopy->get<AudioObjectName>() == "MyObject");
+  }
+}
+
+TEST_CASE("id_assignment_follows_changes") {
+  using namespace adm;
+  auto document = Document::create();
+  std::vector<std::shared_ptr<AudioObject>> objects;
+  for (int i = 0; i < 5; i++) {
+    objects.push_back(AudioObject::create(AudioObjectName("object")));
+    document->add(objects.back());
+    REQUIRE(objects.back()->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x1001u + i)));
+  }
+
+  SECTION("removed ids are reused") {
+    document->remove(objects[1]);
+    document->remove(objects[3]);
+    auto object = AudioObject::create(AudioObjectName("new"));
+    document->add(object);
+    REQUIRE(object->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x1002u)));
+    auto object2 = AudioObject::create(AudioObjectName("new"));
+    document->add(object2);
+    REQUIRE(object2->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x1004u)));
+  }
+
+  SECTION("changed ids") {
+    objects[2]->set(AudioObjectId(AudioObjectIdValue(0x1006u)));
+    auto object = AudioObject::create(AudioObjectName("new"));
+    document->add(object);
+    REQUIRE(object->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x1003u)));
+    auto object2 = AudioObject::create(AudioObjectName("new"));
+    document->add(object2);
+    REQUIRE(object2->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x1007u)));
+  }
+
+  SECTION("preferred ids") {
+    auto object = AudioObject::create(
+        AudioObjectName("new"), AudioObjectId(AudioObjectIdValue(0x1003u)));
+    document->add(object);
+    REQUIRE(object->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x1006u)));
+    auto object2 = AudioObject::create(
+        AudioObjectName("new"), AudioObjectId(AudioObjectIdValue(0x2000u)));
+    document->add(object2);
+    REQUIRE(object2->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x2000u)));
+  }
+
+  SECTION("undefined ids") {
+    objects[3]->set(AudioObjectId());
+    objects[4]->set(AudioObjectId());
+    auto object = AudioObject::create(AudioObjectName("new"));
+    document->add(object);
+    REQUIRE(object->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x1004u)));
+    document->remove(objects[3]);
+    auto object2 = AudioObject::create(AudioObjectName("new"));
+    document->add(object2);
+    REQUIRE(object2->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x1005u)));
+  }
+
+  SECTION("copied") {
+    auto copy = document->deepCopy();
+    auto object = AudioObject::create(AudioObjectName("new"));
+    copy->add(object);
+    REQUIRE(object->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x1006u)));
+  }
+}
+
+TEST_CASE("id_assignment_groups") {
+  using namespace adm;
+  auto document = Document::create();
+  auto objectsPack = AudioPackFormat::create(AudioPackFormatName("objects"),
+                                             TypeDefinition::OBJECTS);
+  auto speakersPack = AudioPackFormat::create(
+      AudioPackFormatName("speakers"), TypeDefinition::DIRECT_SPEAKERS);
+  document->add(objectsPack);
+  document->add(speakersPack);
+  REQUIRE(objectsPack->get<AudioPackFormatId>() ==
+          AudioPackFormatId(TypeDefinition::OBJECTS,
+                            AudioPackFormatIdValue(0x1001u)));
+  REQUIRE(speakersPack->get<AudioPackFormatId>() ==
+          AudioPackFormatId(TypeDefinition::DIRECT_SPEAKERS,
+                            AudioPackFormatIdValue(0x1001u)));
+
+  // track format counters are allocated per type and value
+  auto holderA = addSimpleObjectTo(document, "a");
+  auto holderB = addSimpleObjectTo(document, "b");
+  auto streamValue = holderA.audioStreamFormat->get<AudioStreamFormatId>()
+                         .get<AudioStreamFormatIdValue>()
+                         .get();
+  auto trackFormat = AudioTrackFormat::create(
+      AudioTrackFormatName("extra"), FormatDefinition::PCM,
+      AudioTrackFormatId(TypeDefinition::OBJECTS,
+                         AudioTrackFormatIdValue(streamValue),
+                         AudioTrackFormatIdCounter(1)));
+  document->add(trackFormat);
+
+  REQUIRE(holderA.audioTrackFormat->get<AudioTrackFormatId>() ==
+          AudioTrackFormatId(TypeDefinition::OBJECTS,
+                             AudioTrackFormatIdValue(streamValue),
+                             AudioTrackFormatIdCounter(1)));
+  REQUIRE(trackFormat->get<AudioTrackFormatId>() ==
+          AudioTrackFormatId(TypeDefinition::OBJECTS,
+                             AudioTrackFormatIdValue(streamValue),
+                             AudioTrackFormatIdCounter(2)));
+  REQUIRE(holderB.audioTrackFormat->get<AudioTrackFormatId>()
+              .get<AudioTrackFormatIdCounter>() == 1u);
+}
+
+TEST_CASE("add_batch") {
+  using namespace adm;
+  auto makeElements = []() {
+    std::vector<ElementVariant> elements;
+    auto programme = AudioProgramme::create(AudioProgrammeName("programme"));
+    auto content = AudioContent::create(AudioContentName("content"));
+    programme->addReference(content);
+    elements.push_back(programme);
+    for (int i = 0; i < 10; i++) {
+      auto holder = createSimpleObject(std::to_string(i));
+      content->addReference(holder.audioObject);
+      elements.push_back(holder.audioObject);
+      elements.push_back(holder.audioTrackFormat);
+    }
+    return elements;
+  };
+
+  SECTION("same result as adding one by one") {
+    auto elements = makeElements();
+    auto document = Document::create();
+    for (auto& element : elements) {
+      if (auto programme = getElementOr<AudioProgramme>(element))
+        document->add(programme);
+      else if (auto object = getElementOr<AudioObject>(element))
+        document->add(object);
+      else
+        document->add(getElementOr<AudioTrackFormat>(element));
+    }
+
+    auto batchDocument = Document::create();
+    REQUIRE(batchDocument->add(makeElements()) == 62);
+
+    std::stringstream xml, batchXml;
+    writeXml(xml, document);
+    writeXml(batchXml, batchDocument);
+    REQUIRE(xml.str() == batchXml.str());
+    REQUIRE(batchDocument->getElements<AudioTrackFormat>().size() == 10);
+  }
+
+  SECTION("existing elements") {
+    auto document = Document::create();
+    auto elements = makeElements();
+    auto object = boost::get<std::shared_ptr<AudioObject>>(elements[1]);
+    REQUIRE(document->add(object));
+    REQUIRE(document->add(elements) == 56);
+    REQUIRE(document->add(elements) == 0);
+    REQUIRE(document->getElements<AudioObject>().size() == 10);
+    REQUIRE(document->getElements<AudioObject>()[0] == object);
+  }
+
+  SECTION("elements from another document") {
+    auto elements = makeElements();
+    auto other = Document::create();
+    other->add(getElementOr<AudioObject>(elements[elements.size() - 2]));
+
+    auto document = Document::create();
+    REQUIRE_THROWS_AS(document->add(elements), std::runtime_error);
+    REQUIRE(document->getElements<AudioProgramme>().size() == 0);
+    REQUIRE(document->getElements<AudioObject>().size() == 0);
+  }
+}
+
+TEST_CASE("reassign_ids") {
+  using namespace adm;
+  auto document = Document::create();
+  auto holder = addSimpleObjectTo(document, "a");
+  holder.audioChannelFormat->add(AudioBlockFormatObjects{SphericalPosition{}});
+  auto holder2 = addSimpleObjectTo(document, "b");
+  // swap IDs, so the new IDs are in use when they are set
+  holder.audioObject->set(AudioObjectId(AudioObjectIdValue(0x2000u)));
+  holder2.audioObject->set(AudioObjectId(AudioObjectIdValue(0x1001u)));
+  holder.audioObject->set(AudioObjectId(AudioObjectIdValue(0x1002u)));
+
+  reassignIds(document);
+  REQUIRE(holder.audioObject->get<AudioObjectId>() ==
+          AudioObjectId(AudioObjectIdValue(0x1001u)));
+  REQUIRE(holder2.audioObject->get<AudioObjectId>() ==
+          AudioObjectId(AudioObjectIdValue(0x1002u)));
+  REQUIRE(document->lookup(holder.audioObject->get<AudioObjectId>()) ==
+          holder.audioObject);
+  REQUIRE(document->lookup(holder2.audioChannelFormat
+                               ->get<AudioChannelFormatId>()) ==
+          holder2.audioChannelFormat);
+  REQUIRE(holder.audioChannelFormat->getElements<AudioBlockFormatObjects>()[0]
+              .get<AudioBlockFormatId>() ==
+          AudioBlockFormatId(TypeDefinition::OBJECTS,
+                             AudioBlockFormatIdValue(0x1001u),
+                             AudioBlockFormatIdCounter(1)));
+
+  // IDs are still assigned correctly after reassignment
+  auto object = AudioObject::create(AudioObjectName("c"));
+  document->add(object);
+  REQUIRE(object->get<AudioObjectId>() ==
+          AudioObjectId(AudioObjectIdValue(0x1003u)));
+}
+
+TEST_CASE("reassign_ids_of_several_documents") {
+  using namespace adm;
+  std::vector<std::shared_ptr<Document>> documents;
+  for (int i = 0; i < 4; i++) {
+    auto document = Document::create();
+    addCommonDefinitionsTo(document);
+    addSimpleCommonDefinitionsObjectTo(document, "stereo", "0+2+0");
+    for (int j = 0; j <= i; j++) addSimpleObjectTo(document, "object");
+    documents.push_back(document);
+  }
+  auto firstCopy = documents[0]->deepCopy();
+
+  reassignIds(documents);
+
+  // the first document is the same as if it were reassigned on its own
+  reassignIds(firstCopy);
+  std::stringstream xml, firstXml;
+  writeXml(xml, documents[0]);
+  writeXml(firstXml, firstCopy);
+  REQUIRE(xml.str() == firstXml.str());
+
+  // all elements can be added to one document without changing their IDs
+  auto merged = Document::create();
+  addCommonDefinitionsTo(merged);
+  std::size_t objects = 0;
+  for (auto& document : documents) {
+    for (auto object : document->getElements<AudioObject>()) {
+      auto copy = object->copy();
+      merged->add(copy);
+      REQUIRE(copy->get<AudioObjectId>() == object->get<AudioObjectId>());
+      objects++;
+    }
+    for (auto channelFormat : document->getElements<AudioChannelFormat>()) {
+      auto id = channelFormat->get<AudioChannelFormatId>();
+      if (isCommonDefinitionsId(id)) continue;
+      REQUIRE(merged->lookup(id) == nullptr);
+      merged->add(channelFormat->copy());
+    }
+  }
+  REQUIRE(objects == 14);
+  REQUIRE(merged->getElements<AudioObject>().back()->get<AudioObjectId>() ==
+          AudioObjectId(AudioObjectIdValue(0x100eu)));
+
+  SECTION("ranges are checked before changing anything") {
+    auto large = Document::create();
+    for (int i = 0; i < 0xF000; i++)
+      large->add(AudioContent::create(AudioContentName("content")));
+    documents[1]->getElements<AudioObject>()[0]->set(
+        AudioObjectId(AudioObjectIdValue(0x2000u)));
+    REQUIRE_THROWS_AS(reassignIds({documents[1], large}), std::runtime_error);
+    REQUIRE(documents[1]->getElements<AudioObject>()[0]
+                ->get<AudioObjectId>() ==
+            AudioObjectId(AudioObjectIdValue(0x2000u)));
+  }
+}
+
 // Tests deepcopy using a modified version of the kitchen sink test material from https://qc.ebu.io/testmaterial
 TEST_CASE("Copy the kitchen sink") {
   auto document = parseXml("sink.xml");
@@ -1,6 +1,10 @@
 #define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
 #include <catch2/catch.hpp>
+#include <iomanip>
+#include <regex>
+#include <sstream>
 #include "adm/elements/time.hpp"
+#include "adm/utilities/tick_time.hpp"
 #include "adm/utilities/time_conversion.hpp"
 #include "helper/ostream_operators.hpp"
 
@@ -104,6 +108,122 @@ TEST_CASE("Exceptions") {
                       Catch::Contains("denominator must be positive"));
 }
 
+namespace {
+  /// the regular expressions previously used by parseTimecode; returns
+  /// whether timecode is accepted
+  bool matchesTimecodeRegex(const std::string& timecode) {
+    const static std::regex commonFormat(
+        "(\\d{2}):(\\d{2}):(\\d{2}).(\\d+)");
+    const static std::regex fractionalFormat(
+        "(\\d{2}):(\\d{2}):(\\d{2}).(\\d+)S(\\d+)");
+    return std::regex_match(timecode, commonFormat) ||
+           std::regex_match(timecode, fractionalFormat);
+  }
+
+  bool parses(const std::string& timecode) {
+    try {
+      parseTimecode(timecode);
+      return true;
+    } catch (std::runtime_error&) {
+      return false;
+    }
+  }
+
+  std::string formatWithStream(std::chrono::nanoseconds time) {
+    using namespace std::chrono;
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(2)
+       << duration_cast<hours>(time).count() << ":" << std::setw(2)
+       << duration_cast<minutes>(time).count() % 60 << ":" << std::setw(2)
+       << duration_cast<seconds>(time).count() % 60 << ".";
+    auto ns = time.count() % 1000000000;
+    int precision = 9;
+    while (ns % 10 == 0 && precision > 5) {
+      ns /= 10;
+      precision--;
+    }
+    ss << std::setw(precision) << ns;
+    return ss.str();
+  }
+}  // namespace
+
+TEST_CASE("timecode parsing accepts the same inputs as the regex") {
+  std::vector<std::string> valid{"00:00:00.0",         "01:02:03.00000",
+                                 "99:59:59.123456789", "00:00:00.1234567891",
+                                 "00:00:00.1S2",       "12:34:56.00000S48000",
+                                 "00:00:00.0S1"};
+  // mutate the valid timecodes by replacing, inserting and removing
+  // characters; the separator can be anything other than a line terminator
+  std::string alphabet{"0S9:.a\n\r \0-+", 12};
+  std::vector<std::string> timecodes{"", "0", "00:00:00.", "00:00:00.S1"};
+  for (auto& timecode : valid) {
+    timecodes.push_back(timecode);
+    for (std::size_t i = 0; i <= timecode.size(); i++) {
+      if (i < timecode.size()) timecodes.push_back(timecode.substr(0, i));
+      if (i < timecode.size())
+        timecodes.push_back(timecode.substr(0, i) + timecode.substr(i + 1));
+      for (char c : alphabet) {
+        std::string inserted = timecode;
+        inserted.insert(i, 1, c);
+        timecodes.push_back(inserted);
+        if (i < timecode.size()) {
+          std::string replaced = timecode;
+          replaced[i] = c;
+          timecodes.push_back(replaced);
+        }
+      }
+    }
+  }
+
+  for (auto& timecode : timecodes) {
+    CAPTURE(timecode);
+    bool zeroDenominator = std::regex_match(
+        timecode, std::regex("(\\d{2}):(\\d{2}):(\\d{2}).(\\d+)S0+"));
+    REQUIRE(parses(timecode) ==
+            (matchesTimecodeRegex(timecode) && !zeroDenominator));
+  }
+
+  // same range restriction as std::stoi
+  REQUIRE(parseTimecode("00:00:00.2147483647S2147483647") ==
+          FractionalTime{2147483647, 2147483647});
+  REQUIRE_THROWS_AS(parseTimecode("00:00:00.2147483648S1"), std::out_of_range);
+  REQUIRE_THROWS_AS(parseTimecode("00:00:00.1S2147483648"), std::out_of_range);
+  REQUIRE(parseTimecode("00:00:00.1S0000000000000000000001") ==
+          FractionalTime{1, 1});
+  REQUIRE(parseTimecode("00:00:01x5") == std::chrono::milliseconds(1500));
+}
+
+TEST_CASE("timecode formatting") {
+  using std::chrono::nanoseconds;
+  for (int64_t ns : {int64_t{0}, int64_t{1}, int64_t{10}, int64_t{123456789},
+                     int64_t{1000000000}, int64_t{3723000010000},
+                     int64_t{360000000000000}, int64_t{-5},
+                     int64_t{-3723000010000},
+                     std::numeric_limits<int64_t>::max(),
+                     std::numeric_limits<int64_t>::min()}) {
+    CAPTURE(ns);
+    REQUIRE(formatTimecode(nanoseconds(ns)) ==
+            formatWithStream(nanoseconds(ns)));
+  }
+
+  REQUIRE(formatTimecode(FractionalTime{3, 2}) == "00:00:01.1S2");
+  REQUIRE(formatTimecode(FractionalTime{-3, 2}) == "00:00:-1.-1S2");
+  REQUIRE(formatTimecode(FractionalTime{3723 * 48000 + 1, 48000}) ==
+          "01:02:03.1S48000");
+
+  char buffer[maxTimecodeLength];
+  for (Time time :
+       {Time{FractionalTime{std::numeric_limits<int64_t>::min(), 1}},
+        Time{FractionalTime{std::numeric_limits<int64_t>::min(), 10000000000}},
+        Time{FractionalTime{std::numeric_limits<int64_t>::max() - 1,
+                            std::numeric_limits<int64_t>::max()}},
+        Time{nanoseconds{std::numeric_limits<int64_t>::min()}}}) {
+    auto length = formatTimecode(time, buffer);
+    REQUIRE(length <= maxTimecodeLength);
+    REQUIRE(std::string(buffer, length) == formatTimecode(time));
+  }
+}
+
 TEST_CASE("rational conversion") {
   REQUIRE(asRational(FractionalTime{4, 8}) == RationalTime{1, 2});
 
@@ -114,3 +234,56 @@ TEST_CASE("rational conversion") {
 
   REQUIRE(asTime(RationalTime{1, 2}) == FractionalTime{1, 2});
 }
+
+TEST_CASE("tick time") {
+  Timebase timebase;
+  REQUIRE(timebase.extendTo(FractionalTime{1, 48000}));
+  REQUIRE(timebase.extendTo(FractionalTime{1, 30}));
+  REQUIRE(timebase.extendTo(std::chrono::milliseconds{250}));
+  REQUIRE(timebase.ticksPerSecond() == 48000);
+
+  auto a = timebase.toTicks(FractionalTime{3, 30});
+  auto b = timebase.toTicks(std::chrono::milliseconds{250});
+  REQUIRE(a.is_initialized());
+  REQUIRE(b.is_initialized());
+  CHECK(a->ticks == 4800);
+  CHECK(b->ticks == 12000);
+  CHECK(*a < *b);
+  CHECK(*b - *a == TickTime{7200});
+  CHECK(*a + *b == TickTime{16800});
+
+  // not normalised, but still representable
+  auto c = timebase.toTicks(FractionalTime{2, 96000});
+  REQUIRE(c.is_initialized());
+  CHECK(c->ticks == 1);
+
+  // not representable
+  CHECK(!timebase.toTicks(std::chrono::nanoseconds{1}).is_initialized());
+  CHECK(!timebase.toTicks(FractionalTime{1, 7}).is_initialized());
+
+  // converting back is lossless in either form
+  CHECK(timebase.toNanoseconds(*b) == std::chrono::milliseconds{250});
+  CHECK(timebase.toFractional(*a, 30) == FractionalTime{3, 30});
+  CHECK(timebase.toFractional(*a) == FractionalTime{1, 10});
+  CHECK(timebase.toNanoseconds(*a) ==
+        Time{FractionalTime{1, 10}}.asNanoseconds());
+  CHECK(timebase.toNanoseconds(TickTime{1}) ==
+        Time{FractionalTime{1, 48000}}.asNanoseconds());
+  CHECK_THROWS_AS(timebase.toFractional(*a, 7), std::invalid_argument);
+
+  // extending keeps existing times representable
+  REQUIRE(timebase.extendTo(std::chrono::nanoseconds{1}));
+  CHECK(timebase.ticksPerSecond() % 1000000000 == 0);
+  CHECK(timebase.ticksPerSecond() % 48000 == 0);
+  CHECK(timebase.toNanoseconds(*timebase.toTicks(
+            std::chrono::nanoseconds{123456789})) ==
+        std::chrono::nanoseconds{123456789});
+
+  // overflow leaves the timebase unchanged
+  REQUIRE(timebase.extendTo(FractionalTime{1, 1000000007}));
+  int64_t ticksPerSecond = timebase.ticksPerSecond();
+  CHECK(!timebase.extendTo(FractionalTime{1, 998244353}));
+  CHECK(timebase.ticksPerSecond() == ticksPerSecond);
+
+  CHECK_THROWS_AS(Timebase{0}, std::invalid_argument);
+}
@@ -1,7 +1,10 @@
 #define CATCH_CONFIG_ENABLE_CHRONO_STRINGMAKER
 #include <algorithm>
+#include <memory>
+#include <vector>
 #include <catch2/catch.hpp>
 #include "adm/elements/audio_channel_format.hpp"
+#include "adm/errors.hpp"
 #include "adm/utilities/comparator.hpp"
 
 TEST_CASE("audio_channel_format") {
@@ -93,3 +96,130 @@ TEST_CASE("audio_channel_format") {
   }
   */
 }
+
+TEST_CASE("audio_channel_format_blocks_in_window") {
+  using namespace adm;
+  using namespace std::chrono_literals;
+  auto channelFormat = AudioChannelFormat::create(
+      AudioChannelFormatName("MyChannelFormat"), TypeDefinition::OBJECTS);
+  // blocks at [0, 1), [1, 2), ... [9, 10), then a block of duration 0 at 10
+  for (int i = 0; i < 10; i++)
+    channelFormat->add(AudioBlockFormatObjects(
+        SphericalPosition(Azimuth(static_cast<float>(i))),
+        Rtime(std::chrono::seconds(i)), Duration(1s)));
+  channelFormat->add(AudioBlockFormatObjects(SphericalPosition(Azimuth(10.f)),
+                                             Rtime(10s), Duration(0s)));
+
+  auto azimuths = [&](Time start, Time end) {
+    std::vector<float> result;
+    for (auto& block :
+         channelFormat->getElementsInWindow<AudioBlockFormatObjects>(start,
+                                                                     end))
+      result.push_back(block.get<SphericalPosition>().get<Azimuth>().get());
+    return result;
+  };
+
+  REQUIRE(azimuths(0s, 1s) == std::vector<float>{0.f});
+  REQUIRE(azimuths(2500ms, 3500ms) == std::vector<float>{2.f, 3.f});
+  REQUIRE(azimuths(3s, 5s) == std::vector<float>{3.f, 4.f});
+  REQUIRE(azimuths(9500ms, 20s) == std::vector<float>{9.f, 10.f});
+  REQUIRE(azimuths(10s, 11s) == std::vector<float>{10.f});
+  REQUIRE(azimuths(11s, 12s).empty());
+  REQUIRE(azimuths(5s, 5s).empty());
+  REQUIRE(azimuths(FractionalTime{3, 2}, FractionalTime{5, 2}) ==
+          std::vector<float>{1.f, 2.f});
+
+  // a single block with no rtime or duration covers all time
+  auto single = AudioChannelFormat::create(
+      AudioChannelFormatName("MyChannelFormat"), TypeDefinition::OBJECTS);
+  single->add(AudioBlockFormatObjects(SphericalPosition()));
+  REQUIRE(single->getElementsInWindow<AudioBlockFormatObjects>(100s, 101s)
+              .size() == 1);
+  auto hoaBlocks =
+      channelFormat->getElementsInWindow<AudioBlockFormatHoa>(0s, 100s);
+  REQUIRE(hoaBlocks.empty());
+}
+
+TEST_CASE("audio_channel_format_evaluate_objects") {
+  using namespace adm;
+  using namespace std::chrono_literals;
+  auto channelFormat = AudioChannelFormat::create(
+      AudioChannelFormatName("MyChannelFormat"), TypeDefinition::OBJECTS);
+  // interpolated over the whole block
+  channelFormat->add(AudioBlockFormatObjects(SphericalPosition(Azimuth(0.f)),
+                                             Rtime(0s), Duration(1s)));
+  channelFormat->add(AudioBlockFormatObjects(
+      SphericalPosition(Azimuth(30.f)), Rtime(1s), Duration(1s),
+      Gain::fromLinear(0.5), Width(10.f)));
+  // interpolated over the first half, then a gap from 3s to 4s
+  channelFormat->add(AudioBlockFormatObjects(
+      SphericalPosition(Azimuth(60.f)), Rtime(2s), Duration(1s),
+      JumpPosition(JumpPositionFlag(true), InterpolationLength(500ms))));
+  // jumps, as the coordinate system changes
+  channelFormat->add(AudioBlockFormatObjects(CartesianPosition(X(1.f), Y(0.f)),
+                                             Rtime(4s), Duration(1s)));
+
+  std::vector<std::chrono::nanoseconds> times{
+      0s, 500ms, 1s, 1500ms, 2s, 2250ms, 2500ms, 3500ms, 4s, 4500ms, 6s};
+  std::size_t n = times.size();
+  std::vector<float> azimuths(n), gains(n), widths(n), distances(n);
+  std::unique_ptr<bool[]> cartesian(new bool[n]);
+  ObjectsParameterBuffers out;
+  out.azimuthOrX = azimuths.data();
+  out.distanceOrZ = distances.data();
+  out.gain = gains.data();
+  out.width = widths.data();
+  out.cartesian = cartesian.get();
+
+  auto check = [&]() {
+    std::vector<float> expectedAzimuths{0.f,  0.f,  0.f,  15.f, 30.f, 45.f,
+                                        60.f, 60.f, 1.f,  1.f,  1.f};
+    std::vector<float> expectedGains{1.f, 1.f,   1.f, 0.75f, 0.5f, 0.75f,
+                                     1.f, 1.f,   1.f, 1.f,   1.f};
+    std::vector<float> expectedWidths{0.f, 0.f, 0.f, 5.f, 10.f, 5.f,
+                                      0.f, 0.f, 0.f, 0.f, 0.f};
+    for (std::size_t i = 0; i < n; i++) {
+      CHECK(azimuths[i] == Approx(expectedAzimuths[i]));
+      CHECK(gains[i] == Approx(expectedGains[i]));
+      CHECK(widths[i] == Approx(expectedWidths[i]));
+      CHECK(cartesian[i] == (i >= 8));
+    }
+    CHECK(distances[0] == 1.f);
+    CHECK(distances[8] == 0.f);
+  };
+
+  SECTION("all at once") {
+    channelFormat->evaluateObjects(times.data(), n, out);
+    check();
+  }
+
+  SECTION("with a cursor") {
+    BlockCursor cursor;
+    for (std::size_t i = 0; i < n; i += 3) {
+      ObjectsParameterBuffers part = out;
+      part.azimuthOrX += i;
+      part.distanceOrZ += i;
+      part.gain += i;
+      part.width += i;
+      part.cartesian += i;
+      channelFormat->evaluateObjects(
+          times.data() + i, std::min<std::size_t>(3, n - i), part, cursor);
+    }
+    CHECK(cursor.index() == 3);
+    check();
+
+    // going backwards is still correct
+    float azimuth;
+    ObjectsParameterBuffers single;
+    single.azimuthOrX = &azimuth;
+    std::chrono::nanoseconds time = 1500ms;
+    channelFormat->evaluateObjects(&time, 1, single, cursor);
+    CHECK(azimuth == Approx(15.f));
+    CHECK(cursor.index() == 1);
+  }
+
+  auto empty = AudioChannelFormat::create(
+      AudioChannelFormatName("MyChannelFormat"), TypeDefinition::OBJECTS);
+  REQUIRE_THROWS_AS(empty->evaluateObjects(times.data(), n, out),
+                    error::AdmGenericRuntimeError);
+}
@@ -1,9 +1,16 @@
 #include <catch2/catch.hpp>
 #include "adm/common_definitions.hpp"
+#include "adm/memory_arena.hpp"
 #include "adm/utilities/copy.hpp"
+#include "adm/utilities/id_assignment.hpp"
 #include "adm/utilities/object_creation.hpp"
 #include "adm/parse.hpp"
+#include "adm/serial/document_diff.hpp"
+#include "adm/serial/frame_writer.hpp"
+#include "adm/utilities/block_duration_assignment.hpp"
+#include "adm/utilities/block_format_columns.hpp"
 #include "adm/write.hpp"
+#include <iomanip>
 #include <sstream>
 
 using namespace adm;
@@ -16,35 +23,66 @@ TEST_CASE("common_definitions") {
 }
 
 TEST_CASE("adding lots of objects to document") {
-  auto const n = 200;
-  auto add_to_document = [n]() {
+  auto make_holders = [](int n) {
     std::vector<SimpleObjectHolder> holders;
     holders.reserve(n);
     for (auto i = 0; i != n; ++i) {
       holders.push_back(createSimpleObject(std::to_string(i)));
     }
+    return holders;
+  };
+  auto add_to_document = [&make_holders](int n) {
+    auto holders = make_holders(n);
     auto doc = Document::create();
     for (auto const& holder : holders) {
       doc->add(holder.audioObject);
     }
+    return doc;
+  };
+  auto add_batch_to_document = [&make_holders](int n) {
+    auto holders = make_holders(n);
+    std::vector<ElementVariant> elements;
+    elements.reserve(n);
+    for (auto const& holder : holders) {
+      elements.push_back(holder.audioObject);
+    }
+    auto doc = Document::create();
+    doc->add(elements);
+    return doc;
   };
 
-  BENCHMARK("add to document") { return add_to_document(); };
+  BENCHMARK("add to document") { return add_to_document(200); };
+  BENCHMARK("add batch to document") { return add_batch_to_document(200); };
+  BENCHMARK("add 10k to document") { return add_to_document(10000); };
+  BENCHMARK("add 10k batch to document") {
+    return add_batch_to_document(10000);
+  };
 }
 
 TEST_CASE("copying document with lots of objects and common defs") {
-  auto const n = 200;
-  std::vector<SimpleObjectHolder> holders;
-  holders.reserve(n);
-  for (auto i = 0; i != n; ++i) {
-    holders.push_back(createSimpleObject(std::to_string(i)));
-  }
-  auto doc = getCommonDefinitions();
-  for (auto const& holder : holders) {
-    doc->add(holder.audioObject);
-  }
+  // each simple object is 6 elements, so these are around 1.2k and 50k
+  // elements, plus the common definitions
+  for (auto const n : {200, 8334}) {
+    std::vector<SimpleObjectHolder> holders;
+    holders.reserve(n);
+    for (auto i = 0; i != n; ++i) {
+      holders.push_back(createSimpleObject(std::to_string(i)));
+    }
+    auto doc = getCommonDefinitions();
+    for (auto const& holder : holders) {
+      doc->add(holder.audioObject);
+    }
+
+    BENCHMARK("deepCopy() " + std::to_string(n) + " objects") {
+      return doc->deepCopy();
+    };
 
-  BENCHMARK("deepCopy()") { return doc->deepCopy(); };
+    auto arenaDoc = Document::create(MemoryArena::create());
+    deepCopyTo(doc, arenaDoc);
+    BENCHMARK("deepCopy() with arena " + std::to_string(n) + " objects") {
+      return arenaDoc->deepCopy();
+    };
+  }
 }
 
 TEST_CASE("lots of blocks") {
@@ -67,6 +105,9 @@ TEST_CASE("lots of blocks") {
   auto document = generate();
 
   BENCHMARK("copy") { return adm::deepCopy(document); };
+  BENCHMARK("copy sharing block formats") {
+    return adm::deepCopy(document, CopyOptions::share_block_formats);
+  };
 
   BENCHMARK("write") {
     std::ostringstream stream;
@@ -81,6 +122,203 @@ TEST_CASE("lots of blocks") {
     stream.seekg(0);
     return parseXml(stream);
   };
+
+  auto channel = document->getElements<AudioChannelFormat>()[0];
+
+  BENCHMARK("make columns") {
+    return AudioBlockFormatObjectsColumns(
+        channel->getElements<AudioBlockFormatObjects>());
+  };
+
+  BENCHMARK("sum azimuths from blocks") {
+    float sum = 0.0f;
+    for (auto& block : channel->getElements<AudioBlockFormatObjects>())
+      sum += block.get<SphericalPosition>().get<Azimuth>().get();
+    return sum;
+  };
+
+  AudioBlockFormatObjectsColumns columns(
+      channel->getElements<AudioBlockFormatObjects>());
+
+  BENCHMARK("sum azimuths from columns") {
+    float sum = 0.0f;
+    for (float azimuth : columns.azimuthsOrX()) sum += azimuth;
+    return sum;
+  };
+}
+
+TEST_CASE("updating block durations") {
+  auto document = Document::create();
+  auto programme = AudioProgramme::create(AudioProgrammeName{"programme"});
+  auto content = AudioContent::create(AudioContentName{"content"});
+  programme->addReference(content);
+  document->add(programme);
+
+  auto holder = addSimpleObjectTo(document, "object");
+  content->addReference(holder.audioObject);
+
+  // 20 minutes of 20ms blocks, in samples at 48kHz
+  const int64_t n = 60 * 50 * 20;
+  for (int64_t i = 0; i < n; i++)
+    holder.audioChannelFormat->add(AudioBlockFormatObjects{
+        SphericalPosition{}, Rtime{FractionalTime{i * 960, 48000}}});
+  Time fileLength = std::chrono::minutes{20};
+
+  // the first run sets the durations, the rest only check them
+  updateBlockFormatDurations(document, fileLength);
+  BENCHMARK("update") {
+    updateBlockFormatDurations(document, fileLength);
+    return document;
+  };
+}
+
+TEST_CASE("evaluating object parameters") {
+  auto channel = AudioChannelFormat::create(AudioChannelFormatName{"c"},
+                                            TypeDefinition::OBJECTS);
+  // 20 minutes of 20ms blocks, moving around the listener
+  const int n = 60 * 50 * 20;
+  for (int i = 0; i < n; i++)
+    channel->add(AudioBlockFormatObjects{
+        SphericalPosition{Azimuth{static_cast<float>(i % 360 - 180)}},
+        Rtime{std::chrono::milliseconds{20 * i}},
+        Duration{std::chrono::milliseconds{20}}, Width{10.0f}});
+
+  // one minute at 48kHz, in buffers of 512 samples
+  const int64_t sampleRate = 48000;
+  const std::size_t bufferSize = 512;
+  std::vector<std::chrono::nanoseconds> times(bufferSize);
+  std::vector<float> azimuths(bufferSize), elevations(bufferSize),
+      distances(bufferSize), gains(bufferSize), widths(bufferSize);
+  ObjectsParameterBuffers out;
+  out.azimuthOrX = azimuths.data();
+  out.elevationOrY = elevations.data();
+  out.distanceOrZ = distances.data();
+  out.gain = gains.data();
+  out.width = widths.data();
+
+  BENCHMARK("one minute at 48kHz") {
+    BlockCursor cursor;
+    float sum = 0.0f;
+    for (int64_t sample = 0; sample < 60 * sampleRate;
+         sample += bufferSize) {
+      for (std::size_t i = 0; i < bufferSize; i++)
+        times[i] = std::chrono::nanoseconds{(sample + i) * 1000000000 /
+                                            sampleRate};
+      channel->evaluateObjects(times.data(), bufferSize, out, cursor);
+      sum += azimuths[0];
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("writing many objects") {
+  auto document = Document::create();
+  for (int i = 0; i < 128; i++) {
+    auto holder = addSimpleObjectTo(document, "object " + std::to_string(i));
+    for (int j = 0; j < 500; j++)
+      holder.audioChannelFormat->add(AudioBlockFormatObjects{
+          SphericalPosition{}, Rtime{std::chrono::milliseconds(j * 20)},
+          Duration{std::chrono::milliseconds(20)}});
+  }
+
+  BENCHMARK("write") {
+    std::ostringstream stream;
+    writeXml(stream, document);
+    return stream;
+  };
+  BENCHMARK("write parallel") {
+    std::ostringstream stream;
+    writeXml(stream, document, xml::WriterOptions::parallel);
+    return stream;
+  };
+}
+
+TEST_CASE("writing S-ADM frames") {
+  // 10 minutes of 20ms blocks for 16 objects
+  auto document = Document::create();
+  for (int i = 0; i < 16; i++) {
+    auto holder = addSimpleObjectTo(document, "object " + std::to_string(i));
+    for (int j = 0; j < 30000; j++)
+      holder.audioChannelFormat->add(AudioBlockFormatObjects{
+          SphericalPosition{}, Rtime{std::chrono::milliseconds(j * 20)},
+          Duration{std::chrono::milliseconds(20)}});
+  }
+
+  FrameHeader header{FrameFormat{FrameFormatId{FrameIndex{1}},
+                                 Start{std::chrono::seconds(300)},
+                                 Duration{std::chrono::milliseconds(40)},
+                                 FrameType::FULL}};
+  SadmFrameWriter writer;
+  std::ostringstream stream;
+  BENCHMARK("write frame") {
+    stream.str("");
+    writer.write(document, header, stream);
+    return stream.tellp();
+  };
+}
+
+TEST_CASE("diffing S-ADM frames") {
+  // consecutive 40ms frames of 20ms blocks for 64 objects
+  auto makeFrame = [](int frame) {
+    auto document = Document::create();
+    for (int i = 0; i < 64; i++) {
+      auto holder = addSimpleObjectTo(document, "object " + std::to_string(i));
+      for (int j = 2 * frame; j < 2 * frame + 2; j++) {
+        AudioBlockFormatObjects block{SphericalPosition{},
+                                      Rtime{std::chrono::milliseconds(j * 20)},
+                                      Duration{std::chrono::milliseconds(20)}};
+        block.set(AudioBlockFormatId{
+            TypeDefinition::OBJECTS,
+            AudioBlockFormatIdValue{
+                holder.audioChannelFormat->get<AudioChannelFormatId>()
+                    .get<AudioChannelFormatIdValue>()
+                    .get()},
+            AudioBlockFormatIdCounter{static_cast<unsigned>(j + 1)}});
+        holder.audioChannelFormat->add(block);
+      }
+    }
+    return document;
+  };
+  auto previous = makeFrame(0);
+  auto current = makeFrame(1);
+
+  BENCHMARK("diff") { return diffDocuments(previous, current); };
+}
+
+TEST_CASE("lookup in large documents") {
+  for (size_t n : {100, 1000, 10000}) {
+    auto doc = Document::create();
+    std::vector<AudioTrackUidId> ids;
+    for (size_t i = 0; i < n; i++) {
+      auto trackUid = AudioTrackUid::create();
+      doc->add(trackUid);
+      ids.push_back(trackUid->get<AudioTrackUidId>());
+    }
+
+    BENCHMARK("lookup " + std::to_string(n)) {
+      size_t found = 0;
+      for (size_t i = 0; i < 1000; i++)
+        if (doc->lookup(ids[(i * 7919) % n])) found++;
+      return found;
+    };
+  }
+}
+
+TEST_CASE("reassigning IDs") {
+  auto make_document = [](size_t n) {
+    auto doc = Document::create();
+    for (size_t i = 0; i < n; i++) addSimpleObjectTo(doc, std::to_string(i));
+    return doc;
+  };
+
+  for (size_t n : {1000, 10000}) {
+    auto doc = make_document(n);
+    BENCHMARK("reassignIds " + std::to_string(n)) { reassignIds(doc); };
+  }
+
+  std::vector<std::shared_ptr<Document>> docs;
+  for (size_t i = 0; i < 8; i++) docs.push_back(make_document(1000));
+  BENCHMARK("reassignIds 8 documents") { reassignIds(docs); };
 }
 
 TEST_CASE("IDs") {
@@ -92,3 +330,72 @@ TEST_CASE("IDs") {
 
   BENCHMARK("parse") { return parseAudioBlockFormatId(bfIdStr); };
 }
+
+TEST_CASE("timecodes") {
+  std::string decimal = "01:02:03.12345";
+  std::string fractional = "01:02:03.12345S48000";
+
+  BENCHMARK("parse decimal") { return parseTimecode(decimal); };
+  BENCHMARK("parse fractional") { return parseTimecode(fractional); };
+
+  Time decimalTime = parseTimecode(decimal);
+  Time fractionalTime = parseTimecode(fractional);
+
+  BENCHMARK("format decimal") { return formatTimecode(decimalTime); };
+  BENCHMARK("format fractional") { return formatTimecode(fractionalTime); };
+
+  char buffer[maxTimecodeLength];
+  BENCHMARK("format decimal to buffer") {
+    return formatTimecode(decimalTime, buffer);
+  };
+  BENCHMARK("format fractional to buffer") {
+    return formatTimecode(fractionalTime, buffer);
+  };
+}
+
+TEST_CASE("parsing numeric values") {
+  // about a million position values, with varied digits
+  const size_t n = 1000000 / 3;
+  std::ostringstream xml;
+  xml << "<ebuCoreMain><coreMetadata><format><audioFormatExtended>"
+         "<audioChannelFormat audioChannelFormatID=\"AC_00031001\" "
+         "audioChannelFormatName=\"c\" typeDefinition=\"Objects\">";
+  for (size_t i = 0; i < n; i++) {
+    xml << "<audioBlockFormat audioBlockFormatID=\"AB_00031001_"
+        << std::setw(8) << std::setfill('0') << std::hex << i + 1 << std::dec
+        << "\"><position coordinate=\"azimuth\">" << (i % 36000) / 100.0 - 180
+        << "</position><position coordinate=\"elevation\">"
+        << (i % 9000) / 100.0 - 45
+        << "</position><position coordinate=\"distance\">"
+        << (i % 1000) / 1000.0 << "</position></audioBlockFormat>";
+  }
+  xml << "</audioChannelFormat></audioFormatExtended></format>"
+         "</coreMetadata></ebuCoreMain>";
+  std::string str = xml.str();
+
+  BENCHMARK("parse 1M positions") {
+    return parseXml(str.data(), str.size());
+  };
+}
+
+TEST_CASE("parsing many channels") {
+  auto document = Document::create();
+  for (int c = 0; c < 64; c++) {
+    auto channel = AudioChannelFormat::create(AudioChannelFormatName{"c"},
+                                              TypeDefinition::OBJECTS);
+    for (int i = 0; i < 2000; i++)
+      channel->add(AudioBlockFormatObjects{SphericalPosition{}});
+    document->add(channel);
+  }
+  std::stringstream stream;
+  writeXml(stream, document);
+  std::string xml = stream.str();
+
+  BENCHMARK("parse") { return parseXml(xml.data(), xml.size()); };
+  BENCHMARK("parse parallel") {
+    return parseXml(xml.data(), xml.size(), xml::ParserOptions::parallel);
+  };
+  BENCHMARK("parse with arena") {
+    return parseXml(xml.data(), xml.size(), xml::ParserOptions::arena);
+  };
+}
@@ -105,6 +105,46 @@ TEST_CASE_METHOD(BaseSceneFixture, "fractional_durations_not_normalised") {
   CHECK(blocks1[1].get<Duration>().get() == FractionalTime{490, 100});
 }
 
+TEST_CASE_METHOD(BaseSceneFixture, "mixed_time_forms") {
+  using namespace adm;
+  channel1->add(AudioBlockFormatObjects(SphericalPosition{},
+                                        Rtime{std::chrono::nanoseconds{0}}));
+  channel1->add(AudioBlockFormatObjects(SphericalPosition{},
+                                        Rtime{FractionalTime{2, 6}}));
+  channel1->add(AudioBlockFormatObjects(SphericalPosition{},
+                                        Rtime{FractionalTime{4, 6}}));
+  channel1->add(AudioBlockFormatObjects(SphericalPosition{},
+                                        Rtime{std::chrono::seconds{1}}));
+
+  updateBlockFormatDurations(document, std::chrono::milliseconds{1500});
+
+  // mixed forms give normalised fractions, matching fractions keep their
+  // denominator, and nanoseconds stay as nanoseconds
+  auto blocks1 = channel1->getElements<AudioBlockFormatObjects>();
+  CHECK(blocks1[0].get<Duration>().get() == FractionalTime{1, 3});
+  CHECK(blocks1[1].get<Duration>().get() == FractionalTime{2, 6});
+  CHECK(blocks1[2].get<Duration>().get() == FractionalTime{1, 3});
+  CHECK(blocks1[3].get<Duration>().get() ==
+        Time{std::chrono::milliseconds{500}});
+}
+
+TEST_CASE_METHOD(BaseSceneFixture, "no_common_timebase") {
+  using namespace adm;
+  // the denominators have no common timebase which fits in 64 bits, so
+  // this is handled without converting to ticks
+  channel1->add(AudioBlockFormatObjects(
+      SphericalPosition{}, Rtime{FractionalTime{0, 1000000007}}));
+  channel1->add(AudioBlockFormatObjects(
+      SphericalPosition{}, Rtime{FractionalTime{1, 998244353}}));
+
+  updateBlockFormatDurations(document, std::chrono::seconds{1});
+
+  auto blocks1 = channel1->getElements<AudioBlockFormatObjects>();
+  CHECK(blocks1[0].get<Duration>().get() == FractionalTime{1, 998244353});
+  CHECK(blocks1[1].get<Duration>().get() ==
+        FractionalTime{998244352, 998244353});
+}
+
 TEST_CASE_METHOD(BaseSceneFixture,
                  "programme_duration_ns_file_duration_fractional") {
   using namespace adm;
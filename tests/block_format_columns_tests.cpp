@@ -0,0 +1,111 @@
+#include <catch2/catch.hpp>
+#include "adm/elements.hpp"
+#include "adm/utilities/block_format_columns.hpp"
+
+using namespace adm;
+
+namespace {
+  void checkRoundTrip(const AudioBlockFormatObjectsColumns& columns,
+                      const std::vector<AudioBlockFormatObjects>& blocks) {
+    REQUIRE(columns.size() == blocks.size());
+    auto converted = columns.toBlockFormats();
+    REQUIRE(converted.size() == blocks.size());
+    for (std::size_t i = 0; i < blocks.size(); i++) {
+      CHECK(converted[i].get<AudioBlockFormatId>() ==
+            blocks[i].get<AudioBlockFormatId>());
+      CHECK(converted[i].contentHash() == blocks[i].contentHash());
+    }
+  }
+}  // namespace
+
+TEST_CASE("block_format_columns_simple") {
+  auto channel = AudioChannelFormat::create(AudioChannelFormatName{"c"},
+                                            TypeDefinition::OBJECTS);
+  channel->add(AudioBlockFormatObjects{
+      SphericalPosition{Azimuth{30.0f}, Elevation{10.0f}},
+      Rtime{std::chrono::milliseconds{0}},
+      Duration{std::chrono::milliseconds{100}}, Gain::fromLinear(0.5)});
+  channel->add(AudioBlockFormatObjects{
+      SphericalPosition{Azimuth{-30.0f}, Elevation{0.0f}, Distance{0.5f}},
+      Rtime{std::chrono::milliseconds{100}},
+      Duration{std::chrono::milliseconds{100}}});
+  channel->add(AudioBlockFormatObjects{CartesianPosition{X{0.5f}, Y{-1.0f}},
+                                       Rtime{std::chrono::milliseconds{200}}});
+
+  AudioBlockFormatObjectsColumns columns(
+      channel->getElements<AudioBlockFormatObjects>());
+
+  REQUIRE(columns.size() == 3);
+  REQUIRE(!columns.empty());
+
+  CHECK(columns.rtimes() == std::vector<std::chrono::nanoseconds>{
+                                std::chrono::milliseconds{0},
+                                std::chrono::milliseconds{100},
+                                std::chrono::milliseconds{200}});
+  CHECK(columns.durations() == std::vector<std::chrono::nanoseconds>{
+                                   std::chrono::milliseconds{100},
+                                   std::chrono::milliseconds{100},
+                                   std::chrono::nanoseconds{0}});
+  CHECK(columns.azimuthsOrX() == std::vector<float>{30.0f, -30.0f, 0.5f});
+  CHECK(columns.elevationsOrY() == std::vector<float>{10.0f, 0.0f, -1.0f});
+  CHECK(columns.distancesOrZ() == std::vector<float>{1.0f, 0.5f, 0.0f});
+  CHECK(columns.gains() == std::vector<double>{0.5, 1.0, 1.0});
+
+  CHECK(!columns[0].isCartesian());
+  CHECK(columns[2].isCartesian());
+  REQUIRE(columns[1].duration().is_initialized());
+  CHECK(*columns[1].duration() == std::chrono::milliseconds{100});
+  CHECK(!columns[2].duration().is_initialized());
+
+  std::size_t index = 0;
+  for (auto block : columns) {
+    CHECK(block.index() == index);
+    CHECK(!block.hasOtherParameters());
+    index++;
+  }
+  CHECK(index == 3);
+
+  std::vector<AudioBlockFormatObjects> blocks;
+  for (auto& block : channel->getElements<AudioBlockFormatObjects>())
+    blocks.push_back(block);
+  checkRoundTrip(columns, blocks);
+}
+
+TEST_CASE("block_format_columns_other_parameters") {
+  std::vector<AudioBlockFormatObjects> blocks;
+
+  blocks.push_back(AudioBlockFormatObjects{
+      SphericalPosition{Azimuth{10.0f}, Elevation{0.0f}}, Width{20.0f},
+      Rtime{std::chrono::milliseconds{0}}});
+  blocks.push_back(AudioBlockFormatObjects{
+      SphericalPosition{Azimuth{20.0f}, Elevation{0.0f}},
+      Rtime{std::chrono::milliseconds{10}}});
+  blocks.push_back(AudioBlockFormatObjects{
+      CartesianPosition{X{0.0f}, Y{1.0f}, Z{0.5f}},
+      Rtime{std::chrono::milliseconds{20}}, Gain::fromDb(-6.0),
+      JumpPosition{JumpPositionFlag{true}}});
+  blocks.push_back(AudioBlockFormatObjects{
+      SphericalPosition{Azimuth{40.0f}, Elevation{0.0f}},
+      Rtime{FractionalTime{1, 3}}, Duration{FractionalTime{1, 3}}});
+  blocks.push_back(AudioBlockFormatObjects{
+      SphericalPosition{Azimuth{50.0f}, Elevation{0.0f}}, Cartesian{false},
+      ChannelLock{ChannelLockFlag{true}}});
+
+  AudioBlockFormatObjectsColumns columns;
+  columns.reserve(blocks.size());
+  for (auto& block : blocks) columns.push_back(block);
+
+  CHECK(columns[0].hasOtherParameters());
+  CHECK(!columns[1].hasOtherParameters());
+  CHECK(columns[2].hasOtherParameters());
+  CHECK(columns[3].hasOtherParameters());
+  CHECK(columns[4].hasOtherParameters());
+
+  // dense columns are still filled for blocks with other parameters
+  CHECK(columns.azimuthsOrX() ==
+        std::vector<float>{10.0f, 20.0f, 0.0f, 40.0f, 50.0f});
+  CHECK(columns[2].gain() == Approx(Gain::fromDb(-6.0).asLinear()));
+  CHECK(columns[2].distanceOrZ() == 0.5f);
+
+  checkRoundTrip(columns, blocks);
+}
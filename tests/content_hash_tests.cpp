@@ -0,0 +1,179 @@
+#include <catch2/catch.hpp>
+#include <unordered_set>
+#include <vector>
+#include "adm/document.hpp"
+#include "adm/elements.hpp"
+#include "adm/utilities/object_creation.hpp"
+
+using namespace adm;
+using namespace std::chrono_literals;
+
+TEST_CASE("content hash of copies") {
+  auto document = Document::create();
+  auto holder = addSimpleObjectTo(document, "a");
+  holder.audioObject->set(Gain::fromDb(-3.0));
+  holder.audioObject->add(Label{"label"});
+
+  auto copy = document->deepCopy();
+  auto copiedObject = copy->getElements<AudioObject>()[0];
+  REQUIRE(copiedObject->contentHash() == holder.audioObject->contentHash());
+  REQUIRE(copy->getElements<AudioPackFormat>()[0]->contentHash() ==
+          holder.audioPackFormat->contentHash());
+  REQUIRE(copy->getElements<AudioTrackUid>()[0]->contentHash() ==
+          holder.audioTrackUid->contentHash());
+
+  // the element's own ID is not included
+  auto other = Document::create();
+  addSimpleObjectTo(other, "b");
+  auto otherObject = addSimpleObjectTo(other, "a").audioObject;
+  otherObject->set(Gain::fromDb(-3.0));
+  otherObject->add(Label{"label"});
+  REQUIRE(otherObject->get<AudioObjectId>() !=
+          holder.audioObject->get<AudioObjectId>());
+  REQUIRE(otherObject->copy()->contentHash() ==
+          holder.audioObject->copy()->contentHash());
+
+  // but the IDs of referenced elements are
+  REQUIRE(otherObject->contentHash() != holder.audioObject->contentHash());
+}
+
+TEST_CASE("content hash is updated when parameters change") {
+  auto object = AudioObject::create(AudioObjectName{"object"});
+  auto initial = object->contentHash();
+  REQUIRE(object->contentHash() == initial);
+
+  SECTION("set and unset") {
+    object->set(Gain::fromDb(-3.0));
+    auto withGain = object->contentHash();
+    REQUIRE(withGain != initial);
+    object->set(Gain::fromLinear(0.5));
+    REQUIRE(object->contentHash() != withGain);
+    object->unset<Gain>();
+    REQUIRE(object->contentHash() == initial);
+
+    object->set(Start{Time{1s}});
+    REQUIRE(object->contentHash() != initial);
+    object->unset<Start>();
+    REQUIRE(object->contentHash() == initial);
+
+    object->set(SphericalPositionOffset{AzimuthOffset{10.0f}});
+    auto spherical = object->contentHash();
+    REQUIRE(spherical != initial);
+    object->set(CartesianPositionOffset{XOffset{10.0f}});
+    REQUIRE(object->contentHash() != spherical);
+    object->unset<PositionOffset>();
+    REQUIRE(object->contentHash() == initial);
+
+    object->set(Dialogue::DIALOGUE);
+    REQUIRE(object->contentHash() != initial);
+    object->unset<DialogueId>();
+    REQUIRE(object->contentHash() == initial);
+
+    object->set(AudioObjectName{"renamed"});
+    REQUIRE(object->contentHash() != initial);
+  }
+
+  SECTION("add and remove") {
+    object->add(Label{"label"});
+    REQUIRE(object->contentHash() != initial);
+    object->remove(Label{"label"});
+    REQUIRE(object->contentHash() == initial);
+  }
+
+  SECTION("references") {
+    auto packFormat = AudioPackFormat::create(AudioPackFormatName{"pack"},
+                                              TypeDefinition::OBJECTS);
+    object->addReference(packFormat);
+    REQUIRE(object->contentHash() != initial);
+    object->removeReference(packFormat);
+    REQUIRE(object->contentHash() == initial);
+  }
+}
+
+TEST_CASE("content hash of other elements") {
+  auto programme = AudioProgramme::create(AudioProgrammeName{"programme"});
+  auto programmeHash = programme->contentHash();
+  programme->add(LoudnessMetadata{IntegratedLoudness{-23.0f}});
+  REQUIRE(programme->contentHash() != programmeHash);
+
+  auto content = AudioContent::create(AudioContentName{"content"});
+  auto contentHash = content->contentHash();
+  content->set(DialogueContentKind{DialogueContent::COMMENTARY});
+  REQUIRE(content->contentHash() != contentHash);
+  content->unset<DialogueId>();
+  REQUIRE(content->contentHash() == contentHash);
+
+  auto packFormat = AudioPackFormatHoa::create(AudioPackFormatName{"pack"});
+  auto packFormatHash = packFormat->contentHash();
+  packFormat->set(Normalization{"N3D"});
+  REQUIRE(packFormat->contentHash() != packFormatHash);
+
+  auto channelFormat = AudioChannelFormat::create(
+      AudioChannelFormatName{"channel"}, TypeDefinition::OBJECTS);
+  auto channelFormatHash = channelFormat->contentHash();
+  channelFormat->add(AudioBlockFormatObjects{SphericalPosition{}});
+  REQUIRE(channelFormat->contentHash() == channelFormatHash);
+  channelFormat->set(Frequency{LowPass{120.0f}});
+  REQUIRE(channelFormat->contentHash() != channelFormatHash);
+
+  auto trackUid = AudioTrackUid::create();
+  auto trackUidHash = trackUid->contentHash();
+  trackUid->set(SampleRate{48000});
+  REQUIRE(trackUid->contentHash() != trackUidHash);
+}
+
+TEST_CASE("content hash of block formats") {
+  AudioBlockFormatObjects block{SphericalPosition{Azimuth{30.0f}},
+                                Rtime{1s}, Duration{1s}};
+  auto copy = block;
+  copy.set(AudioBlockFormatId{TypeDefinition::OBJECTS,
+                              AudioBlockFormatIdValue{0x1001},
+                              AudioBlockFormatIdCounter{2}});
+  REQUIRE(copy.contentHash() == block.contentHash());
+
+  copy.set(Gain::fromDb(-3.0));
+  REQUIRE(copy.contentHash() != block.contentHash());
+  copy.unset<Gain>();
+  REQUIRE(copy.contentHash() == block.contentHash());
+
+  copy.set(CartesianPosition{X{30.0f}});
+  REQUIRE(copy.contentHash() != block.contentHash());
+
+  // -0 and 0 are the same value
+  AudioBlockFormatObjects zero{SphericalPosition{Azimuth{0.0f}}};
+  AudioBlockFormatObjects negativeZero{SphericalPosition{Azimuth{-0.0f}}};
+  REQUIRE(zero.contentHash() == negativeZero.contentHash());
+
+  AudioBlockFormatDirectSpeakers speakers{SphericalSpeakerPosition{}};
+  auto speakersHash = speakers.contentHash();
+  speakers.add(SpeakerLabel{"M+000"});
+  REQUIRE(speakers.contentHash() != speakersHash);
+
+  AudioBlockFormatHoa hoa{Order{1}, Degree{1}};
+  AudioBlockFormatHoa otherHoa{Order{1}, Degree{-1}};
+  REQUIRE(hoa.contentHash() != otherHoa.contentHash());
+
+  AudioBlockFormatMatrix matrix;
+  AudioBlockFormatBinaural binaural;
+  REQUIRE(matrix.contentHash() == AudioBlockFormatMatrix{}.contentHash());
+  REQUIRE(binaural.contentHash() == AudioBlockFormatBinaural{}.contentHash());
+}
+
+TEST_CASE("content hash can be used to find duplicate block formats") {
+  std::vector<AudioBlockFormatObjects> blocks;
+  for (int i = 0; i < 10; i++)
+    blocks.push_back(AudioBlockFormatObjects{
+        SphericalPosition{Azimuth{static_cast<float>(i % 3)}}});
+
+  std::unordered_set<std::uint64_t> unique;
+  for (auto& block : blocks) unique.insert(block.contentHash());
+  REQUIRE(unique.size() == 3);
+}
+
+TEST_CASE("content hash is stable") {
+  // the hash must not depend on the platform or the run, so that it can be
+  // stored; update this if the hashed parameters change
+  AudioBlockFormatObjects block{SphericalPosition{Azimuth{30.0f}},
+                                Rtime{1s}, Duration{1s}};
+  CHECK(block.contentHash() == 0x6b07ccd59c3b1152u);
+}
@@ -0,0 +1,198 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <vector>
+#include "adm/common_definitions.hpp"
+#include "adm/document.hpp"
+#include "adm/elements.hpp"
+#include "adm/serial.hpp"
+#include "adm/serial/changed_ids.hpp"
+#include "adm/serial/document_diff.hpp"
+#include "adm/serial/frame_receiver.hpp"
+#include "adm/serial/frame_writer.hpp"
+#include "adm/utilities/object_creation.hpp"
+
+using namespace adm;
+using namespace std::chrono_literals;
+
+namespace {
+  /// a document with two objects, with one-second blocks from 0 to 10s
+  std::shared_ptr<Document> makeDocument() {
+    auto document = Document::create();
+    addCommonDefinitionsTo(document);
+    for (auto name : {"a", "b"}) {
+      auto holder = addSimpleObjectTo(document, name);
+      for (int i = 0; i < 10; i++)
+        holder.audioChannelFormat->add(AudioBlockFormatObjects{
+            SphericalPosition{Azimuth{static_cast<float>(i)}},
+            Rtime{std::chrono::seconds(i)}, Duration{1s}});
+    }
+    return document;
+  }
+
+  /// a copy of document with only the blocks which start in [start, end)
+  std::shared_ptr<Document> keepBlocks(std::shared_ptr<const Document> document,
+                                       std::chrono::nanoseconds start,
+                                       std::chrono::nanoseconds end) {
+    auto copy = document->deepCopy();
+    for (auto channelFormat : copy->getElements<AudioChannelFormat>()) {
+      auto blocks = channelFormat->getElements<AudioBlockFormatObjects>();
+      std::vector<AudioBlockFormatObjects> kept;
+      for (auto& block : blocks) {
+        auto rtime = block.get<Rtime>()->asNanoseconds();
+        if (rtime >= start && rtime < end) kept.push_back(block);
+      }
+      channelFormat->clearAudioBlockFormats();
+      for (auto& block : kept) channelFormat->add(block);
+    }
+    return copy;
+  }
+
+  std::size_t changedCount(const ChangedIds& changedIds) {
+    return changedIds.get<ChangedAudioProgrammeIds>().size() +
+           changedIds.get<ChangedAudioContentIds>().size() +
+           changedIds.get<ChangedAudioObjectIds>().size() +
+           changedIds.get<ChangedAudioPackFormatIds>().size() +
+           changedIds.get<ChangedAudioChannelFormatIds>().size() +
+           changedIds.get<ChangedAudioStreamFormatIds>().size() +
+           changedIds.get<ChangedAudioTrackFormatIds>().size() +
+           changedIds.get<ChangedAudioTrackUidIds>().size();
+  }
+}  // namespace
+
+TEST_CASE("diff of identical documents is empty") {
+  auto document = makeDocument();
+  REQUIRE(changedCount(diffDocuments(document, document)) == 0);
+  REQUIRE(changedCount(diffDocuments(document, document->deepCopy())) == 0);
+}
+
+TEST_CASE("diff finds new and expired elements") {
+  auto previous = makeDocument();
+  auto current = previous->deepCopy();
+
+  auto holder = addSimpleObjectTo(current, "c");
+  auto removed = current->getElements<AudioObject>()[1];
+  current->remove(removed);
+
+  auto changedIds = diffDocuments(previous, current);
+  REQUIRE(changedIds.get<ChangedAudioObjectIds>() ==
+          ChangedAudioObjectIds{
+              createChangedId(holder.audioObject, ChangedIdStatus::NEW),
+              createChangedId(removed, ChangedIdStatus::EXPIRED)});
+  REQUIRE(changedIds.get<ChangedAudioChannelFormatIds>() ==
+          ChangedAudioChannelFormatIds{createChangedId(
+              holder.audioChannelFormat, ChangedIdStatus::NEW)});
+  REQUIRE(changedCount(changedIds) == 7);
+}
+
+TEST_CASE("diff finds changed elements") {
+  auto previous = makeDocument();
+  auto current = previous->deepCopy();
+  auto object = current->getElements<AudioObject>()[0];
+
+  SECTION("parameter") {
+    object->set(Gain::fromDb(-3.0));
+    REQUIRE(diffDocuments(previous, current).get<ChangedAudioObjectIds>() ==
+            ChangedAudioObjectIds{
+                createChangedId(object, ChangedIdStatus::CHANGED)});
+  }
+
+  SECTION("reference") {
+    auto packFormat = current->getElements<AudioObject>()[1]
+                          ->getReferences<AudioPackFormat>()[0];
+    object->addReference(packFormat);
+    auto changedIds = diffDocuments(previous, current);
+    REQUIRE(changedIds.get<ChangedAudioObjectIds>() ==
+            ChangedAudioObjectIds{
+                createChangedId(object, ChangedIdStatus::CHANGED)});
+    REQUIRE(changedCount(changedIds) == 1);
+  }
+
+  SECTION("channel format") {
+    auto channelFormat = current->lookup(
+        object->getReferences<AudioPackFormat>()[0]
+            ->getReferences<AudioChannelFormat>()[0]
+            ->get<AudioChannelFormatId>());
+    channelFormat->set(AudioChannelFormatName{"changed"});
+    REQUIRE(diffDocuments(previous, current)
+                .get<ChangedAudioChannelFormatIds>() ==
+            ChangedAudioChannelFormatIds{
+                createChangedId(channelFormat, ChangedIdStatus::CHANGED)});
+  }
+
+  SECTION("block") {
+    auto channelFormat = current->getElements<AudioChannelFormat>().back();
+    auto blocks = channelFormat->getElements<AudioBlockFormatObjects>();
+    blocks[5].set(Gain::fromDb(-3.0));
+    REQUIRE(diffDocuments(previous, current)
+                .get<ChangedAudioChannelFormatIds>() ==
+            ChangedAudioChannelFormatIds{
+                createChangedId(channelFormat, ChangedIdStatus::CHANGED)});
+  }
+}
+
+TEST_CASE("diff finds extended channel formats") {
+  auto document = makeDocument();
+  auto channelFormats = document->getElements<AudioChannelFormat>();
+  auto channelFormat = channelFormats.back();
+
+  SECTION("blocks added to the end") {
+    auto previous = keepBlocks(document, 0s, 5s);
+    auto current = keepBlocks(document, 0s, 7s);
+    REQUIRE(diffDocuments(previous, current)
+                .get<ChangedAudioChannelFormatIds>() ==
+            ChangedAudioChannelFormatIds{
+                createChangedId(channelFormats[channelFormats.size() - 2],
+                                ChangedIdStatus::EXTENDED),
+                createChangedId(channelFormat, ChangedIdStatus::EXTENDED)});
+
+    // blocks which are no longer present are not a change
+    REQUIRE(diffDocuments(current, previous)
+                .get<ChangedAudioChannelFormatIds>()
+                .size() == 0);
+  }
+
+  SECTION("consecutive frames") {
+    auto previous = keepBlocks(document, 2s, 4s);
+    auto current = keepBlocks(document, 4s, 6s);
+    auto changed =
+        diffDocuments(previous, current).get<ChangedAudioChannelFormatIds>();
+    REQUIRE(changed.size() == 2);
+    REQUIRE(changed[1] ==
+            createChangedId(channelFormat, ChangedIdStatus::EXTENDED));
+
+    // overlapping frames with the same blocks
+    REQUIRE(changedCount(diffDocuments(keepBlocks(document, 2s, 5s),
+                                       keepBlocks(document, 4s, 6s))) == 2);
+    REQUIRE(changedCount(diffDocuments(keepBlocks(document, 2s, 6s),
+                                       keepBlocks(document, 4s, 6s))) == 0);
+  }
+}
+
+TEST_CASE("diff output can be sent to a frame receiver") {
+  auto document = makeDocument();
+  SadmFrameWriter writer;
+  SadmFrameReceiver receiver;
+
+  std::shared_ptr<const Document> previous;
+  for (unsigned i = 0; i < 5; i++) {
+    auto current = document->deepCopy();
+    current->getElements<AudioObject>()[0]->set(
+        AudioObjectName{"object " + std::to_string(i)});
+
+    FrameFormat frameFormat{FrameFormatId{FrameIndex{i + 1}},
+                            Start{Time{std::chrono::seconds(2 * i)}},
+                            Duration{Time{2s}}, FrameType::FULL};
+    if (previous) frameFormat.set(diffDocuments(previous, current));
+    FrameHeader header{frameFormat};
+
+    std::stringstream stream;
+    writer.write(current, header, stream);
+    receiver.receive(stream);
+    previous = current;
+
+    auto live = receiver.getDocument();
+    REQUIRE(live->lookup(document->getElements<AudioObject>()[0]
+                             ->get<AudioObjectId>())
+                ->get<AudioObjectName>() == "object " + std::to_string(i));
+  }
+}
@@ -23,4 +23,10 @@ namespace {
 TEST_CASE("Test minimal frame header parsing") {
   std::stringstream header_xml{MINIMAL_HEADER};
   CHECK_NOTHROW(adm::parseFrameHeader(header_xml));
-}
\ No newline at end of file
+}
+TEST_CASE("Test frame header parsing from a buffer") {
+  std::string header_xml{MINIMAL_HEADER};
+  auto header = adm::parseFrameHeader(header_xml.data(), header_xml.size());
+  CHECK(header.get<adm::FrameFormat>().get<adm::FrameFormatId>() ==
+        adm::parseFrameFormatId("FF_00000001"));
+}
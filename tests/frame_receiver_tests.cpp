@@ -0,0 +1,217 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include "adm/document.hpp"
+#include "adm/elements.hpp"
+#include "adm/serial.hpp"
+#include "adm/serial/changed_ids.hpp"
+#include "adm/serial/frame_receiver.hpp"
+#include "adm/serial/frame_writer.hpp"
+#include "adm/utilities/object_creation.hpp"
+#include "adm/write.hpp"
+#include "helper/frame_fixtures.hpp"
+
+using namespace adm;
+using namespace std::chrono_literals;
+
+namespace {
+  /// the document from makeFrameDocument(), with the objects in a content
+  std::shared_ptr<Document> makeDocument() {
+    auto document = adm_test::makeFrameDocument();
+    auto content = AudioContent::create(AudioContentName{"content"});
+    for (auto object : document->getElements<AudioObject>())
+      content->addReference(object);
+    document->add(content);
+    return document;
+  }
+
+  /// the frame with index i, which is two seconds long
+  FrameHeader frameHeader(unsigned i, ChangedIds changedIds = ChangedIds{}) {
+    return adm_test::makeFrameHeader(i + 1, std::chrono::seconds(2 * i), 2s,
+                                      TimeReference::TOTAL, changedIds);
+  }
+
+  void send(SadmFrameReceiver& receiver, SadmFrameWriter& writer,
+            std::shared_ptr<const Document> document,
+            const FrameHeader& header) {
+    std::stringstream stream;
+    writer.write(document, header, stream);
+    auto received = receiver.receive(stream);
+    REQUIRE(received.get<FrameFormat>().get<FrameFormatId>() ==
+            header.get<FrameFormat>().get<FrameFormatId>());
+  }
+
+  std::string write(std::shared_ptr<const Document> document) {
+    std::stringstream stream;
+    writeXml(stream, document);
+    return stream.str();
+  }
+
+  /// the element in live with the same ID as element
+  template <typename Element>
+  std::shared_ptr<Element> lookup(std::shared_ptr<Document> live,
+                                  std::shared_ptr<Element> element) {
+    return live->lookup(element->template get<typename Element::id_type>());
+  }
+
+  std::size_t blockCount(std::shared_ptr<const AudioChannelFormat> channel) {
+    return channel->getElements<AudioBlockFormatObjects>().size();
+  }
+}  // namespace
+
+TEST_CASE("frame receiver builds the document from a sequence of frames") {
+  auto document = makeDocument();
+  SadmFrameReceiver receiver;
+  SadmFrameWriter writer;
+  REQUIRE(receiver.getDocument() == nullptr);
+
+  send(receiver, writer, document, frameHeader(0));
+  auto live = receiver.getDocument();
+  REQUIRE(live != nullptr);
+  auto object = lookup(live, document->getElements<AudioObject>()[0]);
+  auto channel = lookup(live, document->getElements<AudioChannelFormat>()[0]);
+  REQUIRE(object != nullptr);
+  REQUIRE(blockCount(channel) == 2);
+
+  for (unsigned i = 1; i < 5; i++) {
+    send(receiver, writer, document, frameHeader(i));
+    REQUIRE(blockCount(channel) == 2 * (i + 1));
+  }
+
+  // unchanged elements are kept
+  REQUIRE(receiver.getDocument() == live);
+  REQUIRE(lookup(live, document->getElements<AudioObject>()[0]) == object);
+  REQUIRE(lookup(live, document->getElements<AudioChannelFormat>()[0]) ==
+          channel);
+  REQUIRE(write(live) == write(document));
+
+  // repeated frames do not add anything
+  send(receiver, writer, document, frameHeader(4));
+  REQUIRE(write(live) == write(document));
+
+  receiver.reset();
+  REQUIRE(receiver.getDocument() == nullptr);
+}
+
+TEST_CASE("frame receiver replaces changed elements") {
+  auto document = makeDocument();
+  SadmFrameReceiver receiver;
+  SadmFrameWriter writer;
+  send(receiver, writer, document, frameHeader(0));
+  auto live = receiver.getDocument();
+  auto object = document->getElements<AudioObject>()[0];
+  auto channel = document->getElements<AudioChannelFormat>()[0];
+  auto liveObject = lookup(live, object);
+  auto liveChannel = lookup(live, channel);
+  auto channelCount = live->getElements<AudioChannelFormat>().size();
+
+  // not listed, so not updated
+  object->set(AudioObjectName{"changed"});
+  writer.clearCache();
+  send(receiver, writer, document, frameHeader(1));
+  REQUIRE(lookup(live, object) == liveObject);
+  REQUIRE(liveObject->get<AudioObjectName>() == "a");
+
+  // listed as changed
+  channel->set(AudioChannelFormatName{"changed"});
+  send(receiver, writer, document,
+       frameHeader(2, ChangedIds{ChangedAudioObjectIds{createChangedId(
+                                     object, ChangedIdStatus::CHANGED)},
+                                 ChangedAudioChannelFormatIds{createChangedId(
+                                     channel, ChangedIdStatus::CHANGED)}}));
+
+  auto newObject = lookup(live, object);
+  REQUIRE(newObject != liveObject);
+  REQUIRE(newObject->get<AudioObjectName>() == "changed");
+  REQUIRE(liveObject->getParent().lock() == nullptr);
+
+  // earlier blocks are kept in the changed channel
+  auto newChannel = lookup(live, channel);
+  REQUIRE(newChannel != liveChannel);
+  REQUIRE(newChannel->get<AudioChannelFormatName>() == "changed");
+  REQUIRE(blockCount(newChannel) == 6);
+
+  // references to and from the replaced elements are kept
+  auto content = live->getElements<AudioContent>()[0];
+  REQUIRE(content->getReferences<AudioObject>().size() == 2);
+  REQUIRE(content->getReferences<AudioObject>()[0] == newObject);
+  REQUIRE(newObject->getReferences<AudioPackFormat>().size() == 1);
+  REQUIRE(newObject->getReferences<AudioTrackUid>().size() == 1);
+  auto packFormat = newObject->getReferences<AudioPackFormat>()[0];
+  REQUIRE(packFormat->getReferences<AudioChannelFormat>()[0] == newChannel);
+  auto trackUid = newObject->getReferences<AudioTrackUid>()[0];
+  REQUIRE(trackUid->getReference<AudioTrackFormat>()
+              ->getReference<AudioStreamFormat>()
+              ->getReference<AudioChannelFormat>() == newChannel);
+
+  for (unsigned i = 3; i < 5; i++)
+    send(receiver, writer, document, frameHeader(i));
+  REQUIRE(blockCount(newChannel) == 10);
+  REQUIRE(live->getElements<AudioObject>().size() == 2);
+  REQUIRE(live->getElements<AudioChannelFormat>().size() == channelCount);
+}
+
+TEST_CASE("frame receiver adds new elements and removes expired ones") {
+  auto document = makeDocument();
+  SadmFrameReceiver receiver;
+  SadmFrameWriter writer;
+  send(receiver, writer, document, frameHeader(0));
+  auto live = receiver.getDocument();
+
+  auto holder = addSimpleObjectTo(document, "c");
+  send(receiver, writer, document, frameHeader(1));
+  REQUIRE(live->getElements<AudioObject>().size() == 3);
+  auto newObject = lookup(live, holder.audioObject);
+  REQUIRE(newObject != nullptr);
+  REQUIRE(newObject->getReferences<AudioPackFormat>()[0] ==
+          lookup(live, holder.audioPackFormat));
+
+  // the content changes too, so the cached XML can not be used
+  auto object = document->getElements<AudioObject>()[1];
+  document->remove(object);
+  writer.clearCache();
+  send(receiver, writer, document,
+       frameHeader(2, ChangedIds{ChangedAudioObjectIds{createChangedId(
+                          object, ChangedIdStatus::EXPIRED)}}));
+  REQUIRE(live->getElements<AudioObject>().size() == 2);
+  REQUIRE(lookup(live, object) == nullptr);
+  auto content = live->getElements<AudioContent>()[0];
+  REQUIRE(content->getReferences<AudioObject>().size() == 1);
+}
+
+TEST_CASE("frame receiver recovers from missing frames") {
+  auto document = makeDocument();
+  SadmFrameReceiver receiver;
+  SadmFrameWriter writer;
+  send(receiver, writer, document, frameHeader(0));
+  auto channel = lookup(receiver.getDocument(),
+                        document->getElements<AudioChannelFormat>()[0]);
+
+  // the blocks from the missing frame cannot be added, so the blocks are
+  // replaced with those in the latest frame
+  send(receiver, writer, document, frameHeader(2));
+  auto blocks = channel->getElements<AudioBlockFormatObjects>();
+  REQUIRE(blocks.size() == 2);
+  REQUIRE(blocks[0].get<Rtime>().get().asNanoseconds() == 4s);
+
+  send(receiver, writer, document, frameHeader(3));
+  REQUIRE(blockCount(channel) == 4);
+}
+
+TEST_CASE("frame receiver applies parsed frames") {
+  auto document = makeDocument();
+  SadmFrameReceiver receiver;
+
+  receiver.apply(document, frameHeader(0));
+  auto live = receiver.getDocument();
+  REQUIRE(live != document);
+  REQUIRE(write(live) == write(document));
+
+  auto frame = document->deepCopy();
+  auto holder = addSimpleObjectTo(frame, "c");
+  auto before = write(frame);
+  receiver.apply(frame, frameHeader(1));
+  REQUIRE(write(frame) == before);
+  REQUIRE(lookup(live, holder.audioObject) != nullptr);
+  REQUIRE(holder.audioObject->getParent().lock() == frame);
+}
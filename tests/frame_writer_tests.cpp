@@ -0,0 +1,174 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "adm/document.hpp"
+#include "adm/elements.hpp"
+#include "adm/serial.hpp"
+#include "adm/serial/changed_ids.hpp"
+#include "adm/serial/frame_view.hpp"
+#include "adm/serial/frame_writer.hpp"
+#include "adm/utilities/object_creation.hpp"
+#include "adm/write.hpp"
+#include "helper/frame_fixtures.hpp"
+
+using namespace adm;
+using namespace std::chrono_literals;
+using adm_test::makeFrameDocument;
+using adm_test::makeFrameHeader;
+
+namespace {
+  /// a copy of document with only the blocks which start in [start, end)
+  std::shared_ptr<Document> keepBlocks(std::shared_ptr<const Document> document,
+                                       std::chrono::nanoseconds start,
+                                       std::chrono::nanoseconds end) {
+    auto copy = document->deepCopy();
+    for (auto channelFormat : copy->getElements<AudioChannelFormat>()) {
+      auto blocks = channelFormat->getElements<AudioBlockFormatObjects>();
+      std::vector<AudioBlockFormatObjects> kept;
+      for (auto& block : blocks) {
+        auto rtime = block.get<Rtime>()->asNanoseconds();
+        if (rtime >= start && rtime < end) kept.push_back(block);
+      }
+      channelFormat->clearAudioBlockFormats();
+      for (auto& block : kept) channelFormat->add(block);
+    }
+    return copy;
+  }
+
+  std::string write(SadmFrameWriter& writer,
+                    std::shared_ptr<const Document> document,
+                    const FrameHeader& header) {
+    std::stringstream stream;
+    writer.write(document, header, stream);
+    return stream.str();
+  }
+
+  std::string writeXmlFrame(std::shared_ptr<const Document> document,
+                            const FrameHeader& header,
+                            xml::SadmWriterOptions options) {
+    std::stringstream stream;
+    writeXml(stream, document, header, options);
+    return stream.str();
+  }
+}  // namespace
+
+TEST_CASE("frame writer writes blocks which overlap each frame") {
+  auto document = makeFrameDocument();
+
+  for (auto options : {xml::SadmWriterOptions::none,
+                       xml::SadmWriterOptions::core_metadata,
+                       xml::SadmWriterOptions::write_default_values,
+                       xml::SadmWriterOptions::parallel}) {
+    SadmFrameWriter writer(options);
+    for (unsigned i = 0; i < 5; i++) {
+      auto start = std::chrono::seconds(2 * i);
+      auto header = makeFrameHeader(i + 1, start, 2s);
+      auto expected = writeXmlFrame(keepBlocks(document, start, start + 2s),
+                                    header, options);
+      REQUIRE(write(writer, document, header) == expected);
+    }
+  }
+}
+
+TEST_CASE("frame writer window edges") {
+  auto document = makeFrameDocument();
+  SadmFrameWriter writer;
+
+  // a block which starts inside the frame, and one which ends inside it
+  auto header = makeFrameHeader(1, 2500ms, 1s);
+  REQUIRE(write(writer, document, header) ==
+          writeXmlFrame(keepBlocks(document, 2s, 4s), header,
+                        xml::SadmWriterOptions::none));
+
+  // past the end of all blocks
+  header = makeFrameHeader(2, 20s, 1s);
+  REQUIRE(write(writer, document, header) ==
+          writeXmlFrame(keepBlocks(document, 0s, 0s), header,
+                        xml::SadmWriterOptions::none));
+
+  // with a local time reference, blocks are relative to the frame
+  header = makeFrameHeader(3, 20s, 1s, TimeReference::LOCAL);
+  REQUIRE(write(writer, document, header) ==
+          writeXmlFrame(keepBlocks(document, 0s, 1s), header,
+                        xml::SadmWriterOptions::none));
+}
+
+TEST_CASE("frame writer reuses unchanged elements") {
+  auto document = makeFrameDocument();
+  auto object = document->getElements<AudioObject>()[0];
+  SadmFrameWriter writer;
+
+  auto original = write(writer, document, makeFrameHeader(1, 0s, 1s));
+  REQUIRE(original.find("audioObjectName=\"a\"") != std::string::npos);
+
+  // unchanged, so the cached XML is used
+  REQUIRE(write(writer, document, makeFrameHeader(1, 0s, 1s)) == original);
+
+  // not listed as changed, but the content hash is different
+  object->set(AudioObjectName{"changed"});
+  REQUIRE(write(writer, document, makeFrameHeader(1, 0s, 1s)) ==
+          writeXmlFrame(keepBlocks(document, 0s, 1s),
+                        makeFrameHeader(1, 0s, 1s),
+                        xml::SadmWriterOptions::none));
+
+  // the ID is not part of the content hash, but is checked separately
+  object->set(AudioObjectId(AudioObjectIdValue(0x1234)));
+  auto renamed = write(writer, document, makeFrameHeader(1, 0s, 1s));
+  REQUIRE(renamed.find("audioObjectID=\"AO_1234\"") != std::string::npos);
+  REQUIRE(renamed == writeXmlFrame(keepBlocks(document, 0s, 1s),
+                                   makeFrameHeader(1, 0s, 1s),
+                                   xml::SadmWriterOptions::none));
+
+  // listed as changed
+  auto header = makeFrameHeader(2, 0s, 1s);
+  FrameFormat frameFormat = header.get<FrameFormat>();
+  frameFormat.set(
+      ChangedIds{ChangedAudioObjectIds{
+          createChangedId(object, ChangedIdStatus::CHANGED)}});
+  header.set(frameFormat);
+  REQUIRE(write(writer, document, header) ==
+          writeXmlFrame(keepBlocks(document, 0s, 1s), header,
+                        xml::SadmWriterOptions::none));
+
+  // after clearing the cache
+  object->set(AudioObjectName{"changed again"});
+  writer.clearCache();
+  header = makeFrameHeader(3, 0s, 1s);
+  REQUIRE(write(writer, document, header) ==
+          writeXmlFrame(keepBlocks(document, 0s, 1s), header,
+                        xml::SadmWriterOptions::none));
+
+  // removed elements are not written, and new elements are
+  document->remove(object);
+  addSimpleObjectTo(document, "c");
+  header = makeFrameHeader(4, 0s, 1s);
+  REQUIRE(write(writer, document, header) ==
+          writeXmlFrame(keepBlocks(document, 0s, 1s), header,
+                        xml::SadmWriterOptions::none));
+}
+
+TEST_CASE("writing a frame view") {
+  auto document = makeFrameDocument();
+
+  auto header = makeFrameHeader(1, 4s, 2s);
+  FrameView frameView(document, header);
+  REQUIRE(frameView.getDocument() == document);
+  REQUIRE(frameView.getStart().asNanoseconds() == 4s);
+  REQUIRE(frameView.getEnd().asNanoseconds() == 6s);
+
+  auto channelFormat = document->getElements<AudioChannelFormat>()[0];
+  REQUIRE(frameView.getBlocks<AudioBlockFormatObjects>(*channelFormat).size() ==
+          2);
+
+  std::stringstream stream;
+  writeXml(stream, frameView, header);
+  REQUIRE(stream.str() == writeXmlFrame(keepBlocks(document, 4s, 6s), header,
+                                        xml::SadmWriterOptions::none));
+
+  // local time reference
+  header = makeFrameHeader(1, 4s, 2s, TimeReference::LOCAL);
+  FrameView localView(document, header);
+  REQUIRE(localView.getStart().asNanoseconds() == 0s);
+  REQUIRE(localView.getEnd().asNanoseconds() == 2s);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include "adm/document.hpp"
+#include "adm/elements.hpp"
+#include "adm/serial.hpp"
+#include "adm/utilities/object_creation.hpp"
+
+namespace adm_test {
+
+  /// a document with two objects, "a" and "b", with one-second blocks from 0
+  /// to 10s
+  inline std::shared_ptr<adm::Document> makeFrameDocument() {
+    using namespace adm;
+    auto document = Document::create();
+    for (auto name : {"a", "b"}) {
+      auto holder = addSimpleObjectTo(document, name);
+      for (int i = 0; i < 10; i++)
+        holder.audioChannelFormat->add(AudioBlockFormatObjects{
+            SphericalPosition{Azimuth{static_cast<float>(i)}},
+            Rtime{std::chrono::seconds(i)},
+            Duration{std::chrono::seconds(1)}});
+    }
+    return document;
+  }
+
+  inline adm::FrameHeader makeFrameHeader(
+      unsigned index, std::chrono::nanoseconds start,
+      std::chrono::nanoseconds duration,
+      adm::TimeReference timeReference = adm::TimeReference::TOTAL,
+      adm::ChangedIds changedIds = adm::ChangedIds{}) {
+    using namespace adm;
+    return FrameHeader{FrameFormat{FrameFormatId{FrameIndex{index}},
+                                   Start{Time{start}}, Duration{Time{duration}},
+                                   FrameType::FULL, timeReference,
+                                   changedIds}};
+  }
+
+}  // namespace adm_test
@@ -0,0 +1,185 @@
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include "adm/document.hpp"
+#include "adm/elements.hpp"
+#include "adm/memory_arena.hpp"
+#include "adm/parse.hpp"
+#include "adm/utilities/copy.hpp"
+#include "adm/utilities/object_creation.hpp"
+#include "adm/write.hpp"
+
+// count heap allocations made by this program, to check that using an arena
+// reduces them
+namespace {
+  std::atomic<std::size_t> heapAllocations{0};
+}
+
+void* operator new(std::size_t size) {
+  heapAllocations++;
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using namespace adm;
+
+namespace {
+  std::string toXml(std::shared_ptr<const Document> document) {
+    std::stringstream stream;
+    writeXml(stream, document);
+    return stream.str();
+  }
+
+  std::string makeTestXml() {
+    auto document = Document::create();
+    for (int i = 0; i < 100; i++) {
+      auto holder = createSimpleObject("object " + std::to_string(i));
+      holder.audioChannelFormat->add(
+          AudioBlockFormatObjects{SphericalPosition{Azimuth{30.0f}}});
+      document->add(holder.audioObject);
+    }
+    return toXml(document);
+  }
+
+  /// number of heap allocations made while calling f
+  template <typename F>
+  std::size_t countHeapAllocations(F f) {
+    std::size_t before = heapAllocations;
+    f();
+    return heapAllocations - before;
+  }
+}  // namespace
+
+TEST_CASE("memory arena allocation") {
+  auto arena = MemoryArena::create(1024);
+  REQUIRE(arena->stats().chunks == 0);
+
+  void* a = arena->allocate(1, 1);
+  void* b = arena->allocate(16, 16);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 16 == 0);
+  REQUIRE(static_cast<char*>(b) >= static_cast<char*>(a) + 1);
+  REQUIRE(arena->stats().chunks == 1);
+
+  // larger than a chunk
+  void* c = arena->allocate(4096);
+  REQUIRE(c != nullptr);
+  REQUIRE(arena->stats().chunks == 2);
+
+  auto stats = arena->stats();
+  REQUIRE(stats.allocations == 3);
+  REQUIRE(stats.bytes == 1 + 16 + 4096);
+}
+
+TEST_CASE("elements are allocated from the current arena") {
+  auto arena = MemoryArena::create();
+
+  auto heapObject = AudioObject::create(AudioObjectName{"heap"});
+  REQUIRE(arena->stats().allocations == 0);
+
+  std::shared_ptr<AudioObject> arenaObject;
+  {
+    ArenaScope scope(arena);
+    arenaObject = AudioObject::create(AudioObjectName{"arena"});
+    // the element and the shared_ptr control block
+    REQUIRE(arena->stats().allocations == 2);
+
+    {
+      ArenaScope heapScope(nullptr);
+      AudioObject::create(AudioObjectName{"heap"});
+    }
+    REQUIRE(arena->stats().allocations == 2);
+
+    auto copy = arenaObject->copy();
+    REQUIRE(arena->stats().allocations == 4);
+    REQUIRE(copy->get<AudioObjectName>() == "arena");
+  }
+
+  AudioObject::create(AudioObjectName{"heap"});
+  REQUIRE(arena->stats().allocations == 4);
+}
+
+TEST_CASE("arena lifetime") {
+  std::weak_ptr<MemoryArena> weakArena;
+  std::shared_ptr<AudioObject> object;
+  {
+    auto document = Document::create(MemoryArena::create());
+    weakArena = document->getArena();
+    ArenaScope scope(document->getArena());
+    object = AudioObject::create(AudioObjectName{"object"});
+    document->add(object);
+    document->add(AudioObject::create(AudioObjectName{"other"}));
+  }
+
+  // the remaining element keeps the arena alive
+  REQUIRE(!weakArena.expired());
+  REQUIRE(object->get<AudioObjectName>() == "object");
+
+  object.reset();
+  REQUIRE(weakArena.expired());
+}
+
+TEST_CASE("deepCopy of a document with an arena") {
+  auto document = Document::create(MemoryArena::create());
+  {
+    ArenaScope scope(document->getArena());
+    addSimpleObjectTo(document, "object");
+  }
+  REQUIRE(Document::create()->getArena() == nullptr);
+
+  auto copy = document->deepCopy();
+  REQUIRE(copy->getArena() != nullptr);
+  REQUIRE(copy->getArena() != document->getArena());
+  REQUIRE(copy->getArena()->stats().allocations > 0);
+  REQUIRE(toXml(copy) == toXml(document));
+
+  auto dest = Document::create(MemoryArena::create());
+  deepCopyTo(document, dest);
+  REQUIRE(dest->getArena()->stats().allocations ==
+          copy->getArena()->stats().allocations);
+  REQUIRE(toXml(dest) == toXml(document));
+
+  // no arena
+  auto heapDocument = Document::create();
+  addSimpleObjectTo(heapDocument, "object");
+  REQUIRE(heapDocument->deepCopy()->getArena() == nullptr);
+}
+
+TEST_CASE("parsing into an arena") {
+  std::string xml = makeTestXml();
+  auto expected = toXml(parseXml(xml.data(), xml.size()));
+
+  for (auto options :
+       {xml::ParserOptions::none, xml::ParserOptions::incremental,
+        xml::ParserOptions::parallel}) {
+    auto document =
+        parseXml(xml.data(), xml.size(), options | xml::ParserOptions::arena);
+    REQUIRE(document->getArena() != nullptr);
+    REQUIRE(toXml(document) == expected);
+  }
+
+  // each element saves two heap allocations: the element itself and its
+  // shared_ptr control block. Adding the common definitions takes a slightly
+  // different path with an arena, so only require most of this saving
+  std::size_t heap = countHeapAllocations(
+      [&]() { parseXml(xml.data(), xml.size()); });
+  std::size_t withArena = countHeapAllocations([&]() {
+    parseXml(xml.data(), xml.size(), xml::ParserOptions::arena);
+  });
+  auto document = parseXml(xml.data(), xml.size(), xml::ParserOptions::arena);
+  std::size_t elements = document->getElements<AudioProgramme>().size() +
+                         document->getElements<AudioContent>().size() +
+                         document->getElements<AudioObject>().size() +
+                         document->getElements<AudioPackFormat>().size() +
+                         document->getElements<AudioChannelFormat>().size() +
+                         document->getElements<AudioStreamFormat>().size() +
+                         document->getElements<AudioTrackFormat>().size() +
+                         document->getElements<AudioTrackUid>().size();
+  CAPTURE(heap, withArena, elements);
+  REQUIRE(withArena + elements < heap);
+}
@@ -0,0 +1,160 @@
+#include <catch2/catch.hpp>
+#include <clocale>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <random>
+#include <sstream>
+#include "adm/private/number_parser.hpp"
+
+using adm::xml::detail::parseNumber;
+
+namespace {
+  /// format value with enough digits to round-trip, independent of locale
+  template <typename T>
+  std::string formatExact(T value) {
+    std::ostringstream ss;
+    ss.imbue(std::locale::classic());
+    ss << std::setprecision(std::numeric_limits<T>::max_digits10) << value;
+    return ss.str();
+  }
+
+  template <typename T>
+  void checkRoundTrip(T value) {
+    auto str = formatExact(value);
+    CAPTURE(str);
+    REQUIRE(parseNumber<T>(str.c_str()) == value);
+  }
+}  // namespace
+
+TEST_CASE("parse floating point numbers") {
+  REQUIRE(parseNumber<double>("0") == 0.0);
+  REQUIRE(parseNumber<double>("-0.5") == -0.5);
+  REQUIRE(parseNumber<double>("+1.25") == 1.25);
+  REQUIRE(parseNumber<double>(".5") == 0.5);
+  REQUIRE(parseNumber<double>("5.") == 5.0);
+  REQUIRE(parseNumber<double>("1e3") == 1000.0);
+  REQUIRE(parseNumber<double>("1.5E-3") == 0.0015);
+  REQUIRE(parseNumber<double>("  2.5\n") == 2.5);
+  REQUIRE(parseNumber<double>("0.1") == 0.1);
+  REQUIRE(parseNumber<float>("0.1") == 0.1f);
+  REQUIRE(parseNumber<float>("30.000000") == 30.0f);
+  REQUIRE(parseNumber<double>("123456789012345678901234567890") ==
+          123456789012345678901234567890.0);
+  REQUIRE(parseNumber<double>("0.000000000000000000000000000001") == 1e-30);
+  REQUIRE(parseNumber<double>("0e-400") == 0.0);
+  REQUIRE(std::signbit(parseNumber<double>("-0.0")));
+
+  REQUIRE(parseNumber<double>("inf") ==
+          std::numeric_limits<double>::infinity());
+  REQUIRE(parseNumber<float>("-Infinity") ==
+          -std::numeric_limits<float>::infinity());
+  REQUIRE(std::isnan(parseNumber<double>("NaN")));
+
+  for (auto str : {"", " ", "-", ".", "e5", "1e", "1.0dB", "1,5", "0x10",
+                   "1 2", "infx"}) {
+    CAPTURE(str);
+    REQUIRE_THROWS_AS(parseNumber<double>(str), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseNumber<float>(str), std::invalid_argument);
+  }
+  REQUIRE_THROWS_AS(parseNumber<double>("1e400"), std::out_of_range);
+  REQUIRE_THROWS_AS(parseNumber<float>("1e39"), std::out_of_range);
+
+  // values which underflow are out of range too
+  REQUIRE_THROWS_AS(parseNumber<double>("1e-400"), std::out_of_range);
+  REQUIRE_THROWS_AS(parseNumber<double>("-1e-320"), std::out_of_range);
+  REQUIRE_THROWS_AS(parseNumber<float>("1e-50"), std::out_of_range);
+  REQUIRE_THROWS_AS(parseNumber<float>("1e-40"), std::out_of_range);
+}
+
+TEST_CASE("floating point round trip") {
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<uint64_t> bits;
+
+  for (int i = 0; i < 20000; i++) {
+    uint64_t b = bits(rng);
+    double d;
+    std::memcpy(&d, &b, sizeof(d));
+    if (std::isnormal(d)) checkRoundTrip(d);
+
+    auto b32 = static_cast<uint32_t>(b);
+    float f;
+    std::memcpy(&f, &b32, sizeof(f));
+    if (std::isnormal(f)) checkRoundTrip(f);
+  }
+
+  // typical ADM values, which take the fast path
+  std::uniform_real_distribution<double> position(-180.0, 180.0);
+  for (int i = 0; i < 20000; i++) {
+    checkRoundTrip(position(rng));
+    checkRoundTrip(static_cast<float>(position(rng)));
+  }
+
+  for (double d :
+       {std::numeric_limits<double>::min(), std::numeric_limits<double>::max(),
+        9007199254740993.0, 0.1, 1e22, 1e23})
+    checkRoundTrip(d);
+  for (float f : {std::numeric_limits<float>::min(),
+                  std::numeric_limits<float>::max(), 16777217.0f, 0.1f})
+    checkRoundTrip(f);
+}
+
+TEST_CASE("parse integers") {
+  REQUIRE(parseNumber<int>("0") == 0);
+  REQUIRE(parseNumber<int>("-42") == -42);
+  REQUIRE(parseNumber<int>("+42") == 42);
+  REQUIRE(parseNumber<int>(" 7 ") == 7);
+  REQUIRE(parseNumber<int>("2147483647") == 2147483647);
+  REQUIRE(parseNumber<int>("-2147483648") == -2147483647 - 1);
+  REQUIRE(parseNumber<unsigned int>("4294967295") == 4294967295u);
+  REQUIRE(parseNumber<unsigned int>("-0") == 0u);
+
+  REQUIRE_THROWS_AS(parseNumber<int>("2147483648"), std::out_of_range);
+  REQUIRE_THROWS_AS(parseNumber<int>("-2147483649"), std::out_of_range);
+  REQUIRE_THROWS_AS(parseNumber<int>("99999999999999999999999"),
+                    std::out_of_range);
+  REQUIRE_THROWS_AS(parseNumber<unsigned int>("4294967296"),
+                    std::out_of_range);
+  REQUIRE_THROWS_AS(parseNumber<unsigned int>("-1"), std::out_of_range);
+  for (auto str : {"", "-", "1.5", "1e3", "a", "0x1"}) {
+    CAPTURE(str);
+    REQUIRE_THROWS_AS(parseNumber<int>(str), std::invalid_argument);
+  }
+
+  for (int i : {0, 1, -1, 12345, std::numeric_limits<int>::max(),
+                std::numeric_limits<int>::min()})
+    REQUIRE(parseNumber<int>(std::to_string(i).c_str()) == i);
+}
+
+TEST_CASE("number parsing does not depend on the locale") {
+  std::string oldLocale = std::setlocale(LC_ALL, nullptr);
+  bool found = false;
+  for (auto name : {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8",
+                    "German_Germany.1252"}) {
+    if (std::setlocale(LC_ALL, name)) {
+      found = true;
+      break;
+    }
+  }
+  if (!found) {
+    WARN("no locale with a decimal comma found; not testing");
+    return;
+  }
+
+  // the second of these takes the slow path
+  double fast = 0.0, slow = 0.0;
+  bool threw = false;
+  try {
+    fast = parseNumber<double>("1.5");
+    slow = parseNumber<double>("1.5e-300");
+  } catch (...) {
+    threw = true;
+  }
+  std::setlocale(LC_ALL, oldLocale.c_str());
+
+  REQUIRE(!threw);
+  REQUIRE(fast == 1.5);
+  REQUIRE(slow == 1.5e-300);
+}
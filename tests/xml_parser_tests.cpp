@@ -1,8 +1,14 @@
 #include <catch2/catch.hpp>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
 #include "adm/private/rapidxml_utils.hpp"
 #include "adm/private/rapidxml_wrapper.hpp"
+#include "adm/elements.hpp"
 #include "adm/errors.hpp"
 #include "adm/parse.hpp"
+#include "adm/write.hpp"
 
 TEST_CASE("line_number_calculation") {
   using namespace adm;
@@ -45,3 +51,257 @@ TEST_CASE("empty document") {
         error::XmlParsingError);
   }
 }
+
+namespace {
+  std::string parseAndWrite(const std::string& filename,
+                            adm::xml::ParserOptions options) {
+    std::stringstream xml;
+    adm::writeXml(xml, adm::parseXml(filename, options));
+    return xml.str();
+  }
+
+  std::string parseAndWrite(std::istream& stream,
+                            adm::xml::ParserOptions options) {
+    std::stringstream xml;
+    adm::writeXml(xml, adm::parseXml(stream, options));
+    return xml.str();
+  }
+}  // namespace
+
+TEST_CASE("incremental parsing matches DOM parsing") {
+  using namespace adm;
+  using xml::ParserOptions;
+
+  SECTION("files") {
+    auto filename = GENERATE(as<std::string>{},
+                             "xml_parser/audio_block_format_objects.xml",
+                             "xml_parser/audio_block_format_direct_speakers.xml",
+                             "xml_parser/audio_block_format_hoa.xml",
+                             "xml_parser/audio_block_format_binaural.xml",
+                             "xml_parser/audio_channel_format.xml",
+                             "xml_parser/audio_object.xml",
+                             "xml_parser/audio_object_interaction.xml",
+                             "xml_parser/audio_pack_format_hoa.xml",
+                             "xml_parser/audio_programme.xml",
+                             "xml_parser/audio_track_uid.xml",
+                             "xml_parser/labels.xml",
+                             "xml_parser/version.xml",
+                             "xml_parser/find_audio_format_extended_ebu.xml",
+                             "simple_scene_default.accepted.xml");
+    CAPTURE(filename);
+    REQUIRE(parseAndWrite(filename, ParserOptions::incremental) ==
+            parseAndWrite(filename, ParserOptions::none));
+  }
+
+  SECTION("recursive search") {
+    auto filename = GENERATE(as<std::string>{},
+                             "xml_parser/find_audio_format_extended_itu.xml",
+                             "simple_scene_itu.accepted.xml");
+    CAPTURE(filename);
+    REQUIRE(parseAndWrite(filename, ParserOptions::recursive_node_search |
+                                        ParserOptions::incremental) ==
+            parseAndWrite(filename, ParserOptions::recursive_node_search));
+  }
+
+  SECTION("long channel") {
+    // larger than the read chunk size, with markup which the incremental
+    // reader has to skip over
+    std::stringstream xml;
+    xml << "<?xml version=\"1.0\"?>\n"
+           "<!DOCTYPE ebuCoreMain>\n"
+           "<ebuCoreMain><coreMetadata><format>"
+           "<audioFormatExtended version=\"ITU-R_BS.2076-2\">\n"
+           "<!-- a comment with <tags> -->\n"
+           "<audioChannelFormat audioChannelFormatID=\"AC_00031001\" "
+           "audioChannelFormatName=\"a > b\" typeDefinition=\"Objects\">\n";
+    for (int i = 0; i < 10000; i++) {
+      xml << "<audioBlockFormat rtime=\"00:" << std::setfill('0')
+          << std::setw(2) << i / 6000 << ":" << std::setw(2) << i / 100 % 60
+          << "." << std::setw(2) << i % 100 << "\" duration=\"00:00:00.01\">"
+          << "<position coordinate=\"azimuth\">" << i % 180 << "</position>"
+          << "<position coordinate=\"elevation\">0</position>"
+          << "<![CDATA[ <ignored/> ]]>"
+          << "</audioBlockFormat>\n";
+      if (i == 5000)
+        xml << "<frequency typeDefinition=\"lowPass\">120</frequency>\n";
+    }
+    xml << "</audioChannelFormat>\n"
+           "<audioPackFormat audioPackFormatID=\"AP_00031001\" "
+           "audioPackFormatName=\"pack\" typeDefinition=\"Objects\">"
+           "<audioChannelFormatIDRef>AC_00031001</audioChannelFormatIDRef>"
+           "</audioPackFormat>"
+           "</audioFormatExtended></format></coreMetadata></ebuCoreMain>";
+
+    std::stringstream incrementalStream(xml.str());
+    auto document = parseXml(incrementalStream, ParserOptions::incremental);
+    auto channelFormat =
+        document->lookup(parseAudioChannelFormatId("AC_00031001"));
+    REQUIRE(channelFormat->getElements<AudioBlockFormatObjects>().size() ==
+            10000);
+    REQUIRE(channelFormat->get<AudioChannelFormatName>() == "a > b");
+    REQUIRE(channelFormat->get<Frequency>().get<LowPass>() == 120.0f);
+
+    incrementalStream.clear();
+    incrementalStream.seekg(0);
+    std::stringstream domStream(xml.str());
+    REQUIRE(parseAndWrite(incrementalStream, ParserOptions::incremental) ==
+            parseAndWrite(domStream, ParserOptions::none));
+  }
+
+  SECTION("errors") {
+    std::istringstream empty("");
+    REQUIRE_THROWS_AS(parseXml(empty, ParserOptions::incremental),
+                      error::XmlParsingError);
+
+    std::istringstream truncated(
+        "<ebuCoreMain><coreMetadata><format><audioFormatExtended>"
+        "<audioChannelFormat audioChannelFormatID=\"AC_00031001\" "
+        "audioChannelFormatName=\"a\"><audioBlockFormat>");
+    REQUIRE_THROWS_AS(parseXml(truncated, ParserOptions::incremental),
+                      error::XmlParsingError);
+
+    REQUIRE_THROWS_AS(
+        parseXml("xml_parser/audio_channel_format_duplicate_id.xml",
+                 ParserOptions::incremental),
+        error::XmlParsingDuplicateId);
+  }
+}
+
+TEST_CASE("memory-mapped and buffer input") {
+  using namespace adm;
+  using xml::ParserOptions;
+
+  SECTION("files") {
+    auto filename = GENERATE(as<std::string>{},
+                             "xml_parser/audio_block_format_objects.xml",
+                             "xml_parser/audio_channel_format.xml",
+                             "xml_parser/audio_object.xml",
+                             "simple_scene_default.accepted.xml");
+    CAPTURE(filename);
+    REQUIRE(parseAndWrite(filename, ParserOptions::memory_map) ==
+            parseAndWrite(filename, ParserOptions::none));
+  }
+
+  SECTION("file size is a multiple of the page size") {
+    std::ifstream source("simple_scene_default.accepted.xml");
+    std::string xml{std::istreambuf_iterator<char>(source),
+                    std::istreambuf_iterator<char>()};
+    xml.resize(64 * 1024, '\n');
+    {
+      std::ofstream out("memory_map_page_size.xml", std::ios::binary);
+      out << xml;
+    }
+    REQUIRE(parseAndWrite("memory_map_page_size.xml",
+                          ParserOptions::memory_map) ==
+            parseAndWrite("simple_scene_default.accepted.xml",
+                          ParserOptions::none));
+  }
+
+  SECTION("buffer") {
+    std::ifstream source("simple_scene_default.accepted.xml");
+    std::string xml{std::istreambuf_iterator<char>(source),
+                    std::istreambuf_iterator<char>()};
+    auto expected =
+        parseAndWrite("simple_scene_default.accepted.xml", ParserOptions::none);
+
+    // the buffer is not null-terminated, and must not be read past its end
+    std::string padded = xml + "<garbage";
+    for (auto options : {ParserOptions::none, ParserOptions::incremental}) {
+      std::stringstream result;
+      writeXml(result, parseXml(padded.data(), xml.size(), options));
+      REQUIRE(result.str() == expected);
+    }
+    // the buffer is not modified
+    REQUIRE(padded == xml + "<garbage");
+
+    REQUIRE_THROWS_AS(parseXml(padded.data(), 0), error::XmlParsingError);
+  }
+
+  SECTION("errors") {
+    REQUIRE_THROWS_AS(parseXml("not_a_file.xml", ParserOptions::memory_map),
+                      std::runtime_error);
+  }
+}
+
+TEST_CASE("parallel parsing matches sequential parsing") {
+  using namespace adm;
+  using xml::ParserOptions;
+
+  SECTION("files") {
+    auto filename = GENERATE(as<std::string>{},
+                             "xml_parser/audio_block_format_objects.xml",
+                             "xml_parser/audio_block_format_direct_speakers.xml",
+                             "xml_parser/audio_channel_format.xml",
+                             "xml_parser/audio_object.xml",
+                             "xml_parser/audio_pack_format_hoa.xml",
+                             "simple_scene_default.accepted.xml");
+    CAPTURE(filename);
+    REQUIRE(parseAndWrite(filename, ParserOptions::parallel) ==
+            parseAndWrite(filename, ParserOptions::none));
+  }
+
+  SECTION("many channels") {
+    auto document = Document::create();
+    for (int c = 0; c < 64; c++) {
+      auto pack = AudioPackFormat::create(AudioPackFormatName("pack"),
+                                          TypeDefinition::OBJECTS);
+      auto channel = AudioChannelFormat::create(AudioChannelFormatName("c"),
+                                                TypeDefinition::OBJECTS);
+      for (int i = 0; i < 100; i++)
+        channel->add(AudioBlockFormatObjects(
+            SphericalPosition(Azimuth(static_cast<float>(c + i))),
+            Rtime(std::chrono::milliseconds(10 * i)),
+            Duration(std::chrono::milliseconds(10))));
+      pack->addReference(channel);
+      document->add(pack);
+    }
+    std::stringstream xml;
+    writeXml(xml, document);
+
+    std::stringstream parallelStream(xml.str());
+    std::stringstream sequentialStream(xml.str());
+    REQUIRE(parseAndWrite(parallelStream, ParserOptions::parallel) ==
+            parseAndWrite(sequentialStream, ParserOptions::none));
+  }
+
+  SECTION("errors are reported in document order") {
+    std::string xml =
+        "<ebuCoreMain><coreMetadata><format><audioFormatExtended>"
+        "<audioPackFormat audioPackFormatID=\"AP_00031001\" "
+        "audioPackFormatName=\"p\" typeDefinition=\"Objects\">"
+        "<audioChannelFormatIDRef>AC_00031001</audioChannelFormatIDRef>"
+        "</audioPackFormat>"
+        "<audioChannelFormat audioChannelFormatID=\"AC_00031001\" "
+        "audioChannelFormatName=\"c\" typeDefinition=\"Objects\">"
+        "<audioBlockFormat audioBlockFormatID=\"AB_00031001_00000001\" "
+        "rtime=\"first\"/></audioChannelFormat>"
+        "<audioChannelFormat audioChannelFormatID=\"AC_00031002\" "
+        "audioChannelFormatName=\"c\" typeDefinition=\"Objects\">"
+        "<audioBlockFormat audioBlockFormatID=\"AB_00031002_00000001\" "
+        "rtime=\"second\"/></audioChannelFormat>"
+        "</audioFormatExtended></format></coreMetadata></ebuCoreMain>";
+    for (int i = 0; i < 10; i++) {
+      REQUIRE_THROWS_WITH(
+          parseXml(xml.data(), xml.size(), ParserOptions::parallel),
+          Catch::Contains("first"));
+    }
+  }
+
+  SECTION("duplicate channel IDs") {
+    REQUIRE_THROWS_AS(
+        parseXml("xml_parser/audio_channel_format_duplicate_id.xml",
+                 ParserOptions::parallel),
+        error::XmlParsingDuplicateId);
+
+    std::string xml =
+        "<ebuCoreMain><coreMetadata><format><audioFormatExtended>"
+        "<audioChannelFormat audioChannelFormatID=\"AC_00031001\" "
+        "audioChannelFormatName=\"c\" typeDefinition=\"Objects\"/>"
+        "<audioChannelFormat audioChannelFormatID=\"AC_00031001\" "
+        "audioChannelFormatName=\"c\" typeDefinition=\"Objects\"/>"
+        "</audioFormatExtended></format></coreMetadata></ebuCoreMain>";
+    REQUIRE_THROWS_WITH(
+        parseXml(xml.data(), xml.size(), ParserOptions::parallel),
+        Catch::Contains("Duplicate Id AC_00031001"));
+  }
+}
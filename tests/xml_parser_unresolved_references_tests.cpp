@@ -1,5 +1,7 @@
 #include <catch2/catch.hpp>
 #include <sstream>
+#include <string>
+#include <vector>
 #include "adm/parse.hpp"
 #include "adm/errors.hpp"
 
@@ -21,3 +23,19 @@ TEST_CASE("xml_parser/unresolved_references") {
     }
   }
 }
+
+TEST_CASE("xml_parser/unresolved_references/multiple") {
+  // all unresolved references are reported, each once, in document order
+  // for each type of reference
+  try {
+    adm::parseXml(formatFilepath("multiple"));
+    FAIL("no exception thrown");
+  } catch (const adm::error::XmlParsingUnresolvedReference& e) {
+    std::vector<std::string> expected{"ACO_1002", "AO_1002", "AP_00031001",
+                                      "AT_00031001_01"};
+    REQUIRE(e.ids() == expected);
+    REQUIRE(std::string(e.what()) ==
+            "Ids ACO_1002, AO_1002, AP_00031001, AT_00031001_01 could not be "
+            "resolved");
+  }
+}
@@ -0,0 +1,153 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include "adm/common_definitions.hpp"
+#include "adm/document.hpp"
+#include "adm/elements.hpp"
+#include "adm/parse.hpp"
+#include "adm/serial.hpp"
+#include "adm/utilities/copy.hpp"
+#include "adm/utilities/object_creation.hpp"
+#include "adm/private/xml_writer.hpp"
+
+using namespace adm;
+using namespace std::chrono_literals;
+
+namespace {
+  std::string write(std::shared_ptr<const Document> document,
+                    xml::WriterOptions options,
+                    xml::XmlWriterBackend backend) {
+    std::stringstream stream;
+    xml::XmlWriter(options, backend).write(document, stream);
+    return stream.str();
+  }
+
+  std::string write(std::shared_ptr<const Document> document,
+                    const FrameHeader& header, xml::SadmWriterOptions options,
+                    xml::XmlWriterBackend backend) {
+    std::stringstream stream;
+    xml::SadmXmlWriter(options, backend).write(document, header, stream);
+    return stream.str();
+  }
+
+  void checkSameOutput(std::shared_ptr<const Document> document) {
+    for (auto options :
+         {xml::WriterOptions::none, xml::WriterOptions::itu_structure,
+          xml::WriterOptions::write_default_values,
+          xml::WriterOptions::itu_structure |
+              xml::WriterOptions::write_default_values}) {
+      auto expected = write(document, options, xml::XmlWriterBackend::dom);
+      REQUIRE(write(document, options, xml::XmlWriterBackend::stream) ==
+              expected);
+    }
+  }
+}  // namespace
+
+TEST_CASE("streaming writer matches DOM writer for test files") {
+  for (auto filename :
+       {"audio_block_format_binaural", "audio_block_format_direct_speakers",
+        "audio_block_format_direct_speakers_cartesian",
+        "audio_block_format_hoa", "audio_block_format_objects",
+        "audio_channel_format", "audio_content", "audio_object",
+        "audio_object_complementary_audio_objects", "audio_object_interaction",
+        "audio_object_position_offset", "audio_object_track_refs",
+        "audio_pack_format", "audio_pack_format_hoa", "audio_programme",
+        "audio_stream_format", "audio_track_format", "audio_track_uid",
+        "audio_track_uid_channel_format_reference",
+        "audio_track_uid_track_format_reference", "labels", "loudness_metadata",
+        "profile_list", "time_format", "version", "with_common_definitions"}) {
+    SECTION(filename) {
+      auto document =
+          parseXml(std::string("xml_parser/") + filename + ".xml",
+                   xml::ParserOptions::recursive_node_search);
+      checkSameOutput(document);
+    }
+  }
+}
+
+TEST_CASE("streaming writer escapes like the DOM writer") {
+  auto document = Document::create();
+  auto object = AudioObject::create(AudioObjectName{"a \"quoted\" <name>"});
+  object->add(Label{LabelValue{"it's & \"both\""}, LabelLanguage{"en'"}});
+  object->add(Label{LabelValue{""}, LabelLanguage{"\"'"}});
+  object->add(Label{LabelValue{std::string("before\0after", 12)}});
+  document->add(object);
+  auto programme = AudioProgramme::create(AudioProgrammeName{"<>&'"});
+  document->add(programme);
+
+  checkSameOutput(document);
+}
+
+TEST_CASE("streaming writer matches DOM writer for S-ADM frames") {
+  auto document = Document::create();
+  addSimpleObjectTo(document, "object");
+  auto channel = document->getElements<AudioChannelFormat>()[0];
+  channel->add(AudioBlockFormatObjects{SphericalPosition{}, Rtime{0s},
+                                       Duration{1s}});
+
+  FrameHeader header(FrameFormat{
+      FrameFormatId{FrameIndex{4}}, Start{3s}, Duration{1s}, FrameType::FULL,
+      ChangedIds{ChangedAudioChannelFormatIds{
+          {parseAudioChannelFormatId("AC_00031001"), ChangedIdStatus::CHANGED},
+          {parseAudioChannelFormatId("AC_00031002"),
+           ChangedIdStatus::EXPIRED}}}});
+
+  for (auto options : {xml::SadmWriterOptions::none,
+                       xml::SadmWriterOptions::core_metadata,
+                       xml::SadmWriterOptions::write_default_values}) {
+    auto expected =
+        write(document, header, options, xml::XmlWriterBackend::dom);
+    REQUIRE(write(document, header, options, xml::XmlWriterBackend::stream) ==
+            expected);
+  }
+}
+
+TEST_CASE("streaming writer output for large documents") {
+  // long enough to be flushed to the stream in several chunks
+  auto document = Document::create();
+  auto holder = addSimpleObjectTo(document, "object");
+  for (int i = 0; i < 5000; i++)
+    holder.audioChannelFormat->add(AudioBlockFormatObjects{
+        SphericalPosition{Azimuth{static_cast<float>(i % 360 - 180)}}});
+
+  checkSameOutput(document);
+}
+
+TEST_CASE("parallel writing matches sequential writing") {
+  auto document = Document::create();
+  for (int i = 0; i < 128; i++) {
+    auto holder = addSimpleObjectTo(document, "object " + std::to_string(i));
+    for (int j = 0; j < 50; j++)
+      holder.audioChannelFormat->add(AudioBlockFormatObjects{
+          SphericalPosition{Azimuth{static_cast<float>(j - i % 50)}},
+          Rtime{std::chrono::milliseconds(j * 100)},
+          Duration{std::chrono::milliseconds(100)}});
+  }
+  auto commonDefinitions = getCommonDefinitions();
+  auto withCommonDefinitions = Document::create();
+  deepCopyTo(commonDefinitions, withCommonDefinitions);
+  deepCopyTo(document, withCommonDefinitions);
+
+  for (auto doc : {document, withCommonDefinitions}) {
+    for (auto options :
+         {xml::WriterOptions::none, xml::WriterOptions::itu_structure,
+          xml::WriterOptions::write_default_values}) {
+      for (auto backend :
+           {xml::XmlWriterBackend::stream, xml::XmlWriterBackend::dom}) {
+        auto expected = write(doc, options, backend);
+        REQUIRE(write(doc, options | xml::WriterOptions::parallel, backend) ==
+                expected);
+      }
+    }
+  }
+
+  FrameHeader header(FrameFormat{FrameFormatId{FrameIndex{1}}, Start{0s},
+                                 Duration{5s}, FrameType::FULL});
+  for (auto options : {xml::SadmWriterOptions::none,
+                       xml::SadmWriterOptions::core_metadata}) {
+    auto expected =
+        write(document, header, options, xml::XmlWriterBackend::stream);
+    REQUIRE(write(document, header, options | xml::SadmWriterOptions::parallel,
+                  xml::XmlWriterBackend::stream) == expected);
+  }
+}
@@ -39,6 +39,20 @@ TEST_CASE("write_optional_defaults") {
   CHECK_THAT(xml.str(), EqualsXmlFile("write_optional_defaults"));
 }
 
+TEST_CASE("write_parallel") {
+  using namespace adm;
+  auto document = createSimpleScene();
+
+  // same output as without xml::WriterOptions::parallel
+  std::stringstream xml;
+  writeXml(xml, document,
+           xml::WriterOptions::write_default_values |
+               xml::WriterOptions::itu_structure |
+               xml::WriterOptions::parallel);
+
+  CHECK_THAT(xml.str(), EqualsXmlFile("simple_scene_itu"));
+}
+
 TEST_CASE("write_complementary_audio_objects") {
   using namespace adm;
 